@@ -6,8 +6,12 @@
 #include <environment.h>
 #include "src/ui/application.h"
 #include <strings.h>
+#include <workers.h>
+#include <jobs.h>
+#include <batch.h>
+#include <test_cad.h>
 
-int main()
+int main(int argc, char* argv[])
 {
 	// needs to be initialized first
 	environment::init();
@@ -30,13 +34,30 @@ int main()
 	Logger::log("languages available : " + stringex::concat_strings(langs, " "));
 	Logger::log("language selected : " + Lang::getName());
 
-	Application application("OpenPostpro");
-
-	application.initialize();
-	application.run();
-	application.finalize();
-
+	int result = EXIT_SUCCESS;
+
+	if (test_requested(argc, argv))
+	{
+		// headless : checks of the kernels, then the benchmarks with --bench
+		result = run_tests(argc, argv);
+	}
+	else if (Batch::requested(argc, argv))
+	{
+		// headless : files are loaded, computed and post-processed without window
+		result = Batch::run(argc, argv, std::to_string(Application::VERSION));
+	}
+	else
+	{
+		Application application("OpenPostpro");
+
+		application.initialize();
+		application.run();
+		application.finalize();
+	}
+
+	Jobs::stop();
+	Workers::stop();
 	Logger::stop();
 
-	return EXIT_SUCCESS;
+	return result;
 }
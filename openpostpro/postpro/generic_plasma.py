@@ -239,6 +239,20 @@ class Postpro:
 			dum = dum[:-1]
 		return dum
 	
+	# moves formatted natively, the description follows n, code, coords and start_line. Remove to format them in python
+	def formatter(self):
+		return {'space': self.space, 'decimals': self.decim, 'axes': 'XYIJ' if self.disable_z else 'XYZIJ', 'modal': ('G0', 'G1', 'G2', 'G3') if self.cond else ('G1', 'G2', 'G3'), 'increment': self.incrementation(), 'digits': 5}
+
+	# last code, used and updated by the native formatter
+	def get_code(self):
+		return self.last_code
+
+	def set_code(self, val, reset):
+		self.last_code = val
+		if reset:
+			self.last_r = ''
+			self.last_q = ''
+
 	# check if code is equal to last code to avoid repeat
 	def code(self, val):
 		result = val
@@ -193,6 +193,46 @@ class Postcore:
 		self.set_axes(axes, values) #keep track of current position
 		return self.line(self.postpro.counter_clockwise(axes, values))
 
+	# moves of a tool path pass at once, records of 7 floats :
+	# type (0 rapid, 1 linear, 2 clockwise, 3 counter clockwise, 4 feed),
+	# mask of the axes X Y Z I J sent, values of X Y Z I J (feed rate in X)
+	# the buffer is only valid during the call
+	def moves(self, data):
+		values = memoryview(data).cast('d')
+		names = ('X', 'Y', 'Z', 'I', 'J')
+		methods = (self.rapid, self.linear, self.clockwise, self.counter_clockwise)
+		output = []
+		for n in range(0, len(values), 7):
+			move = int(values[n])
+			if move == 4:
+				output.append(self.feed(values[n + 2]))
+			else:
+				mask = int(values[n + 1])
+				axes = tuple(names[k] for k in range(5) if mask & (1 << k))
+				coordinates = tuple(values[n + 2 + k] for k in range(5) if mask & (1 << k))
+				output.append(methods[move](axes, coordinates))
+		return ''.join(output)
+
+	# description of the native formatter of the post (src/postpro/formatter.h), None to format with python
+	def get_formatter(self):
+		if hasattr(self.postpro, 'formatter'):
+			return self.postpro.formatter()
+		return None
+
+	# state of the native formatter, read before the moves of a tool path pass
+	def get_format_state(self):
+		return (self.x, self.y, self.z, self.pos, self.line_count, self.f, self.postpro.get_code())
+
+	# state of the native formatter, written back after the moves of a tool path pass
+	def set_format_state(self, x, y, z, pos, count, f, code, reset):
+		self.x = x
+		self.y = y
+		self.z = z
+		self.pos = pos
+		self.line_count = count
+		self.f = f
+		self.postpro.set_code(code, reset)
+
 	# feed rate
 	def feed(self, value):
 		if self.f != value:
@@ -4,6 +4,7 @@
 #include <strings.h>
 #include <config.h>
 #include <logger.h>
+#include <stats.h>
 #include<chrono>
 
 void Spline::add(glm::vec2 point)
@@ -99,6 +100,7 @@ void Spline::transform(glm::tmat4x4<float> mat)
 		if (_curve[i].type != SegmentType::Line)
 			_curve[i].center = mat * glm::vec4(_curve[i].center.x, _curve[i].center.y, 1, 1);
 	}
+	_curve.reset_bounds();
 
 	for (int i = 0; i < _coordinates.size(); i++)
 		_coordinates[i] = mat * glm::vec4(_coordinates[i].x, _coordinates[i].y, 1, 1);
@@ -169,14 +171,14 @@ void Spline::compute()
 
 		for (glm::vec2 p : _coordinates)
 		{
-			_bounds.top_left.x = glm::min(_bounds.top_left.x, p.x);
-			_bounds.top_left.y = glm::max(_bounds.top_left.y, p.y);
-			_bounds.bottom_right.x = glm::max(_bounds.bottom_right.x, p.x);
-			_bounds.bottom_right.y = glm::min(_bounds.bottom_right.y, p.y);
+			_bounds.top_left.x = glm::min(_bounds.top_left.x, (geometry::real)p.x);
+			_bounds.top_left.y = glm::max(_bounds.top_left.y, (geometry::real)p.y);
+			_bounds.bottom_right.x = glm::max(_bounds.bottom_right.x, (geometry::real)p.x);
+			_bounds.bottom_right.y = glm::min(_bounds.bottom_right.y, (geometry::real)p.y);
 		}
 	}
 	//update();
-	needs_update();
+	Graphic::compute();
 }
 
 void Spline::update()
@@ -364,6 +366,7 @@ void Spline::offset(float o)
 	//	return;
 
 	auto t = std::chrono::high_resolution_clock::now();
+	Stats::Counters stats;
 
 	auto c = _curve;
 	c.reduce(0.25);
@@ -382,7 +385,7 @@ void Spline::offset(float o)
 		{
 			if (s.type == SegmentType::Line)
 			{
-				auto dst = geometry::position(s.dst, 1 * geometry::distance(s.point, s.dst), s.point);
+				glm::vec2 dst = geometry::position(s.dst, 1 * geometry::distance(s.point, s.dst), s.point);
 				vertices.push_back(glm::vec3(s.point.x, s.point.y, 0));
 				vertices.push_back(glm::vec3(s.dst.x, s.dst.y, 0));
 				//vertices.push_back(glm::vec3(dst.x, dst.y, 0));
@@ -501,8 +504,7 @@ void Spline::offset(float o)
 
 		//////////////////////// CLEAN TRIM /////////////////////////////////////
 
-		Curve::counter[0] = 0;
-		Curve::counter[1] = 0;
+		Stats::Scope scope(stats);
 		for (Curve c : process)
 		{
 			if (!config.field_f4_toggled && !config.field_f6_toggled)
@@ -517,7 +519,8 @@ void Spline::offset(float o)
 
 	Logger::log("Process time (ms): " + std::to_string(std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(std::chrono::high_resolution_clock::now() - t).count()));
 
-	Logger::log("clipping tests : " + std::to_string(Curve::counter[1]) + " ||| too close tests : " + std::to_string(Curve::counter[0]) + " ||| intersections : " + std::to_string(Curve::counter[5]));
+	if (Stats::enabled)
+		Logger::log("clean trim " + stats.str());
 
 	/////////////////////////////// DRAW ///////////////////////////////////
 
@@ -187,7 +187,7 @@ void Arc::move(glm::vec2 point)
 		else // center
 		{
 			// move center along the mediatrice of (_start,_stop)
-			auto middle = geometry::middle(_start, _stop);
+			glm::vec2 middle = geometry::middle(_start, _stop);
 			_center = geometry::projection(point, _center, middle);
 		}
 		compute();
@@ -585,8 +585,8 @@ void Arc::ui()
 			auto r = std::stof(input);
 			auto s_a = geometry::angle(_start - _center);
 			auto s_o = geometry::angle(_stop - _center);
-			auto sta = geometry::position(s_a, r, _center);
-			auto sto = geometry::position(s_o, r, _center);
+			glm::vec2 sta = geometry::position(s_a, r, _center);
+			glm::vec2 sto = geometry::position(s_o, r, _center);
 			if (_radius != r)
 			{
 				History::undo(HistoryActionType::Modify, write());
@@ -616,7 +616,7 @@ void Arc::ui()
 			{
 				History::undo(HistoryActionType::Modify, write());
 				float sa = geometry::oriented_angle(_start, _center);
-				auto point = geometry::position(sa + so, _radius, _center);
+				glm::vec2 point = geometry::position(sa + so, _radius, _center);
 				stop(point);
 			}
 		}
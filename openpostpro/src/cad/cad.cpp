@@ -8,6 +8,7 @@
 #include <ellipse.h>
 #include <logger.h>
 #include <text.h>
+#include <document.h>
 
 
 bool compare_vec2_x_smaller(glm::vec2 v1, glm::vec2 v2)
@@ -187,8 +188,8 @@ std::vector<Shape*> cad::split(Shape* shape, std::vector<glm::vec2> points)
 		float start = angles.back();
 		for (float angle : angles)
 		{
-			auto p1 = geometry::position(start, c->radius(), c->center());
-			auto p2 = geometry::position(angle, c->radius(), c->center());
+			glm::vec2 p1 = geometry::position(start, c->radius(), c->center());
+			glm::vec2 p2 = geometry::position(angle, c->radius(), c->center());
 			Arc* a = new Arc(shape->render());
 			a->set(p1, c->center(), p2, false);
 			a->parent(c->parent());
@@ -233,8 +234,8 @@ std::vector<Shape*> cad::split(Shape* shape, std::vector<glm::vec2> points)
 		// we can now split into arcs the circle
 		for (float angle : angles)
 		{
-			auto p1 = geometry::position(start, c->radius(), c->center());
-			auto p2 = geometry::position(angle, c->radius(), c->center());
+			glm::vec2 p1 = geometry::position(start, c->radius(), c->center());
+			glm::vec2 p2 = geometry::position(angle, c->radius(), c->center());
 			Arc* a = new Arc(shape->render());
 			a->set(p1, c->center(), p2, false);
 			a->parent(c->parent());
@@ -331,6 +332,7 @@ std::vector<std::vector<glm::vec2>> cad::split(std::vector<glm::vec2> coordinate
 {
 	std::vector < std::vector<glm::vec2>> result; // contains final result
 	glm::vec2 p = glm::vec2();
+	geometry::rvec2 r = geometry::rvec2();
 	std::vector<int> indices;
 
 	//auto sorted = sort_vec2_x_smaller(coordinates);
@@ -348,8 +350,9 @@ std::vector<std::vector<glm::vec2>> cad::split(std::vector<glm::vec2> coordinate
 			glm::vec2 b1 = coordinates[j];
 			glm::vec2 b2 = coordinates[j+1];
 
-			if (geometry::segment_segment_intersect(a1, a2, b1, b2, p))
+			if (geometry::segment_segment_intersect(a1, a2, b1, b2, r))
 			{
+				p = r;
 				if (std::find(indices.begin(), indices.end(), i) == indices.end())
 					indices.push_back(i);
 				if (std::find(intersections[i].begin(), intersections[i].end(), p) == intersections[i].end())
@@ -435,6 +438,7 @@ std::vector < std::vector<glm::vec2>> cad::split(glm::vec2 p1, glm::vec2 p2, std
 	int count = 0;
 	std::vector < std::vector<glm::vec2>> result; // contains final result
 	glm::vec2 p = glm::vec2();
+	geometry::rvec2 r = geometry::rvec2();
 	std::vector<int> indices;
 
 	std::vector<std::vector<glm::vec2>> intersections(coordinates.size() - 1);
@@ -446,8 +450,9 @@ std::vector < std::vector<glm::vec2>> cad::split(glm::vec2 p1, glm::vec2 p2, std
 		glm::vec2 a1 = coordinates[i];
 		glm::vec2 a2 = coordinates[i];
 		count++;
-		if (geometry::segment_segment_intersect(p1, p2, a1, a2, p))
+		if (geometry::segment_segment_intersect(p1, p2, a1, a2, r))
 		{
+			p = r;
 			if (std::find(indices.begin(), indices.end(), i) == indices.end())
 				indices.push_back(i);
 			if (std::find(intersections[i].begin(), intersections[i].end(), p) == intersections[i].end())
@@ -923,7 +928,7 @@ std::vector<Shape*> cad::fillet(std::vector<Shape*> shapes, float radius)
 
 						if (a1 - a2 != 0 && a1 + a2 != 0) // check if not colinear
 						{
-							glm::vec2 center = geometry::vec2_empty;
+							geometry::rvec2 center = geometry::rvec2_empty;
 							geometry::line_line_intersect(h1, p1, h2, p2, center);
 
 							// center hold the fillet center, h1 is start and h2 is stop
@@ -979,3 +984,130 @@ std::vector<Shape*> cad::connected(Shape* s, std::vector<Shape*> shapes)
 
 	return result;
 }
+
+std::vector<Shape*> cad::siblings(Document* doc, Shape* s)
+{
+	std::vector<Shape*> result;
+	result.push_back(s);
+
+	if (s->type() == GraphicType::Line || s->type() == GraphicType::Arc || s->type() == GraphicType::Polyline)
+	{
+		std::vector<Shape*> shapes;
+		for (Shape* shape : doc->layer(s->parent())->shapes())
+			if (shape != s && (shape->type() == GraphicType::Line || shape->type() == GraphicType::Arc || shape->type() == GraphicType::Polyline))
+				shapes.push_back(shape);
+
+		if (shapes.size() > 0)
+		{
+			glm::vec2 left = s->first(), right = s->last();
+
+			std::vector<Shape*>::iterator it = shapes.begin();
+			while(it != shapes.end())
+			{
+				if ((*it)->last() == right)
+					(*it)->reverse();
+				else if (geometry::distance((*it)->last(), right) < geometry::ERR_FLOAT6)
+				{
+					if ((*it)->type() == GraphicType::Line)
+						((Line*)(*it))->p2(right);
+					(*it)->reverse();
+				}
+
+				if ((*it)->first() == left)
+					(*it)->reverse();
+				else if (geometry::distance((*it)->first(), left) < geometry::ERR_FLOAT6)
+				{
+					if ((*it)->type() == GraphicType::Line)
+						((Line*)(*it))->p1(left);
+					(*it)->reverse();
+				}
+
+				if ((*it)->first() == right)
+				{
+					right = (*it)->last();
+					result.push_back((*it));
+					shapes.erase(it);
+					it = shapes.begin();
+				}
+				else if ((*it)->last() == left)
+				{
+					left = (*it)->first();
+					result.insert(result.begin(), (*it));
+					shapes.erase(it);
+					it = shapes.begin();
+				}
+				else if (geometry::distance((*it)->first(), left) < geometry::ERR_FLOAT6)
+				{
+					if ((*it)->type() == GraphicType::Line)
+						((Line*)(*it))->p1(left);
+					(*it)->reverse();
+				}
+				else
+					it++;
+			}
+		}
+	}
+
+	return result;
+}
+
+TreeCurve* cad::tree(Document* doc, std::vector<Shape*> candidates, std::vector<Graphic*>& chained)
+{
+	std::vector<Curve> curves;
+
+	int tag = 0;
+
+	while (candidates.size() > 0)
+	{
+		auto shapes = siblings(doc, candidates[0]);
+
+		// stores shapes which are part of tree
+		for (Shape* s : shapes)
+			if (std::find(chained.begin(), chained.end(), s) == chained.end())
+				chained.push_back(s);
+
+		if (shapes[0]->type() == GraphicType::Text)
+		{
+			shapes[0]->tag(tag);
+			auto coordinates = ((Text*)shapes[0])->coordinates();
+			if (coordinates.size() > 2)
+			{
+				for (std::vector<glm::vec2> points : coordinates)
+				{
+					Curve c = cad::to_curve(points);
+					c.close();
+					c.tag(tag);
+					c.reference(shapes.front()->id());
+					if (c.size() > 1)
+						curves.push_back(c);
+				}
+			}
+		}
+		else
+		{
+			Curve c = cad::to_curve(shapes);
+			c.tag(tag);
+			c.reference(shapes.front()->id());
+			if (c.size() >= 2)
+			{
+				curves.push_back(c);
+			}
+		}
+
+		for (Shape* s : shapes)
+		{
+			s->tag(tag);
+			auto it = std::find(candidates.begin(), candidates.end(), s);
+			if (it != candidates.end())
+				candidates.erase(it);
+		}
+
+		tag++;
+	}
+
+	TreeCurve* result = new TreeCurve(curves);
+	result->nest();
+	result->cw_alter();
+
+	return result;
+}
@@ -6,6 +6,8 @@
 #include <curve.h>
 #include <Spline.h>
 
+class Document;
+
 namespace cad
 {
 	/// <summary>
@@ -61,6 +63,16 @@ namespace cad
 
 	std::vector<Shape*> connected(Shape* s, std::vector<Shape*> shapes);
 
+	/// <summary>
+	/// Return the chain of lines, arcs and polylines of the layer of s joined end to end with s, in order. Shapes are reversed to follow the chain
+	/// </summary>
+	std::vector<Shape*> siblings(Document* doc, Shape* s);
+
+	/// <summary>
+	/// Chain candidates into curves tagged by chain and nest them. Chained receives every shape used
+	/// </summary>
+	TreeCurve* tree(Document* doc, std::vector<Shape*> candidates, std::vector<Graphic*>& chained);
+
 }
 
 #endif
\ No newline at end of file
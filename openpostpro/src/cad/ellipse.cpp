@@ -250,16 +250,16 @@ void Ellipse::move(glm::vec2 point)
 			_center = point;
 		else if (_a2 == modification())
 		{
-			auto pmin = geometry::position(glm::half_pi<float>() + _angle, _minor / 2.0f, _center);
-			auto projection = geometry::projection(point, _center, pmin);
+			glm::vec2 pmin = geometry::position(glm::half_pi<float>() + _angle, _minor / 2.0f, _center);
+			glm::vec2 projection = geometry::projection(point, _center, pmin);
 			if (projection.y != point.y)
 				_minor = _minor;
 			_minor = glm::distance(_center, projection) * 2;
 		}
 		else if (_a3 == modification())
 		{
-			auto pmaj = geometry::position(_angle, _major / 2.0f, _center);
-			auto projection = geometry::projection(point, _center, pmaj);
+			glm::vec2 pmaj = geometry::position(_angle, _major / 2.0f, _center);
+			glm::vec2 projection = geometry::projection(point, _center, pmaj);
 			_major = glm::distance(_center, projection) * 2;
 		}
 	}
@@ -271,8 +271,8 @@ void Ellipse::move(glm::vec2 point)
 		}
 		else
 		{
-			auto h = geometry::position(_angle + glm::half_pi<float>(), 100.0f, _center);
-			auto p = geometry::projection(point, _center, h);
+			glm::vec2 h = geometry::position(_angle + glm::half_pi<float>(), 100.0f, _center);
+			glm::vec2 p = geometry::projection(point, _center, h);
 			_minor = glm::distance(_center, p) * 2.0f;
 		}
 	}
@@ -295,8 +295,8 @@ bool Ellipse::point(glm::vec2 point)
 	}
 	else
 	{
-		auto h = geometry::position(_angle + glm::half_pi<float>(), 100.0f, _center);
-		auto p = geometry::projection(point, _center, h);
+		glm::vec2 h = geometry::position(_angle + glm::half_pi<float>(), 100.0f, _center);
+		glm::vec2 p = geometry::projection(point, _center, h);
 		_minor = glm::distance(_center, p) * 2.0f;
 		done(true);
 		compute();
@@ -328,10 +328,10 @@ void Ellipse::compute()
 		_bounds.max();
 		for (glm::vec2 p : _coordinates)
 		{
-			_bounds.top_left.x = (glm::min)(_bounds.top_left.x, p.x);
-			_bounds.top_left.y = (glm::max)(_bounds.top_left.y, p.y);
-			_bounds.bottom_right.x = (glm::max)(_bounds.bottom_right.x, p.x);
-			_bounds.bottom_right.y = (glm::min)(_bounds.bottom_right.y, p.y);
+			_bounds.top_left.x = (glm::min)(_bounds.top_left.x, (geometry::real)p.x);
+			_bounds.top_left.y = (glm::max)(_bounds.top_left.y, (geometry::real)p.y);
+			_bounds.bottom_right.x = (glm::max)(_bounds.bottom_right.x, (geometry::real)p.x);
+			_bounds.bottom_right.y = (glm::min)(_bounds.bottom_right.y, (geometry::real)p.y);
 		}
 
 		// update vertices
@@ -341,8 +341,8 @@ void Ellipse::compute()
 			_vertices.push_back(glm::vec3(v.x, v.y, 0));
 
 		// add vertices to draw selected lines
-		auto pmin = geometry::position(glm::half_pi<float>() + _angle, _minor / 2.0f, _center);
-		auto pmaj = geometry::position(_angle, _major / 2.0f, _center);
+		glm::vec2 pmin = geometry::position(glm::half_pi<float>() + _angle, _minor / 2.0f, _center);
+		glm::vec2 pmaj = geometry::position(_angle, _major / 2.0f, _center);
 		_vertices.push_back(glm::vec3(pmin, 0.0f));
 		_vertices.push_back(glm::vec3(geometry::symmetry(pmin, _center), 0.0f));
 		_vertices.push_back(glm::vec3(geometry::symmetry(pmaj, _center), 0.0f));
@@ -371,8 +371,8 @@ void Ellipse::update()
 		else
 			_buffer->flush(_vertices);
 
-		auto pmin = geometry::position(glm::half_pi<float>() + _angle, _minor / 2.0f, _center);
-		auto pmaj = geometry::position(_angle, _major / 2.0f, _center);
+		glm::vec2 pmin = geometry::position(glm::half_pi<float>() + _angle, _minor / 2.0f, _center);
+		glm::vec2 pmaj = geometry::position(_angle, _major / 2.0f, _center);
 
 		_a1->point(_center);
 		_a2->point(pmin);
@@ -3,6 +3,7 @@
 #define _GRAPHIC_H
 
 #include "graphic.h"
+#include <dependencies.h>
 
 
 
@@ -26,6 +27,10 @@ bool Graphic::toolpath()
 void Graphic::compute()
 {
 	_needs_update = true;
+
+	// toolpaths built from a shape are rebuilt when it changes
+	if (shape())
+		Dependencies::modified(_id);
 }
 
 void Graphic::scaled()
@@ -4,6 +4,7 @@
 #include <config.h>
 #include <lang.h>
 #include <strings.h>
+#include <dependencies.h>
 
 void Layer::add(Shape* value)
 {
@@ -51,7 +52,10 @@ void Layer::remove(Shape* value)
 	{
 		auto it = std::find(_shapes.begin(), _shapes.end(), value);
 		if (it != _shapes.end())
+		{
 			_shapes.erase(it);
+			Dependencies::modified(value->id());
+		}
 	}
 }
 
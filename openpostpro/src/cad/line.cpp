@@ -352,7 +352,7 @@ void Line::ui()
 		{
 			auto len = std::stof(input);
 			auto angle = geometry::angle(_p2 - _p1);
-			auto point = geometry::position(angle, len);
+			glm::vec2 point = geometry::position(angle, len);
 			if (point + _p1 != _p2)
 			{
 				History::undo(HistoryActionType::Modify, write());
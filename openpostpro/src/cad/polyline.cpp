@@ -272,10 +272,10 @@ void Polyline::compute()
 
 		for (glm::vec2 p : _points)
 		{
-			_bounds.top_left.x = glm::min(_bounds.top_left.x, p.x);
-			_bounds.top_left.y = glm::max(_bounds.top_left.y, p.y);
-			_bounds.bottom_right.x = glm::max(_bounds.bottom_right.x, p.x);
-			_bounds.bottom_right.y = glm::min(_bounds.bottom_right.y, p.y);
+			_bounds.top_left.x = glm::min(_bounds.top_left.x, (geometry::real)p.x);
+			_bounds.top_left.y = glm::max(_bounds.top_left.y, (geometry::real)p.y);
+			_bounds.bottom_right.x = glm::max(_bounds.bottom_right.x, (geometry::real)p.x);
+			_bounds.bottom_right.y = glm::min(_bounds.bottom_right.y, (geometry::real)p.y);
 		}
 
 		/*_top_left.x -= PRECISION;
@@ -43,12 +43,12 @@ geometry::rectangle& Shape::bounds()
 	return _bounds;
 }
 
-glm::vec2& Shape::topLeft()
+geometry::rvec2& Shape::topLeft()
 {
 	return _bounds.top_left;
 }
 
-glm::vec2& Shape::bottomRight()
+geometry::rvec2& Shape::bottomRight()
 {
 	return _bounds.bottom_right;
 }
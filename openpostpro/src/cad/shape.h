@@ -31,8 +31,8 @@ public:
 	void over(bool value);
 
 	geometry::rectangle& bounds();
-	glm::vec2& topLeft();
-	glm::vec2& bottomRight();
+	geometry::rvec2& topLeft();
+	geometry::rvec2& bottomRight();
 
 	// constructor/destructor
 	Shape(Renderer* r) : Graphic(r) {}
@@ -205,7 +205,7 @@ void Text::move(glm::vec2 point)
 			int i1 = 0, i2 = 0;
 			for (int i = 0; i < _reference_path.size() - 1; i++)
 			{
-				auto p = geometry::projection(_reference_point, _reference_path[i], _reference_path[i + 1]);
+				glm::vec2 p = geometry::projection(_reference_point, _reference_path[i], _reference_path[i + 1]);
 				if (geometry::colinear_segment_point(_reference_path[i], _reference_path[i + 1], p, geometry::ERR_FLOAT3))
 				{
 					auto l = geometry::distance2(p, point);
@@ -419,8 +419,8 @@ void Text::compute()
 						// so we compute final coordinates where letter axis will be moved, 
 						// and the rotation angle which is pi/2 + angle(i, i+1)
 						auto p = axis[a].x + pos - dst_len;
-						auto position = geometry::position(_reference_path[i + 1], p, _reference_path[i]);
-						auto angle = geometry::oriented_angle(_reference_path[i+1], _reference_path[i]);
+						glm::vec2 position = geometry::position(_reference_path[i + 1], p, _reference_path[i]);
+						float angle = geometry::oriented_angle(_reference_path[i+1], _reference_path[i]);
 
 						if (_mirror)
 							angle = geometry::oriented_angle(angle + glm::pi<float>());
@@ -493,16 +493,16 @@ void Text::compute()
 
 	for (glm::vec2 p : _vertices)
 	{
-		_bounds.top_left.x = glm::min(_bounds.top_left.x, p.x);
-		_bounds.top_left.y = glm::max(_bounds.top_left.y, p.y);
-		_bounds.bottom_right.x = glm::max(_bounds.bottom_right.x, p.x);
-		_bounds.bottom_right.y = glm::min(_bounds.bottom_right.y, p.y);
+		_bounds.top_left.x = glm::min(_bounds.top_left.x, (geometry::real)p.x);
+		_bounds.top_left.y = glm::max(_bounds.top_left.y, (geometry::real)p.y);
+		_bounds.bottom_right.x = glm::max(_bounds.bottom_right.x, (geometry::real)p.x);
+		_bounds.bottom_right.y = glm::min(_bounds.bottom_right.y, (geometry::real)p.y);
 	}
 
-	_bounds.top_left.x = glm::min(_bounds.top_left.x, _p1.x);
-	_bounds.top_left.y = glm::max(_bounds.top_left.y, _p1.y);
-	_bounds.bottom_right.x = glm::max(_bounds.bottom_right.x, _p1.x);
-	_bounds.bottom_right.y = glm::min(_bounds.bottom_right.y, _p1.y);
+	_bounds.top_left.x = glm::min(_bounds.top_left.x, (geometry::real)_p1.x);
+	_bounds.top_left.y = glm::max(_bounds.top_left.y, (geometry::real)_p1.y);
+	_bounds.bottom_right.x = glm::max(_bounds.bottom_right.x, (geometry::real)_p1.x);
+	_bounds.bottom_right.y = glm::min(_bounds.bottom_right.y, (geometry::real)_p1.y);
 
 	_bounds = _bounds.offset(PRECISION);
 
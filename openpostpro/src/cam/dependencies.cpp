@@ -0,0 +1,87 @@
+#include "dependencies.h"
+#include <logger.h>
+#include <algorithm>
+#include <string>
+
+std::unordered_map<unsigned int, std::vector<Toolpath*>> Dependencies::_toolpaths;
+std::unordered_map<Toolpath*, std::vector<unsigned int>> Dependencies::_shapes;
+std::unordered_set<Toolpath*> Dependencies::_dirty;
+unsigned long long Dependencies::_skipped = 0;
+std::mutex Dependencies::_mutex;
+
+void Dependencies::unlink(Toolpath* t)
+{
+	auto it = _shapes.find(t);
+	if (it == _shapes.end())
+		return;
+
+	for (unsigned int id : it->second)
+	{
+		auto& list = _toolpaths[id];
+		list.erase(std::remove(list.begin(), list.end(), t), list.end());
+		if (list.empty())
+			_toolpaths.erase(id);
+	}
+	_shapes.erase(it);
+}
+
+void Dependencies::depend(Toolpath* t, const std::vector<unsigned int>& shapes)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	unlink(t);
+	_dirty.erase(t);
+
+	auto& list = _shapes[t];
+	for (unsigned int id : shapes)
+	{
+		if (std::find(list.begin(), list.end(), id) == list.end())
+		{
+			list.push_back(id);
+			_toolpaths[id].push_back(t);
+		}
+	}
+}
+
+void Dependencies::remove(Toolpath* t)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	unlink(t);
+	_dirty.erase(t);
+}
+
+std::vector<unsigned int> Dependencies::shapes(Toolpath* t)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto it = _shapes.find(t);
+	return it == _shapes.end() ? std::vector<unsigned int>() : it->second;
+}
+
+void Dependencies::modified(unsigned int shape)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto it = _toolpaths.find(shape);
+	if (it != _toolpaths.end())
+		_dirty.insert(it->second.begin(), it->second.end());
+}
+
+bool Dependencies::dirty()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return !_dirty.empty();
+}
+
+bool Dependencies::dirty(Toolpath* t)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _dirty.find(t) != _dirty.end();
+}
+
+void Dependencies::rebuilt(size_t count, size_t skipped)
+{
+	_skipped += skipped;
+	Logger::log("toolpaths rebuilt: " + std::to_string(count) + " skipped: " + std::to_string(skipped) + " (total skipped: " + std::to_string(_skipped) + ")");
+}
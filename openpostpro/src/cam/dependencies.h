@@ -0,0 +1,63 @@
+#pragma once
+#ifndef _DEPENDENCIES_H
+#define _DEPENDENCIES_H
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+
+class Toolpath;
+
+/************************************************************************
+* Dependencies of the toolpaths on the shapes they are built from
+* A toolpath depends on every shape of the chains of its curves. Computing
+* or removing a shape marks the toolpaths depending on it dirty, the CAD
+* module then rebuilds these ones only, in document order, once per frame
+* and before the output. Shapes can be computed from several threads
+*************************************************************************/
+class Dependencies
+{
+private:
+	static std::unordered_map<unsigned int, std::vector<Toolpath*>> _toolpaths;	// by shape id
+	static std::unordered_map<Toolpath*, std::vector<unsigned int>> _shapes;		// by toolpath
+	static std::unordered_set<Toolpath*> _dirty;
+	static unsigned long long _skipped;
+	static std::mutex _mutex;
+
+	static void unlink(Toolpath* t);
+
+public:
+	/// <summary>
+	/// Set the shapes toolpath t is built from, t is clean
+	/// </summary>
+	static void depend(Toolpath* t, const std::vector<unsigned int>& shapes);
+
+	/// <summary>
+	/// Forget toolpath t, when deleted
+	/// </summary>
+	static void remove(Toolpath* t);
+
+	/// <summary>
+	/// Shapes toolpath t is built from
+	/// </summary>
+	static std::vector<unsigned int> shapes(Toolpath* t);
+
+	/// <summary>
+	/// Shape was computed or removed, its toolpaths have to be rebuilt
+	/// </summary>
+	static void modified(unsigned int shape);
+
+	/// <summary>
+	/// Return true if a toolpath has to be rebuilt
+	/// </summary>
+	static bool dirty();
+	static bool dirty(Toolpath* t);
+
+	/// <summary>
+	/// Count the toolpaths of a rebuild, skipped ones are clean and keep their curves, and log it
+	/// </summary>
+	static void rebuilt(size_t count, size_t skipped);
+};
+
+#endif
@@ -53,7 +53,7 @@ void Drill::scaled()
 
 void Drill::draw()
 {
-	_data_buffer->draw(_render->pr_lines());
+	_data_buffer->draw(_render->pr_lines(), 0, (int)_data_buffer->size(), _instances);
 }
 
 void Drill::ui()
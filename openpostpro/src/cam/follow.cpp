@@ -23,14 +23,7 @@ void Follow::scaled()
 
 std::vector<Curve> Follow::coordinates()
 {
-	std::vector<Curve> result;
-
-	for (Curve c : _computed)
-	{
-		Curve n = c;
-		result.push_back(n);
-	}
-	return result;
+	return _computed;
 }
 
 void Follow::ui()
@@ -3,6 +3,7 @@
 #include <strings.h>
 #include <lang.h>
 #include <logger.h>
+#include <dependencies.h>
 
 void Group::tool_radius(float value)
 {
@@ -52,6 +53,46 @@ void Group::start_point_offset(float value)
 	}
 }
 
+void Group::repeat()
+{
+	for (auto t : _toolpaths)
+		t->instances(std::max(1, _repeat_x) * std::max(1, _repeat_y));
+}
+
+void Group::repeat_x(int value)
+{
+	if (_repeat_x != value)
+	{
+		_repeat_x = value;
+		repeat();
+	}
+}
+
+void Group::repeat_y(int value)
+{
+	if (_repeat_y != value)
+	{
+		_repeat_y = value;
+		repeat();
+	}
+}
+
+std::vector<glm::vec2> Group::instances()
+{
+	int columns = std::max(1, _repeat_x), rows = std::max(1, _repeat_y);
+	std::vector<glm::vec2> result;
+	result.reserve((size_t)columns * rows);
+	for (int y = 0; y < rows; y++)
+	{
+		for (int i = 0; i < columns; i++)
+		{
+			int x = y % 2 == 0 ? i : columns - 1 - i;
+			result.push_back(glm::vec2(x * _repeat_x_offset, y * _repeat_y_offset));
+		}
+	}
+	return result;
+}
+
 Group::Group(Renderer* r) : Graphic(r)
 {
 	_color = config.groupColor;
@@ -100,6 +141,7 @@ void Group::add(Toolpath* value)
 	// default group params
 	value->start_point_offset(_start_point_offset);
 	value->start_point_type(_start_point_type);
+	value->instances(std::max(1, _repeat_x) * std::max(1, _repeat_y));
 
 	_toolpaths.push_back(value);
 	value->parent(_name);
@@ -111,7 +153,10 @@ void Group::remove(Toolpath* value)
 	{
 		auto it = std::find(_toolpaths.begin(), _toolpaths.end(), value);
 		if (it != _toolpaths.end())
+		{
 			_toolpaths.erase(it);
+			Dependencies::remove(value);
+		}
 	}
 }
 
@@ -182,6 +227,9 @@ void Group::draw()
 	// start drawing
 	if (_visible)
 	{
+		// repeats are drawn as instances of each toolpath
+		_render->set_uniform("instance_columns", std::max(1, _repeat_x));
+		_render->set_uniform("instance_step", glm::vec2(_repeat_x_offset, _repeat_y_offset));
 		_render->set_uniform("inner_color", _color);
 		auto cc = _color, lc = _color;
 		for (Toolpath* f : _toolpaths)
@@ -195,6 +243,7 @@ void Group::draw()
 			lc = cc;
 			f->draw();
 		}
+		_render->set_uniform("instance_columns", 1);
 	}
 }
 
@@ -568,6 +617,57 @@ void Group::ui()
 		}
 	}
 
+	// REPEAT
+	ImGui::TableNextRow();
+	ImGui::TableSetColumnIndex(0);
+	ImGui::Spacing();
+	ImGui::Text(Lang::l("GROUP_REPEAT_X"));
+	ImGui::TableSetColumnIndex(1);
+	int rx = _repeat_x;
+	if (ImGui::InputInt("##GROUP_REPEAT_X", &rx, 0, 0, ImGuiInputTextFlags_EnterReturnsTrue))
+	{
+		repeat_x(std::max(0, rx));
+	}
+
+	if (_repeat_x > 1)
+	{
+		ImGui::TableNextRow();
+		ImGui::TableSetColumnIndex(0);
+		ImGui::Spacing();
+		ImGui::Text(Lang::l("GROUP_REPEAT_X_OFFSET"));
+		ImGui::TableSetColumnIndex(1);
+		float rxo = _repeat_x_offset;
+		if (ImGui::InputFloat("##GROUP_REPEAT_X_OFFSET", &rxo, 0, 0, "%.3f", ImGuiInputTextFlags_EnterReturnsTrue))
+		{
+			repeat_x_offset(rxo);
+		}
+	}
+
+	ImGui::TableNextRow();
+	ImGui::TableSetColumnIndex(0);
+	ImGui::Spacing();
+	ImGui::Text(Lang::l("GROUP_REPEAT_Y"));
+	ImGui::TableSetColumnIndex(1);
+	int ry = _repeat_y;
+	if (ImGui::InputInt("##GROUP_REPEAT_Y", &ry, 0, 0, ImGuiInputTextFlags_EnterReturnsTrue))
+	{
+		repeat_y(std::max(0, ry));
+	}
+
+	if (_repeat_y > 1)
+	{
+		ImGui::TableNextRow();
+		ImGui::TableSetColumnIndex(0);
+		ImGui::Spacing();
+		ImGui::Text(Lang::l("GROUP_REPEAT_Y_OFFSET"));
+		ImGui::TableSetColumnIndex(1);
+		float ryo = _repeat_y_offset;
+		if (ImGui::InputFloat("##GROUP_REPEAT_Y_OFFSET", &ryo, 0, 0, "%.3f", ImGuiInputTextFlags_EnterReturnsTrue))
+		{
+			repeat_y_offset(ryo);
+		}
+	}
+
 	ImGui::EndTable();
 	ImGui::End();
 }
@@ -593,7 +693,11 @@ std::string Group::write()
 		WS(_pre_command) +
 		WS(_post_command) +
 		WN((int)_start_point_type) +
-		WF(_start_point_offset);
+		WF(_start_point_offset) +
+		WN(_repeat_x) +
+		WF(_repeat_x_offset) +
+		WN(_repeat_y) +
+		WF(_repeat_y_offset);
 
 	return result;
 }
@@ -621,5 +725,12 @@ void Group::read(std::string value, float version)
 		RS(_post_command, 15);
 		if (16 < data.size()) _start_point_type = (StartPointType)std::stoi(data[16]);
 		RF(_start_point_offset, 17);
+		RI(_repeat_x, 18);
+		RF(_repeat_x_offset, 19);
+		RI(_repeat_y, 20);
+		RF(_repeat_y_offset, 21);
 	}
+
+	// undo and redo read existing groups, their toolpaths draw the read repeats
+	repeat();
 }
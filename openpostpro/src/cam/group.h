@@ -50,6 +50,11 @@ private:
 	int _repeat_y = 0;
 	float _repeat_y_offset = 10;
 
+	/// <summary>
+	/// Push the number of copies of the repeats to the toolpaths
+	/// </summary>
+	void repeat();
+
 public:
 	std::vector<Toolpath*>& toolpaths() { return _toolpaths; }
 	glm::vec4 color() { return _color; }
@@ -115,6 +120,22 @@ public:
 	float start_point_offset() { return _start_point_offset; }
 	void start_point_offset(float value);
 
+	int repeat_x() { return _repeat_x; }
+	void repeat_x(int value);
+	float repeat_x_offset() { return _repeat_x_offset; }
+	void repeat_x_offset(float value) { _repeat_x_offset = value; }
+
+	int repeat_y() { return _repeat_y; }
+	void repeat_y(int value);
+	float repeat_y_offset() { return _repeat_y_offset; }
+	void repeat_y_offset(float value) { _repeat_y_offset = value; }
+
+	/// <summary>
+	/// Offset of each copy of the group, the first one is 0. Rows go back and forth to shorten the moves between copies.
+	/// Copies are instances of the toolpaths : they are computed once, drawn in one call and only moved in the output
+	/// </summary>
+	std::vector<glm::vec2> instances();
+
 	Group(Renderer* r);
 	~Group();
 
@@ -53,7 +53,7 @@ void MoveTo::scaled()
 
 void MoveTo::draw()
 {
-	_data_buffer->draw(_render->pr_lines());
+	_data_buffer->draw(_render->pr_lines(), 0, (int)_data_buffer->size(), _instances);
 }
 
 void MoveTo::ui()
@@ -2,20 +2,39 @@
 #include <imgui.h>
 #include <lang.h>
 #include <strings.h>
+#include <workers.h>
 
-void Offset::update()
+std::function<std::vector<Curve>()> Offset::task()
 {
-	_computed.clear();
+	// the job orients and offsets its own copy of the curves, the UI reads the originals meanwhile
+	float radius = _interior ? -_radius : _radius;
+
+	return [this, curves = _original, radius, cw = _cw]() mutable {
+		std::vector<Curve> result;
+
+		// curves are independent, offsets are computed on the worker pool and kept in original order.
+		// Curves not started yet are skipped once a newer computation is waiting
+		auto offsets = Workers::map(curves, [this, radius, cw](Curve& c) {
+			if (cancelled())
+				return std::vector<Curve>();
+			Stats::Scope scope(_stats);
+			Arena::Scope arena;
+			c.cw(cw);
+			return c.offset(radius);
+			});
+
+		for (auto& o : offsets)
+			result.insert(result.end(), std::make_move_iterator(o.begin()), std::make_move_iterator(o.end()));
+
+		return result;
+		};
+}
 
-	auto sign = _interior ? -1 : 1;
+void Offset::update()
+{
+	if (!publish())
+		return;
 
-	for (Curve& c : _original)
-	{
-		c.cw(_cw);
-		auto curves = c.offset(radius() * sign);
-		_computed.insert(_computed.end(), curves.begin(), curves.end());
-	}
-	
 	_start_point_inside = _interior;
 
 	generate_startpoint(_computed);
@@ -30,14 +49,7 @@ void Offset::scaled()
 
 std::vector<Curve> Offset::coordinates()
 {
-	std::vector<Curve> result;
-
-	for (Curve c : _computed)
-	{
-		Curve n = c;
-		result.push_back(n);
-	}
-	return result;
+	return _computed;
 }
 
 void Offset::ui()
@@ -9,16 +9,20 @@ class Offset : public Toolpath
 private:
 	bool _interior = true;
 
+	std::function<std::vector<Curve>()> task() override;
+
 public:
 	GraphicType type() override { return GraphicType::CamOffset; }
 
 	Offset(Renderer* r) : Toolpath(r) {}
+	~Offset() { cancel(); }
 
 	bool interior() { return _interior; }
 	void interior(bool value) { _interior = value; }
 	
 	bool start_point_allowed() override { return true; }
 
+	bool background() override { return true; }
 	void update() override;
 	void scaled() override;
 	std::vector<Curve> coordinates() override;
@@ -1,6 +1,9 @@
 #include "pocket.h"
 #include <imgui.h>
 #include <lang.h>
+#include <workers.h>
+#include <ladder.h>
+#include <memory>
 
 void Pocket::mode(PocketMode value)
 {
@@ -20,406 +23,91 @@ void Pocket::finishing(float value)
 	}
 }
 
-std::vector<Curve> Pocket::zigzag(std::vector<Curve>& curves)
+std::vector<Curve> Pocket::offset(std::vector<Curve>& curves, float radius)
 {
-	std::vector<Curve> result, temp;
-
-	if (curves.size() == 0)
-		return result;
-
-	// we needs to extract curves by couple 1-2, 3-4, 5-6...
-	Curve::sort_level(curves);
-	int ref = 1;
-	std::vector<std::vector<Curve>> sorted_levels;
-	sorted_levels.push_back(std::vector<Curve>());
-	for (Curve& curve : curves)
-	{
-		if (curve.level() == ref || curve.level() == ref + 1)
-			sorted_levels.back().push_back(curve);
-		else
-		{
-			ref += 2;
-			sorted_levels.push_back(std::vector<Curve>());
-			sorted_levels.back().push_back(curve);
-		}
-	}
-
-	for (std::vector<Curve> inter : sorted_levels)
-	{
-		Curve::sort_level(inter);
-		auto cw = inter.front().cw();
-
-		// checking iner and outer, the inner contour should exist, otherwise there is an algo issue
-		int smaller_level = std::numeric_limits<int>::max();
-		int greater_level = std::numeric_limits<int>::max();
-
-		while (inter.size() > 0 && smaller_level == greater_level)
-		{
-			// sort the list following level, because if different level, we have to make the substrat based on lower level
-			Curve::sort_level(inter);
-
-			temp.clear();
-
-			smaller_level = std::numeric_limits<int>::max();
-			greater_level = std::numeric_limits<int>::max();
-
-			for (Curve& c : inter)
-			{
-				auto o = c.offset((c.cw() == cw ? -radius() : radius()));
-				smaller_level = glm::min(smaller_level, c.level());
-				if (o.size() > 0)
-					greater_level = glm::min(greater_level, c.level());
-				temp.insert(temp.begin(), o.begin(), o.end());
-			}
-
-			if (temp.size() > 1)
-			{
-				std::vector<Curve>::iterator it1 = temp.begin();
-				while (it1 != temp.end() && temp.size() > 1)
-				{
-					bool merged = false;
-					std::vector<Curve>::iterator it2 = it1 + 1;
-					while (it2 != temp.end())
-					{
-						auto cw1 = (*it1).cw();
-						auto cw2 = (*it2).cw();
-						std::vector<Curve> merged_curves;
-
-						if ((*it1).level() != (*it2).level())
-						{
-							if ((*it1).level() < (*it2).level())
-								merged_curves = (*it1).boolean_substract((*it2));
-							else
-								merged_curves = (*it2).boolean_substract((*it1));
-						}
-						else
-							merged_curves = (*it1).boolean_union((*it2));
-
-
-						if (merged = merged_curves.size() > 0)
-						{
-							for (Curve& m : merged_curves)
-							{
-								m.close();
-								//m.cw(cw1);
-								m.level((*it1).level());
-							}
-							temp.erase(it2);
-							temp.erase(it1);
-							temp.insert(temp.begin(), merged_curves.begin(), merged_curves.end());
-							break;
-						}
-						else
-						{
-							(*it1).cw(cw1);
-							(*it1).close();
-							(*it2).cw(cw2);
-							(*it2).close();
-							it2++;
-						}
-					}
-					if (merged)
-						it1 = temp.begin();
-					else
-						it1++;
-				}
-			}
-
-			auto s = temp.size();
-
-			result.insert(result.end(), temp.begin(), temp.end());
-			inter = temp;
-		}
-	}
-
-	for (auto& c : result)
-		c.close();
-	return result;
+	OffsetLadder ladder(curves);
+	return ladder.rings(radius);
 }
 
-std::vector<Curve> Pocket::offset(std::vector<Curve>& curves)
+std::vector<Curve> Pocket::pocket(TreeCurve* t, float radius, float finishing)
 {
-	std::vector<Curve> result, temp;
+	std::vector<Curve> result;
+	std::vector<Curve> inner;
 
-	if (curves.size() == 0)
-		return result;
+	bool cw = t->curve->cw();
+	auto original = t->curves();
 
-	// we needs to extract curves by couple 1-2, 3-4, 5-6...
-	Curve::sort_level(curves);
-	int ref = 1;
-	std::vector<std::vector<Curve>> sorted_levels;
-	sorted_levels.push_back(std::vector<Curve>());
-	for (Curve& curve : curves)
+	// we first proceed to an offset with the radius
+	for (Curve& c : original)
 	{
-		if (curve.level() == ref || curve.level() == ref + 1)
-			sorted_levels.back().push_back(curve);
-		else
-		{
-			ref += 2;
-			sorted_levels.push_back(std::vector<Curve>());
-			sorted_levels.back().push_back(curve);
-		}
+		c.simplify(geometry::ERR_FLOAT2);
+		c.reduce(0.25f);
+		auto curves = c.offset((c.cw() == cw ? -radius : radius));
+		inner.insert(inner.end(), std::make_move_iterator(curves.begin()), std::make_move_iterator(curves.end()));
 	}
+	inner = OffsetLadder::merge(inner);
 
-	for (std::vector<Curve> inter : sorted_levels)
+	// if finishing is set, we offset by finishing
+	std::vector<Curve> finish;
+	if (finishing > 0)
 	{
-		Curve::sort_level(inter);
-		auto cw = inter.front().cw();
-
-		// checking iner and outer, the inner contour should exist, otherwise there is an algo issue
-		int smaller_level = std::numeric_limits<int>::max();
-		int greater_level = std::numeric_limits<int>::max();
-
-		while (inter.size() > 0 && smaller_level == greater_level)
+		for (Curve& c : inner)
 		{
-			// sort the list following level, because if different level, we have to make the substrat based on lower level
-			Curve::sort_level(inter);
-
-			temp.clear();
-
-			smaller_level = std::numeric_limits<int>::max();
-			greater_level = std::numeric_limits<int>::max();
-
-			for (Curve& c : inter)
-			{
-				auto o = c.offset((c.cw() == cw ? -radius() : radius()));
-				smaller_level = glm::min(smaller_level, c.level());
-				if (o.size() > 0)
-					greater_level = glm::min(greater_level, c.level());
-				temp.insert(temp.begin(), o.begin(), o.end());
-			}
-
-			if (temp.size() > 1)
-			{
-				std::vector<Curve>::iterator it1 = temp.begin();
-				while (it1 != temp.end() && temp.size() > 1)
-				{
-					bool merged = false;
-					std::vector<Curve>::iterator it2 = it1 + 1;
-					while (it2 != temp.end())
-					{
-						auto cw1 = (*it1).cw();
-						auto cw2 = (*it2).cw();
-						std::vector<Curve> merged_curves;
-
-						if ((*it1).level() != (*it2).level())
-						{
-							if ((*it1).level() < (*it2).level())
-								merged_curves = (*it1).boolean_substract((*it2));
-							else
-								merged_curves = (*it2).boolean_substract((*it1));
-						}
-						else
-							merged_curves = (*it1).boolean_union((*it2));
-
-
-						if (merged = merged_curves.size() > 0)
-						{
-							for (Curve& m : merged_curves)
-							{
-								m.close();
-								//m.cw(cw1);
-								m.level((*it1).level());
-							}
-							temp.erase(it2);
-							temp.erase(it1);
-							temp.insert(temp.begin(), merged_curves.begin(), merged_curves.end());
-							break;
-						}
-						else
-						{
-							(*it1).cw(cw1);
-							(*it1).close();
-							(*it2).cw(cw2);
-							(*it2).close();
-							it2++;
-						}
-					}
-					if (merged)
-						it1 = temp.begin();
-					else
-						it1++;
-				}
-			}
-
-			auto s = temp.size();
-
-			result.insert(result.end(), temp.begin(), temp.end());
-			inter = temp;
+			auto curves = c.offset((c.cw() == cw ? finishing : -finishing));
+			finish.insert(finish.end(), std::make_move_iterator(curves.begin()), std::make_move_iterator(curves.end()));
 		}
 	}
+	else
+		finish = std::move(inner);
 
-	for (auto& c : result)
-		c.close();
+	std::vector<Curve> process;
+	// both modes clear the pocket with the rings of the ladder
+	if (finish.size() > 0)
+		process = offset(finish, radius);
+
+	result = std::move(process);
+	result.insert(result.end(), std::make_move_iterator(finish.begin()), std::make_move_iterator(finish.end()));
 
 	return result;
 }
 
-std::vector<Curve> Pocket::merge(std::vector<Curve>& curves)
+std::function<std::vector<Curve>()> Pocket::task()
 {
-	std::vector<Curve> result, temp;
-
-	if (curves.size() == 0)
-		return result;
-
-	// we needs to extract curves by couple 1-2, 3-4, 5-6...
-	Curve::sort_level(curves);
-	int ref = 1;
-	std::vector<std::vector<Curve>> sorted_levels;
-	sorted_levels.push_back(std::vector<Curve>());
-	for (Curve& curve : curves)
-	{
-		if (curve.level() == ref || curve.level() == ref + 1)
-			sorted_levels.back().push_back(curve);
-		else
-		{
-			ref += 2;
-			sorted_levels.push_back(std::vector<Curve>());
-			sorted_levels.back().push_back(curve);
-		}
-	}
-
-	for (std::vector<Curve> inter : sorted_levels)
-	{
-		Curve::sort_level(inter);
-		auto cw = inter.front().cw();
+	// the job orients its own copy of the tree, the toolpath tree and settings stay with the UI
+	std::shared_ptr<TreeCurve> tree(_tree != nullptr ? _tree->copy() : nullptr);
 
-		// checking iner and outer, the inner contour should exist, otherwise there is an algo issue
-		int smaller_level = std::numeric_limits<int>::max();
-		int greater_level = std::numeric_limits<int>::max();
+	return [this, tree, radius = _radius, finishing = _finishing, cw = _cw]() {
+		std::vector<Curve> result;
 
-		while (inter.size() > 0 && smaller_level == greater_level)
+		if (tree != nullptr)
 		{
-			// sort the list following level, because if different level, we have to make the substrat based on lower level
-			Curve::sort_level(inter);
-
-			temp.clear();
-
-			smaller_level = std::numeric_limits<int>::max();
-			greater_level = std::numeric_limits<int>::max();
-
-			for (Curve& c : inter)
-			{
-				smaller_level = glm::min(smaller_level, c.level());
-				temp.push_back(c);
-			}
-
-			if (temp.size() > 1)
-			{
-				std::vector<Curve>::iterator it1 = temp.begin();
-				while (it1 != temp.end() && temp.size() > 1)
-				{
-					bool merged = false;
-					std::vector<Curve>::iterator it2 = it1 + 1;
-					while (it2 != temp.end())
-					{
-						auto cw1 = (*it1).cw();
-						auto cw2 = (*it2).cw();
-						std::vector<Curve> merged_curves;
-
-						if ((*it1).level() != (*it2).level())
-						{
-							if ((*it1).level() < (*it2).level())
-								merged_curves = (*it1).boolean_substract((*it2));
-							else
-								merged_curves = (*it2).boolean_substract((*it1));
-						}
-						else
-							merged_curves = (*it1).boolean_union((*it2));
-
-
-						if (merged = merged_curves.size() > 0)
-						{
-							for (Curve& m : merged_curves)
-							{
-								m.close();
-								m.level((*it1).level());
-							}
-							temp.erase(it2);
-							temp.erase(it1);
-							temp.insert(temp.begin(), merged_curves.begin(), merged_curves.end());
-							break;
-						}
-						else
-						{
-							(*it1).cw(cw1);
-							(*it1).close();
-							(*it2).cw(cw2);
-							(*it2).close();
-							it2++;
-						}
-					}
-					if (merged)
-						it1 = temp.begin();
-					else
-						it1++;
-				}
-			}
-
-			auto s = temp.size();
-
-			result.insert(result.end(), temp.begin(), temp.end());
-			inter = temp;
+			tree->cw_alter(!cw);
+
+			// children are independent parts, they are computed on the worker pool and kept in tree order.
+			// Parts not started yet are skipped once a newer computation is waiting
+			auto pockets = Workers::map(tree->children, [this, radius, finishing](TreeCurve* t) {
+				if (cancelled())
+					return std::vector<Curve>();
+				Stats::Scope scope(_stats);
+				Arena::Scope arena;
+				return pocket(t, radius, finishing);
+				});
+
+			for (auto& curves : pockets)
+				result.insert(result.end(), std::make_move_iterator(curves.begin()), std::make_move_iterator(curves.end()));
 		}
-	}
 
-	for (auto c : result)
-		c.close();
-
-	return result;
+		return result;
+		};
 }
 
 void Pocket::update()
 {
+	if (!publish())
+		return;
+
 	if (_tree != nullptr)
 	{
-		_computed.clear();
-		std::vector<Curve> inner;
-
-		_tree->cw_alter(!cw());
-
-		for (TreeCurve* t : _tree->children)
-		{
-			bool cw = t->curve->cw();
-			_original = t->curves();
-
-
-			// we first proceed to an offset with the radius
-			for (Curve& c : _original)
-			{
-				c.reduce(0.25f);
-				auto curves = c.offset((c.cw() == cw ? -radius() : radius()));
-				inner.insert(inner.end(), curves.begin(), curves.end());
-			}
-			inner = merge(inner);
-
-			// if finishing is set, we offset by finishing
-			std::vector<Curve> finish;
-			if (_finishing > 0)
-			{
-				for (Curve& c : inner)
-				{
-					auto curves = c.offset((c.cw() == cw ? _finishing : -_finishing));
-					finish.insert(finish.end(), curves.begin(), curves.end());
-				}
-			}
-			else
-				finish.insert(finish.end(), inner.begin(), inner.end());
-
-			std::vector<Curve> process;
-			if (finish.size() > 0)
-			{
-				if (_mode == PocketMode::Zigzag)
-					process = zigzag(finish);
-				else if (_mode == PocketMode::Offset)
-					process = offset(finish);
-			}
-
-
-			_computed.insert(_computed.end(), process.begin(), process.end());
-			_computed.insert(_computed.end(), finish.begin(), finish.end());
-		}
-
 		generate_data(_computed);
 		generate_deco(_computed);
 	}
@@ -432,14 +120,7 @@ void Pocket::scaled()
 
 std::vector<Curve> Pocket::coordinates()
 {
-	std::vector<Curve> result;
-
-	for (Curve c : _computed)
-	{
-		Curve n = c;
-		result.push_back(n);
-	}
-	return result;
+	return _computed;
 }
 
 void Pocket::ui()
@@ -18,10 +18,13 @@ private:
 	PocketMode _mode = PocketMode::Offset;
 	float _finishing = 0.0f;
 
+	std::function<std::vector<Curve>()> task() override;
+
 public:
 	GraphicType type() override { return GraphicType::CamPocket; }
 
 	Pocket(Renderer* r) : Toolpath(r) {}
+	~Pocket() { cancel(); }
 
 	PocketMode mode() { return _mode; }
 	void mode(PocketMode value);
@@ -32,10 +35,14 @@ public:
 	bool climb() { return _climb; }
 	void climb(bool value) { _climb = value; }
 
-	std::vector<Curve> zigzag(std::vector<Curve>& curves);
-	std::vector<Curve> offset(std::vector<Curve>& curves);
-	std::vector<Curve> merge(std::vector<Curve>& curves);
+	static std::vector<Curve> offset(std::vector<Curve>& curves, float radius);
+
+	/// <summary>
+	/// Return the pocket curves of a tree child and its descendants
+	/// </summary>
+	static std::vector<Curve> pocket(TreeCurve* t, float radius, float finishing);
 
+	bool background() override { return true; }
 	void update() override;
 	void scaled() override;
 	std::vector<Curve> coordinates() override;
@@ -1,5 +1,9 @@
 #include "toolpath.h"
 #include <config.h>
+#include <workers.h>
+#include <jobs.h>
+#include <dependencies.h>
+#include <logger.h>
 
 
 std::vector<int> Toolpath::references()
@@ -90,11 +94,20 @@ Toolpath::Toolpath(Renderer* r) : Graphic(r)
 
 Toolpath::~Toolpath()
 {
+	// the job must not outlive the toolpath
+	cancel();
+	Dependencies::remove(this);
+
 	if (_data_buffer != nullptr)
 	{
 		delete _data_buffer;
 		_data_buffer = nullptr;
 	}
+	if (_deco_buffer != nullptr)
+	{
+		delete _deco_buffer;
+		_deco_buffer = nullptr;
+	}
 	if (_tree != nullptr)
 	{
 		delete _tree;
@@ -208,7 +221,7 @@ void Toolpath::generate_data(std::vector<Curve>& curves)
 	int count = 0;
 
 	// we compute coordinates for each curve
-	for (auto c : curves)
+	for (Curve& c : curves)
 	{
 		if (c.size() > 1)
 		{
@@ -270,7 +283,7 @@ void Toolpath::generate_deco(std::vector<Curve>& curves)
 		auto o = 10 / _render->camera()->scale();
 
 		// we add the arrow to display toolpath direction
-		for (auto c : curves)
+		for (Curve& c : curves)
 		{
 			float length = 25 / _render->camera()->scale();
 			float pos = 0;
@@ -296,7 +309,8 @@ void Toolpath::generate_deco(std::vector<Curve>& curves)
 			glm::vec2 position = geometry::vec2_empty;
 			float angle = 0;
 
-			auto s1 = (*segment), s2 = (segment == c.end()-1 ? c.front() : (*(segment + 1)));
+			Segment& s1 = *segment;
+			Segment& s2 = segment == c.end() - 1 ? c.front() : *(segment + 1);
 			float segment_pos = length - pos;
 			auto segments = s1.split_at(segment_pos, s2.point);
 
@@ -329,7 +343,7 @@ void Toolpath::generate_deco(std::vector<Curve>& curves)
 		if (config.show_cam_start)
 		{
 			auto o = 3.0f / _render->camera()->scale();
-			for (auto c : curves)
+			for (Curve& c : curves)
 			{
 				auto p = c.front().point;
 				vertices.push_back(glm::vec3(p.x - o, p.y - o, 0));
@@ -350,8 +364,22 @@ void Toolpath::add(Curve value)
 	_original.push_back(value);
 }
 
+void Toolpath::original(std::vector<Curve> value)
+{
+	// the running job works on a copy, its result is dropped
+	_generation++;
+	_original = std::move(value);
+}
+
 void Toolpath::tree(TreeCurve* value)
 {
+	if (value == _tree)
+		return;
+
+	// the running job works on a copy, its result is dropped
+	_generation++;
+	if (_tree != nullptr)
+		delete _tree;
 	_tree = value;
 }
 
@@ -362,18 +390,132 @@ void Toolpath::draw()
 	int from = 0;
 	for (auto to : _data_indices)
 	{
-		_data_buffer->draw(_render->pr_line_strip(), from, to - from);
+		_data_buffer->draw(_render->pr_line_strip(), from, to - from, _instances);
 		from = to;
 	}
 	
 	from = 0;
 	for (auto to : _deco_indices)
 	{
-		_deco_buffer->draw(_render->pr_line_strip(), from, to - from);
+		_deco_buffer->draw(_render->pr_line_strip(), from, to - from, _instances);
 		from = to;
 	}
 }
 
+void Toolpath::compute()
+{
+	_generation++;
+	Graphic::compute();
+}
+
+void Toolpath::cancel()
+{
+	_generation++;
+	Jobs::cancel(this);
+}
+
+void Toolpath::run_process(int generation, const std::function<std::vector<Curve>()>& task)
+{
+	_processing = generation;
+	if (cancelled() || !task)
+		return;
+
+	std::vector<Curve> result;
+	{
+		Stats::Scope scope(_stats);
+		Arena::Scope arena;
+		result = task();
+	}
+
+	std::lock_guard<std::mutex> lock(_result_mutex);
+	if (!cancelled())
+	{
+		_result = std::move(result);
+		_result_generation = generation;
+		_result_stats = _stats;
+	}
+	_stats = Stats::Counters();
+}
+
+void Toolpath::post()
+{
+	int generation = _generation;
+	if (_posted != generation)
+	{
+		_posted = generation;
+		Jobs::post(this, [this, generation, task = task()] { run_process(generation, task); });
+	}
+}
+
+bool Toolpath::publish()
+{
+	int generation = _generation;
+	if (_published == generation)
+		return true;
+
+	Stats::Counters stats;
+	{
+		std::lock_guard<std::mutex> lock(_result_mutex);
+		if (_result_generation == generation)
+		{
+			_computed = std::move(_result);
+			_result = std::vector<Curve>();
+			_result_generation = -1;
+			_published = generation;
+			stats = _result_stats;
+		}
+	}
+
+	if (_published != generation)
+	{
+		post();
+		needs_update();
+		return false;
+	}
+
+	if (Stats::enabled && !stats.empty())
+		Logger::log(_name + " " + stats.str());
+	return true;
+}
+
+void Toolpath::wait()
+{
+	// the other toolpaths are updated by draw, headless runs do not draw
+	if (!background())
+	{
+		if (_needs_update)
+		{
+			_needs_update = false;
+			update();
+		}
+		return;
+	}
+
+	if (_published == _generation)
+		return;
+
+	post();
+	Jobs::wait(this);
+	update();
+	_needs_update = false;
+}
+
+void Toolpath::process(std::vector<Toolpath*>& toolpaths)
+{
+	// the render thread finds the jobs done
+	std::vector<std::function<std::vector<Curve>()>> tasks;
+	for (Toolpath* t : toolpaths)
+	{
+		Jobs::cancel(t);
+		t->_posted = t->_generation;
+		tasks.push_back(t->task());
+	}
+
+	Workers::run(toolpaths.size(), [&toolpaths, &tasks](size_t i) {
+		toolpaths[i]->run_process(toolpaths[i]->_posted, tasks[i]);
+		});
+}
+
 bool Toolpath::cw()
 {
 	return _cw;
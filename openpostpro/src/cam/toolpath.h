@@ -5,6 +5,11 @@
 #include "graphic.h"
 #include <geometry.h>
 #include <curve.h>
+#include <stats.h>
+#include <arena.h>
+#include <atomic>
+#include <mutex>
+#include <functional>
 
 enum class StartPointType {
 	normal,
@@ -18,6 +23,28 @@ private:
 	std::string _parent;
 	std::vector<int> _references_id;
 
+	// curves of task() are computed by a background job, then published in _computed by the render thread.
+	// compute() starts a new generation, the results of an older one are dropped
+	std::atomic<int> _generation = 0;
+	std::atomic<int> _processing = -1;	// generation of the running job
+	int _posted = -1;					// last generation posted, render thread only
+	int _published = -1;				// generation of _computed, render thread only
+	std::mutex _result_mutex;
+	std::vector<Curve> _result;
+	int _result_generation = -1;
+	Stats::Counters _result_stats;
+
+	/// <summary>
+	/// Run task for generation and keep its curves and geometry counters for publish, unless a newer generation started meanwhile.
+	/// Temporaries of the computation are released at once at the end
+	/// </summary>
+	void run_process(int generation, const std::function<std::vector<Curve>()>& task);
+
+	/// <summary>
+	/// Post the job of the current generation unless it is already posted
+	/// </summary>
+	void post();
+
 protected:
 	bool _cw = false;
 	float _radius = 0;
@@ -28,6 +55,7 @@ protected:
 	Buffer* _deco_buffer = nullptr;
 	std::vector<int> _data_indices;
 	std::vector<int> _deco_indices;
+	int _instances = 1;
 
 	StartPointType _start_point_type = StartPointType::normal;
 	float _start_point_length = 0;
@@ -38,6 +66,35 @@ protected:
 	float _tabs_length = 0;
 	float _tabs_height = 0;
 
+	/// <summary>
+	/// Render thread. Return the computation of the curves of the toolpath, run later on a background job.
+	/// It captures a copy of its inputs, the UI keeps editing the toolpath meanwhile : of the toolpath it only uses
+	/// cancelled() and _stats, it should return early when cancelled
+	/// </summary>
+	virtual std::function<std::vector<Curve>()> task() { return nullptr; }
+
+	/// <summary>
+	/// Return true when the task computes a stale generation, a newer one is waiting
+	/// </summary>
+	bool cancelled() const { return _processing != _generation; }
+
+	/// <summary>
+	/// Drop the job of the toolpath and return when its running one is done.
+	/// Derived classes computed in the background call it first in their destructor
+	/// </summary>
+	void cancel();
+
+	/// <summary>
+	/// Geometry counters of the current computation, filled by the Stats::Scope of the task and its loops
+	/// </summary>
+	Stats::Counters _stats;
+
+	/// <summary>
+	/// Render thread. Move the curves of the current generation to _computed and log the geometry counters, return true when _computed is current.
+	/// Otherwise the job is posted and the update is tried again on the next frame
+	/// </summary>
+	bool publish();
+
 	void generate_startpoint(std::vector<Curve>& curves);
 	void generate_data(std::vector<Curve>& curves);
 	void generate_deco(std::vector<Curve>& curves);
@@ -70,6 +127,12 @@ public:
 	void start_point_inside(bool value);
 	float start_point_inside() { return _start_point_inside; }
 
+	/// <summary>
+	/// Number of copies drawn, the group repeats. The curves are computed once
+	/// </summary>
+	void instances(int value) { _instances = std::max(1, value); }
+	int instances() { return _instances; }
+
 	virtual bool tabs_allowed() { return false; }
 
 	void tabs_count(float value);
@@ -83,13 +146,38 @@ public:
 	
 	virtual int closed_curves() { return 0; }
 
+	/// <summary>
+	/// Return true if the curves are computed by task() on a background job
+	/// </summary>
+	virtual bool background() { return false; }
+
+	/// <summary>
+	/// Wait for the curves of the current generation and update the toolpath, before reading its coordinates
+	/// </summary>
+	void wait();
+
 	Toolpath(Renderer* r);
-	~Toolpath();
+	virtual ~Toolpath();
 
 	void add(Curve value);
+
+	/// <summary>
+	/// Replace the curves the toolpath is computed from
+	/// </summary>
+	void original(std::vector<Curve> value);
+
+	/// <summary>
+	/// Replace the tree the toolpath is computed from, the previous one is deleted
+	/// </summary>
 	void tree(TreeCurve* value);
 	
 	void draw() override;
+	void compute() override;
+
+	/// <summary>
+	/// Run task() of each toolpath on the worker pool, the next update() only publishes the curves and generates render data
+	/// </summary>
+	static void process(std::vector<Toolpath*>& toolpaths);
 
 	bool cw();
 	virtual void cw(bool value);
@@ -0,0 +1,54 @@
+#include "arena.h"
+#include <stats.h>
+
+namespace
+{
+	/// <summary>
+	/// Heap with allocation counter
+	/// </summary>
+	class Heap : public std::pmr::memory_resource
+	{
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			Stats::add(Stats::allocations);
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	Heap _heap;
+	thread_local std::pmr::unsynchronized_pool_resource* _pool = nullptr;
+	thread_local int _depth = 0;
+}
+
+std::pmr::memory_resource* Arena::resource()
+{
+	if (_pool != nullptr)
+		return _pool;
+	return &_heap;
+}
+
+Arena::Scope::Scope()
+{
+	if (_depth++ == 0)
+		_pool = new std::pmr::unsynchronized_pool_resource(&_heap);
+}
+
+Arena::Scope::~Scope()
+{
+	if (--_depth == 0)
+	{
+		delete _pool;
+		_pool = nullptr;
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+#ifndef _ARENA_H
+#define _ARENA_H
+
+#include <memory_resource>
+
+/************************************************************************
+* Memory of the geometry temporaries
+* Offsets, splits and booleans allocate their work containers (lists,
+* maps, candidate and intersection vectors) from Arena::resource().
+* Inside a Scope it is a pool owned by the current thread, blocks are
+* reused and all released at once when the outer scope ends, for example
+* at the end of a toolpath computation. Outside a Scope it is the heap.
+* Allocations reaching the heap are counted by Stats::allocations.
+* Containers allocated from the arena must not outlive the scope
+*************************************************************************/
+class Arena
+{
+public:
+	/// <summary>
+	/// Memory resource of the current thread
+	/// </summary>
+	static std::pmr::memory_resource* resource();
+
+	/// <summary>
+	/// Allocate from a pool of the current thread while in scope. Nested scopes use the pool of the outer one
+	/// </summary>
+	class Scope
+	{
+	public:
+		Scope();
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+};
+
+#endif
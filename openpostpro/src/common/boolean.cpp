@@ -0,0 +1,624 @@
+#include "boolean.h"
+#include <sweep.h>
+#include <stats.h>
+#include <arena.h>
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+
+// vertices closer than weld_distance are merged
+// a piece is classified with two points at side_distance on its left and its right
+static const geometry::real weld_distance = geometry::ERR_FLOAT4;
+static const geometry::real side_distance = geometry::ERR_FLOAT5;
+
+/// <summary>
+/// Return angle a in [0;2PI[
+/// </summary>
+static geometry::real normalize(geometry::real a)
+{
+	a = std::fmod(a, glm::two_pi<geometry::real>());
+	return a < 0 ? a + glm::two_pi<geometry::real>() : a;
+}
+
+static geometry::real cross(geometry::rvec2 a, geometry::rvec2 b)
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+int CurveBoolean::vertex(geometry::rvec2 p)
+{
+	_vertices.push_back(p);
+	return (int)_vertices.size() - 1;
+}
+
+void CurveBoolean::add_edge(geometry::rvec2 start, geometry::rvec2 stop)
+{
+	Edge e;
+	e.start = start;
+	e.stop = stop;
+	_edges.push_back(e);
+}
+
+void CurveBoolean::add_edge(geometry::rvec2 start, geometry::rvec2 center, geometry::rvec2 stop, geometry::real radius, bool cw, geometry::real sweep)
+{
+	Edge e;
+	e.start = start;
+	e.stop = stop;
+	e.center = center;
+	e.radius = radius;
+	e.sweep = sweep;
+	e.arc = true;
+	e.cw = cw;
+	_edges.push_back(e);
+}
+
+geometry::real CurveBoolean::position(Edge& e, geometry::rvec2 p)
+{
+	if (!e.arc)
+	{
+		geometry::rvec2 d = e.stop - e.start;
+		return glm::clamp(glm::dot(p - e.start, d) / glm::dot(d, d), geometry::real(0), geometry::real(1));
+	}
+
+	geometry::real a0 = std::atan2(e.start.y - e.center.y, e.start.x - e.center.x);
+	geometry::real a = std::atan2(p.y - e.center.y, p.x - e.center.x);
+	geometry::real t = e.cw ? normalize(a0 - a) : normalize(a - a0);
+
+	// out of the arc, p is close to one of its ends
+	if (t > e.sweep)
+		t = t - e.sweep < glm::two_pi<geometry::real>() - t ? e.sweep : 0;
+	return t;
+}
+
+geometry::rvec2 CurveBoolean::point(Edge& e, geometry::real t)
+{
+	if (!e.arc)
+		return t >= 1 ? e.stop : e.start + (e.stop - e.start) * t;
+
+	if (t >= e.sweep)
+		return e.stop;
+	geometry::real a = std::atan2(e.start.y - e.center.y, e.start.x - e.center.x) + (e.cw ? -t : t);
+	return e.center + e.radius * geometry::rvec2(std::cos(a), std::sin(a));
+}
+
+geometry::rvec2 CurveBoolean::tangent(Edge& e, geometry::real t)
+{
+	if (!e.arc)
+		return glm::normalize(e.stop - e.start);
+
+	geometry::real a = std::atan2(e.start.y - e.center.y, e.start.x - e.center.x) + (e.cw ? -t : t);
+	geometry::rvec2 d(-std::sin(a), std::cos(a));
+	return e.cw ? -d : d;
+}
+
+geometry::real CurveBoolean::length(Edge& e, geometry::real from, geometry::real to)
+{
+	if (!e.arc)
+		return geometry::distance(e.start, e.stop) * (to - from);
+	return e.radius * (to - from);
+}
+
+void CurveBoolean::cut(int edge, geometry::rvec2 p)
+{
+	// a point of an other edge laying inside this one, used for overlapping edges
+	Edge& e = _edges[edge];
+	if (geometry::distance(p, e.start) < weld_distance || geometry::distance(p, e.stop) < weld_distance)
+		return;
+	if (e.arc ? glm::abs(geometry::distance(p, e.center) - e.radius) >= weld_distance : glm::abs(cross(glm::normalize(e.stop - e.start), p - e.start)) >= weld_distance)
+		return;
+
+	geometry::real t = position(e, p);
+	if (t > 0 && t < (e.arc ? e.sweep : 1))
+		e.cuts.push_back(std::make_pair(t, vertex(p)));
+}
+
+void CurveBoolean::intersect(int e1, int e2)
+{
+	Edge& a = _edges[e1];
+	Edge& b = _edges[e2];
+
+	Stats::add(Stats::intersection_tests);
+
+	Segment s1 = a.arc ? Segment(a.start, a.center, a.radius, a.cw) : Segment(a.start);
+	Segment s2 = b.arc ? Segment(b.start, b.center, b.radius, b.cw) : Segment(b.start);
+
+	geometry::rvec2 result[2];
+	int count = s1.intersect(a.stop, s2, b.stop, result);
+	for (int i = 0; i < count; i++)
+	{
+		// a crossing at the end of an edge is its vertex, the edge is not cut there
+		geometry::rvec2 p = result[i];
+		int va = geometry::distance(p, a.start) < weld_distance ? a.first : geometry::distance(p, a.stop) < weld_distance ? a.last : -1;
+		int vb = geometry::distance(p, b.start) < weld_distance ? b.first : geometry::distance(p, b.stop) < weld_distance ? b.last : -1;
+		if (va >= 0 && vb >= 0)
+			continue;
+
+		int v = va >= 0 ? va : vb >= 0 ? vb : vertex(p);
+		if (va < 0)
+			a.cuts.push_back(std::make_pair(position(a, p), v));
+		if (vb < 0)
+			b.cuts.push_back(std::make_pair(position(b, p), v));
+	}
+
+	// overlapping edges : lines on the same line, arcs on the same circle, are cut at the ends of the other one
+	bool overlap = false;
+	if (!a.arc && !b.arc)
+	{
+		geometry::rvec2 d = glm::normalize(a.stop - a.start);
+		overlap = glm::abs(cross(d, b.start - a.start)) < weld_distance && glm::abs(cross(d, b.stop - a.start)) < weld_distance;
+	}
+	else if (a.arc && b.arc)
+		overlap = geometry::distance(a.center, b.center) < weld_distance && glm::abs(a.radius - b.radius) < weld_distance;
+
+	if (overlap)
+	{
+		cut(e1, b.start);
+		cut(e1, b.stop);
+		cut(e2, a.start);
+		cut(e2, a.stop);
+	}
+}
+
+int CurveBoolean::welded(int v)
+{
+	while (_welded[v] != v)
+	{
+		_welded[v] = _welded[_welded[v]];
+		v = _welded[v];
+	}
+	return v;
+}
+
+void CurveBoolean::weld()
+{
+	_welded.resize(_vertices.size());
+	std::vector<int> order(_vertices.size());
+	for (int i = 0; i < _vertices.size(); i++)
+		_welded[i] = order[i] = i;
+
+	std::sort(order.begin(), order.end(), [this](int a, int b) { return _vertices[a].x < _vertices[b].x; });
+
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		geometry::rvec2& p = _vertices[order[i]];
+		for (size_t j = i + 1; j < order.size() && _vertices[order[j]].x - p.x < weld_distance; j++)
+		{
+			if (glm::abs(_vertices[order[j]].y - p.y) < weld_distance)
+			{
+				int a = welded(order[i]), b = welded(order[j]);
+				// the smaller index is kept, curve vertices come before crossings
+				if (a < b)
+					_welded[b] = a;
+				else if (b < a)
+					_welded[a] = b;
+			}
+		}
+	}
+
+	for (int i = 0; i < _welded.size(); i++)
+		welded(i);
+}
+
+int CurveBoolean::winding(Source& s, geometry::rvec2 p)
+{
+	int count = 0;
+
+	// edges crossing the half line starting at p to the right, upward +1 and downward -1, edges ends are taken on their upper side only
+	geometry::rectangle ray(p.x, p.y + weld_distance, s.bounds.right() + weld_distance, p.y - weld_distance);
+	s.tree.visit(ray, [this, &s, &p, &count](int i) {
+		Edge& e = _edges[s.first + i];
+		if (!e.arc)
+		{
+			if ((e.start.y > p.y) != (e.stop.y > p.y))
+			{
+				geometry::real x = e.start.x + (p.y - e.start.y) * (e.stop.x - e.start.x) / (e.stop.y - e.start.y);
+				if (x > p.x)
+					count += e.stop.y > e.start.y ? 1 : -1;
+			}
+			return true;
+		}
+
+		// arcs are split at their top and bottom, each piece crosses the line at most once
+		geometry::real dy = p.y - e.center.y;
+		geometry::real dx = std::sqrt(glm::max(geometry::real(0), e.radius * e.radius - dy * dy));
+		geometry::real a0 = std::atan2(e.start.y - e.center.y, e.start.x - e.center.x);
+
+		geometry::real cuts[4];
+		int n = 0;
+		cuts[n++] = 0;
+		for (geometry::real extreme : { glm::half_pi<geometry::real>(), glm::three_over_two_pi<geometry::real>() })
+		{
+			geometry::real t = e.cw ? normalize(a0 - extreme) : normalize(extreme - a0);
+			if (t > 0 && t < e.sweep)
+				cuts[n++] = t;
+		}
+		std::sort(cuts + 1, cuts + n);
+		cuts[n++] = e.sweep;
+
+		for (int j = 0; j + 1 < n; j++)
+		{
+			geometry::real ya = point(e, cuts[j]).y;
+			geometry::real yb = point(e, cuts[j + 1]).y;
+			if ((ya > p.y) != (yb > p.y))
+			{
+				geometry::real m = a0 + (e.cw ? -1 : 1) * (cuts[j] + cuts[j + 1]) / 2;
+				geometry::real x = e.center.x + (std::cos(m) >= 0 ? dx : -dx);
+				if (x > p.x)
+					count += yb > ya ? 1 : -1;
+			}
+		}
+		return true;
+		});
+
+	return count;
+}
+
+bool CurveBoolean::filled(geometry::rvec2 p)
+{
+	bool added = false;
+	for (Source& s : _sources)
+	{
+		if (s.fill == Fill::add && s.bounds.contains(p) && winding(s, p) * s.sign > 0)
+		{
+			added = true;
+			break;
+		}
+	}
+	if (!added)
+		return false;
+
+	for (Source& s : _sources)
+		if (s.fill == Fill::subtract && s.bounds.contains(p) && winding(s, p) * s.sign > 0)
+			return false;
+
+	return true;
+}
+
+void CurveBoolean::add(Curve& c, Fill fill)
+{
+	Source s;
+	s.fill = fill;
+	s.first = (int)_edges.size();
+
+	for (size_t i = 0; i < c.size(); i++)
+	{
+		Segment& segment = c[i];
+		geometry::rvec2 dst = i + 1 < c.size() ? c[i + 1].point : c[0].point;
+		bool loop = geometry::distance(segment.point, dst) < weld_distance;
+
+		// a circle is cut in two half arcs, an arc back to its start is a circle only if it is alone, otherwise it is a null arc
+		if (segment.type == SegmentType::Circle || (segment.type == SegmentType::Arc && loop && c.size() <= 2))
+		{
+			geometry::real radius = geometry::distance(segment.point, segment.center);
+			geometry::rvec2 opposite = segment.center + segment.center - segment.point;
+			add_edge(segment.point, segment.center, opposite, radius, segment.cw, glm::pi<geometry::real>());
+			add_edge(opposite, segment.center, segment.point, radius, segment.cw, glm::pi<geometry::real>());
+			break;
+		}
+
+		if (loop)
+			continue;
+
+		if (segment.type == SegmentType::Arc)
+			add_edge(segment.point, segment.center, dst, geometry::distance(segment.point, segment.center), segment.cw, geometry::oriented_angle(segment.point, dst, segment.center, segment.cw));
+		else
+			add_edge(segment.point, dst);
+	}
+
+	s.count = (int)_edges.size() - s.first;
+	if (s.count < 2)
+	{
+		_edges.resize(s.first);
+		return;
+	}
+
+	// consecutive edges share their vertex, the direction comes from the signed area, chords and arc caps
+	std::vector<geometry::rectangle> boxes;
+	boxes.reserve(s.count);
+	geometry::real area = 0;
+	for (int i = s.first; i < s.first + s.count; i++)
+		_edges[i].first = vertex(_edges[i].start);
+	for (int i = s.first; i < s.first + s.count; i++)
+	{
+		Edge& e = _edges[i];
+		e.last = _edges[s.first + (i - s.first + 1) % s.count].first;
+		area += cross(e.start, e.stop) / 2;
+		if (e.arc)
+			area += (e.cw ? -1 : 1) * e.radius * e.radius * (e.sweep - std::sin(e.sweep)) / 2;
+
+		if (e.arc)
+			boxes.push_back(geometry::arc_bounds(e.start, e.center, e.stop, e.radius, e.cw));
+		else
+			boxes.push_back(geometry::rectangle(glm::min(e.start.x, e.stop.x), glm::max(e.start.y, e.stop.y), glm::max(e.start.x, e.stop.x), glm::min(e.start.y, e.stop.y)));
+
+		if (i == s.first)
+			s.bounds = boxes.back();
+		else
+		{
+			s.bounds.top_left.x = glm::min(s.bounds.top_left.x, boxes.back().top_left.x);
+			s.bounds.top_left.y = glm::max(s.bounds.top_left.y, boxes.back().top_left.y);
+			s.bounds.bottom_right.x = glm::max(s.bounds.bottom_right.x, boxes.back().bottom_right.x);
+			s.bounds.bottom_right.y = glm::min(s.bounds.bottom_right.y, boxes.back().bottom_right.y);
+		}
+	}
+	s.sign = area < 0 ? -1 : 1;
+	s.tree.create(boxes, [](geometry::rectangle& r) { return r; });
+
+	_sources.push_back(s);
+}
+
+void CurveBoolean::clear()
+{
+	_edges.clear();
+	_sources.clear();
+	_vertices.clear();
+	_welded.clear();
+}
+
+bool CurveBoolean::classify(Piece& p)
+{
+	Edge& e = _edges[p.edge];
+	p.first = welded(p.first);
+	p.last = welded(p.last);
+	if (length(e, p.from, p.to) < weld_distance)
+		return false;
+
+	geometry::real t = (p.from + p.to) / 2;
+	geometry::rvec2 m = point(e, t);
+	geometry::rvec2 d = tangent(e, t);
+	geometry::rvec2 n(-d.y, d.x);
+
+	bool left = filled(m + n * side_distance);
+	bool right = filled(m - n * side_distance);
+	if (left == right)
+		return false;
+
+	if (right)
+	{
+		std::swap(p.first, p.last);
+		p.reversed = true;
+	}
+	return true;
+}
+
+Curve CurveBoolean::curve(std::vector<Piece>& pieces, std::vector<int>& path, bool cw)
+{
+	// pieces have the result on their left : outer curves are counter clockwise, holes are clockwise
+	if (cw)
+		std::reverse(path.begin(), path.end());
+
+	Curve c;
+	for (int p : path)
+	{
+		Piece& piece = pieces[p];
+		Edge& e = _edges[piece.edge];
+		geometry::rvec2 start = _vertices[cw ? piece.last : piece.first];
+		if (e.arc)
+			c.add(SegmentType::Arc, start, e.center, e.radius, (e.cw != piece.reversed) != cw);
+		else
+			c.add(start);
+	}
+	c.close();
+	c.reset_bounds();
+	return c;
+}
+
+std::vector<Curve> CurveBoolean::compute(bool cw)
+{
+	std::vector<Curve> result;
+
+	if (_sources.size() == 0)
+		return result;
+
+	// crossings between all the edges in one sweep, self crossings of a curve included as offsets may overlap themselves
+	SweepLine line;
+	for (int i = 0; i < _edges.size(); i++)
+	{
+		Edge& e = _edges[i];
+		Segment s = e.arc ? Segment(e.start, e.center, e.radius, e.cw) : Segment(e.start);
+		line.add(s, e.stop, i);
+	}
+
+	// work containers are allocated from the arena
+	std::pmr::vector<std::pair<int, int>> pairs(Arena::resource());
+	line.pairs(pairs);
+	Stats::add(Stats::candidates, pairs.size());
+
+	for (auto& pair : pairs)
+		intersect(pair.first, pair.second);
+
+	weld();
+
+	// edges are split at their crossings
+	std::vector<Piece> pieces;
+	std::pmr::vector<int> first_piece(_edges.size() + 1, Arena::resource());
+	for (int i = 0; i < _edges.size(); i++)
+	{
+		Edge& e = _edges[i];
+		std::sort(e.cuts.begin(), e.cuts.end());
+		first_piece[i] = (int)pieces.size();
+
+		Piece p;
+		p.edge = i;
+		p.from = 0;
+		p.first = e.first;
+		for (auto& cut : e.cuts)
+		{
+			p.to = cut.first;
+			p.last = cut.second;
+			pieces.push_back(p);
+			p.from = cut.first;
+			p.first = cut.second;
+		}
+		p.to = e.arc ? e.sweep : 1;
+		p.last = e.last;
+		pieces.push_back(p);
+	}
+	first_piece[_edges.size()] = (int)pieces.size();
+
+	// a curve that is not cut and shares no vertex with an other curve is kept or dropped as a whole
+	std::pmr::vector<int> owner(_vertices.size(), -1, Arena::resource());
+	for (int k = 0; k < _sources.size(); k++)
+	{
+		for (int i = first_piece[_sources[k].first]; i < first_piece[_sources[k].first + _sources[k].count]; i++)
+		{
+			int v = welded(pieces[i].first);
+			owner[v] = owner[v] == -1 || owner[v] == k ? k : -2;
+		}
+	}
+
+	std::vector<Piece> kept;
+	std::vector<std::vector<int>> paths;
+	for (int k = 0; k < _sources.size(); k++)
+	{
+		Source& s = _sources[k];
+		int begin = first_piece[s.first];
+		int end = first_piece[s.first + s.count];
+
+		bool isolated = end - begin == s.count;
+		for (int i = begin; i < end && isolated; i++)
+			isolated = owner[welded(pieces[i].first)] == k;
+
+		if (!isolated)
+		{
+			for (int i = begin; i < end; i++)
+				if (classify(pieces[i]))
+					kept.push_back(pieces[i]);
+			continue;
+		}
+
+		int i = begin;
+		while (i < end && length(_edges[pieces[i].edge], pieces[i].from, pieces[i].to) < weld_distance)
+			i++;
+		if (i == end)
+			continue;
+
+		// a copy is classified, the pieces are all oriented below
+		Piece probe = pieces[i];
+		if (!classify(probe))
+			continue;
+
+		bool reversed = probe.reversed;
+		std::vector<int> path;
+		for (i = begin; i < end; i++)
+		{
+			Piece& p = pieces[i];
+			if (length(_edges[p.edge], p.from, p.to) < weld_distance)
+				continue;
+			p.first = welded(p.first);
+			p.last = welded(p.last);
+			if (reversed)
+				std::swap(p.first, p.last);
+			p.reversed = reversed;
+			p.used = true;
+			path.push_back((int)kept.size());
+			kept.push_back(p);
+		}
+		if (reversed)
+			std::reverse(path.begin(), path.end());
+		paths.push_back(path);
+	}
+
+	// overlapping edges give the same piece twice
+	std::pmr::vector<int> order(kept.size(), Arena::resource());
+	for (int i = 0; i < kept.size(); i++)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&kept](int a, int b) {
+		return kept[a].first < kept[b].first || (kept[a].first == kept[b].first && kept[a].last < kept[b].last);
+		});
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		Piece& a = kept[order[i]];
+		Edge& ea = _edges[a.edge];
+		for (size_t j = i + 1; j < order.size() && kept[order[j]].first == a.first && kept[order[j]].last == a.last; j++)
+		{
+			Piece& b = kept[order[j]];
+			Edge& eb = _edges[b.edge];
+			if (b.used || ea.arc != eb.arc)
+				continue;
+			if (!ea.arc || ((ea.cw != a.reversed) == (eb.cw != b.reversed) && geometry::distance(ea.center, eb.center) < weld_distance))
+				b.used = true;
+		}
+	}
+
+	// kept pieces are linked into closed curves, at a vertex with several choices the sharpest left turn keeps the result on the left
+	std::pmr::vector<std::pmr::vector<int>> outgoing(_vertices.size(), Arena::resource());
+	for (int i = 0; i < kept.size(); i++)
+		if (!kept[i].used)
+			outgoing[kept[i].first].push_back(i);
+
+	auto start_tangent = [this, &kept](int i) {
+		Piece& p = kept[i];
+		return p.reversed ? -tangent(_edges[p.edge], p.to) : tangent(_edges[p.edge], p.from);
+		};
+	auto stop_tangent = [this, &kept](int i) {
+		Piece& p = kept[i];
+		return p.reversed ? -tangent(_edges[p.edge], p.from) : tangent(_edges[p.edge], p.to);
+		};
+
+	for (int i = 0; i < kept.size(); i++)
+	{
+		if (kept[i].used)
+			continue;
+
+		std::vector<int> path;
+		path.push_back(i);
+		kept[i].used = true;
+
+		bool closed = false;
+		int current = i;
+		while (true)
+		{
+			int v = kept[current].last;
+			if (v == kept[i].first)
+			{
+				closed = true;
+				break;
+			}
+
+			geometry::rvec2 d = stop_tangent(current);
+			int next = -1;
+			geometry::real turn = 0;
+			for (int candidate : outgoing[v])
+			{
+				if (kept[candidate].used)
+					continue;
+				geometry::rvec2 o = start_tangent(candidate);
+				geometry::real a = std::atan2(cross(d, o), glm::dot(d, o));
+				if (next < 0 || a > turn)
+				{
+					next = candidate;
+					turn = a;
+				}
+			}
+
+			if (next < 0)
+				break;
+			kept[next].used = true;
+			path.push_back(next);
+			current = next;
+		}
+
+		if (closed)
+			paths.push_back(path);
+	}
+
+	for (auto& path : paths)
+	{
+		bool arc = false;
+		for (int p : path)
+			arc |= _edges[kept[p].edge].arc;
+		if (path.size() >= (arc ? 2 : 3))
+			result.push_back(curve(kept, path, cw));
+	}
+
+	return result;
+}
+
+std::vector<Curve> CurveBoolean::unite(std::vector<Curve>& curves, bool cw)
+{
+	CurveBoolean b;
+	for (Curve& c : curves)
+		b.add(c, Fill::add);
+	return b.compute(cw);
+}
@@ -0,0 +1,119 @@
+#pragma once
+#ifndef BOOLEAN_H
+#define BOOLEAN_H
+
+#include <curve.h>
+#include <ftree.h>
+#include <vector>
+#include <utility>
+
+/// <summary>
+/// Boolean operation on any number of closed curves made of lines and arcs, computed at once instead of pair after pair.
+/// Each curve is added with its fill rule, the result is the union of the add curves minus the union of the subtract curves.
+/// All the edges go through one sweep-line to find the crossings, edges are split at the crossings,
+/// a piece is kept when the result is filled on one side of it only, then kept pieces are linked into closed curves.
+/// A point is inside a curve when the curve winds around it in its own direction, so reversed loops left by offsets are empty.
+/// Arcs stay arcs, the direction of the input curves does not matter.
+/// </summary>
+class CurveBoolean
+{
+public:
+	enum class Fill
+	{
+		add,
+		subtract
+	};
+
+private:
+	struct Edge
+	{
+		geometry::rvec2 start;
+		geometry::rvec2 stop;
+		geometry::rvec2 center;
+		geometry::real radius = 0;
+		geometry::real sweep = 0;	// arc angle
+		bool arc = false;
+		bool cw = false;
+		int first = 0;				// start vertex
+		int last = 0;				// stop vertex
+		std::vector<std::pair<geometry::real, int>> cuts;	// position along the edge, vertex
+	};
+
+	struct Source
+	{
+		Fill fill = Fill::add;
+		geometry::rectangle bounds;
+		int first = 0;				// first edge
+		int count = 0;
+		int sign = 1;				// 1 if counter clockwise, -1 if clockwise
+		PackedRTree tree;
+	};
+
+	struct Piece
+	{
+		int edge = 0;
+		geometry::real from = 0;	// position along the edge
+		geometry::real to = 0;
+		int first = 0;				// vertices, welded
+		int last = 0;
+		bool reversed = false;
+		bool used = false;
+	};
+
+	std::vector<Edge> _edges;
+	std::vector<Source> _sources;
+	std::vector<geometry::rvec2> _vertices;
+	std::vector<int> _welded;
+
+	int vertex(geometry::rvec2 p);
+	void add_edge(geometry::rvec2 start, geometry::rvec2 stop);
+	void add_edge(geometry::rvec2 start, geometry::rvec2 center, geometry::rvec2 stop, geometry::real radius, bool cw, geometry::real sweep);
+
+	/// <summary>
+	/// Position of p along edge e : parameter in [0;1] for a line, angle from start for an arc
+	/// </summary>
+	geometry::real position(Edge& e, geometry::rvec2 p);
+	geometry::rvec2 point(Edge& e, geometry::real t);
+	geometry::rvec2 tangent(Edge& e, geometry::real t);
+	geometry::real length(Edge& e, geometry::real from, geometry::real to);
+
+	void cut(int edge, geometry::rvec2 p);
+	void intersect(int e1, int e2);
+	void weld();
+	int welded(int v);
+
+	/// <summary>
+	/// Winding number of source s around p, a point is inside the source if it turns around p in the direction of the source
+	/// </summary>
+	int winding(Source& s, geometry::rvec2 p);
+	bool filled(geometry::rvec2 p);
+
+	/// <summary>
+	/// Return true if the result is filled on one side of piece p only, p is then directed to have the result on its left
+	/// </summary>
+	bool classify(Piece& p);
+	Curve curve(std::vector<Piece>& pieces, std::vector<int>& path, bool cw);
+
+public:
+	/// <summary>
+	/// Add a closed curve with its fill rule
+	/// </summary>
+	void add(Curve& c, Fill fill);
+
+	/// <summary>
+	/// Remove all curves
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Return the boundary curves of the result, outer curves in cw direction and holes in the opposite direction
+	/// </summary>
+	std::vector<Curve> compute(bool cw);
+
+	/// <summary>
+	/// Return the union of curves, outer curves in cw direction and holes in the opposite direction
+	/// </summary>
+	static std::vector<Curve> unite(std::vector<Curve>& curves, bool cw);
+};
+
+#endif
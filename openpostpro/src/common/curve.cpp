@@ -2,20 +2,55 @@
 #include <geometry.h>
 #include <map>
 #include <algorithm>
+#include <iterator>
 #include <deque>
 #include <iostream>
 #include <logger.h>
 #include <ftree.h>
+#include <sweep.h>
+#include <stats.h>
+#include <arena.h>
+#include <offsetcache.h>
 
+Curve::Curve(const Curve& c) : std::vector<Segment>(c),
+	_length(c._length), _area(c._area), _cw(c._cw), _bounds(c._bounds), _sorted(c._sorted), _tree(c._tree), _view(c._view),
+	_tag(c._tag), _reference(c._reference), _index(c._index), _level(c._level), _tag_inside(c._tag_inside),
+	intersection_points(c.intersection_points)
+{
+	Stats::add(Stats::copies);
+}
 
-Segment::Segment(glm::vec2 point, int tag)
+Curve& Curve::operator=(const Curve& c)
+{
+	if (this == &c)
+		return *this;
+
+	std::vector<Segment>::operator=(c);
+	_length = c._length;
+	_area = c._area;
+	_cw = c._cw;
+	_bounds = c._bounds;
+	_sorted = c._sorted;
+	_tree = c._tree;
+	_view = c._view;
+	_tag = c._tag;
+	_reference = c._reference;
+	_index = c._index;
+	_level = c._level;
+	_tag_inside = c._tag_inside;
+	intersection_points = c.intersection_points;
+	Stats::add(Stats::copies);
+	return *this;
+}
+
+Segment::Segment(geometry::rvec2 point, int tag)
 {
 	this->point = point;
 	this->type = SegmentType::Line;
 	this->tag = tag;
 }
 
-Segment::Segment(glm::vec2 point, glm::vec2 center, float radius, bool cw, SegmentType type, int tag, bool excluded)
+Segment::Segment(geometry::rvec2 point, geometry::rvec2 center, geometry::real radius, bool cw, SegmentType type, int tag, bool excluded)
 {
 	this->point = point;
 	this->center = center;
@@ -25,11 +60,11 @@ Segment::Segment(glm::vec2 point, glm::vec2 center, float radius, bool cw, Segme
 	this->tag = tag;
 	this->excluded = excluded;
 #ifdef _DEBUG
-	this->perimeter = glm::two_pi<float>() * radius;
+	this->perimeter = glm::two_pi<geometry::real>() * radius;
 #endif
 }
 
-int Segment::intersect(glm::vec2 dst1, Segment s2, glm::vec2 dst2, glm::vec2 result[2])
+int Segment::intersect(geometry::rvec2 dst1, const Segment& s2, geometry::rvec2 dst2, geometry::rvec2 result[2])
 {
 	Segment& s1 = *this;
 
@@ -72,12 +107,12 @@ int Segment::intersect(glm::vec2 dst1, Segment s2, glm::vec2 dst2, glm::vec2 res
 	return 0;
 }
 
-glm::vec2 Segment::coordinates_at(float length, glm::vec2 dst)
+geometry::rvec2 Segment::coordinates_at(geometry::real length, geometry::rvec2 dst)
 {
 	if (length == 0)
 		return point;
 
-	float a = 0, a1 = 0;
+	geometry::real a = 0, a1 = 0;
 
 	switch (type)
 	{
@@ -90,16 +125,16 @@ glm::vec2 Segment::coordinates_at(float length, glm::vec2 dst)
 			a = geometry::oriented_angle(a1 - a);
 		else
 			a = geometry::oriented_angle(a1 + a);
-		return glm::vec2(glm::cos(a), glm::sin(a)) + center;
+		return geometry::rvec2(glm::cos(a), glm::sin(a)) + center;
 	case SegmentType::Circle:
 		a = length / radius;
-		return glm::vec2(glm::cos(a), glm::sin(a)) + center;
+		return geometry::rvec2(glm::cos(a), glm::sin(a)) + center;
 	}
 
-	return glm::vec2();
+	return geometry::rvec2();
 }
 
-std::vector<Segment> Segment::split_at(float length, glm::vec2 dst)
+std::vector<Segment> Segment::split_at(geometry::real length, geometry::rvec2 dst)
 {
 	std::vector<Segment> result;
 	switch (type)
@@ -146,8 +181,6 @@ bool compare_curve_level(Curve& v1, Curve& v2)
 }
 
 
-int Curve::counter[10];
-
 int Curve::tag()
 {
 	return _tag;
@@ -206,18 +239,18 @@ geometry::rectangle& Curve::bounds()
 		if ((*this)[0].type == SegmentType::Circle )
 		{
 			Segment s = (*this)[0];
-			s.bounds.top_left = glm::vec2(s.center.x - s.radius, s.center.y + s.radius);
-			s.bounds.bottom_right = glm::vec2(s.center.x + s.radius, s.center.y - s.radius);
+			s.bounds.top_left = geometry::rvec2(s.center.x - s.radius, s.center.y + s.radius);
+			s.bounds.bottom_right = geometry::rvec2(s.center.x + s.radius, s.center.y - s.radius);
 
 			_bounds.top_left = s.bounds.top_left;
 			_bounds.bottom_right = s.bounds.bottom_right;
 		}
 		else
 		{
-			_bounds.top_left.x = std::numeric_limits<float>::max();
-			_bounds.top_left.y = -std::numeric_limits<float>::max();
-			_bounds.bottom_right.x = -std::numeric_limits<float>::max();
-			_bounds.bottom_right.y = std::numeric_limits<float>::max();
+			_bounds.top_left.x = std::numeric_limits<geometry::real>::max();
+			_bounds.top_left.y = -std::numeric_limits<geometry::real>::max();
+			_bounds.bottom_right.x = -std::numeric_limits<geometry::real>::max();
+			_bounds.bottom_right.y = std::numeric_limits<geometry::real>::max();
 
 
 			for (int i = 0; i < size(); i++)
@@ -236,8 +269,8 @@ geometry::rectangle& Curve::bounds()
 				{
 					if (s1.point == s2.point) // same as circle
 					{
-						s1.bounds.top_left = glm::vec2(s1.center.x - s1.radius, s1.center.y + s1.radius);
-						s1.bounds.bottom_right = glm::vec2(s1.center.x + s1.radius, s1.center.y - s1.radius);
+						s1.bounds.top_left = geometry::rvec2(s1.center.x - s1.radius, s1.center.y + s1.radius);
+						s1.bounds.bottom_right = geometry::rvec2(s1.center.x + s1.radius, s1.center.y - s1.radius);
 
 						_bounds.top_left = s1.bounds.top_left;
 						_bounds.bottom_right = s1.bounds.bottom_right;
@@ -274,11 +307,27 @@ void Curve::reset_bounds()
 	_length = -1;
 
 	_tree.reset();
+	_view.reset();
 
 	_cw = -1;
 }
 
-void Curve::add(glm::vec2 point)
+void Curve::prepare()
+{
+	std::lock_guard<std::mutex> lock(_lock.mutex);
+
+	if (size() == 0)
+		return;
+
+	bounds();
+	length();
+	cw();
+	tree();
+	if (!view().middles())
+		_view.middles(*this);
+}
+
+void Curve::add(geometry::rvec2 point)
 {
 	push_back(Segment(point));
 	back().index = (int)size() - 1;
@@ -286,7 +335,7 @@ void Curve::add(glm::vec2 point)
 	_cw = -1;
 }
 
-void Curve::add(glm::vec2 point, glm::vec2 center, float radius, bool cw)
+void Curve::add(geometry::rvec2 point, geometry::rvec2 center, geometry::real radius, bool cw)
 {
 	push_back(Segment(point, center, radius, cw, SegmentType::Arc));
 	back().index = (int)size() - 1;
@@ -294,9 +343,9 @@ void Curve::add(glm::vec2 point, glm::vec2 center, float radius, bool cw)
 	_cw = -1;
 }
 
-void Curve::add(glm::vec2 center, float radius, bool cw)
+void Curve::add(geometry::rvec2 center, geometry::real radius, bool cw)
 {
-	glm::vec2 point = geometry::position(0, radius) + center;
+	geometry::rvec2 point = geometry::position(0, radius) + center;
 	push_back(Segment(point, center, radius, cw, SegmentType::Circle));
 	back().index = (int)size() - 1;
 	push_back(Segment(point));
@@ -305,7 +354,7 @@ void Curve::add(glm::vec2 center, float radius, bool cw)
 	_cw = -1;
 }
 
-void Curve::add(SegmentType type, glm::vec2 point, glm::vec2 center, float radius, bool cw)
+void Curve::add(SegmentType type, geometry::rvec2 point, geometry::rvec2 center, geometry::real radius, bool cw)
 {
 	push_back(Segment(point, center, radius, cw, type));
 	back().index = (int)size() - 1;
@@ -318,18 +367,18 @@ void Curve::add(Segment& s)
 	add(s.type, s.point, s.center, s.radius, s.cw);
 }
 
-glm::vec2 Curve::first()
+geometry::rvec2 Curve::first()
 {
 	if (size() > 0)
 		return (*this)[0].point;
-	return glm::vec2();
+	return geometry::rvec2();
 }
 
-glm::vec2 Curve::last()
+geometry::rvec2 Curve::last()
 {
 	if (size() > 1)
 		return (*this).back().point;
-	return glm::vec2();
+	return geometry::rvec2();
 }
 
 void Curve::reverse()
@@ -367,7 +416,7 @@ void Curve::reverse()
 			(*this)[i].radius = (*this)[i + 1].radius;
 			(*this)[i].cw = !(*this)[i + 1].cw;
 #ifdef _DEBUG
-			(*this)[i].perimeter = (*this)[i + 1].radius * glm::two_pi<float>();
+			(*this)[i].perimeter = (*this)[i + 1].radius * glm::two_pi<geometry::real>();
 #endif
 		}
 		(*this)[size() - 1].type = s.type;
@@ -408,7 +457,7 @@ bool Curve::cw()
 			if ((*this)[0].type == SegmentType::Line)
 			{
 				auto angle = geometry::angle((*this)[1].point, (*this)[0].point);
-				_cw = angle < glm::pi<float>() && angle >= 0;
+				_cw = angle < glm::pi<geometry::real>() && angle >= 0;
 			}
 			else
 				_cw = (*this)[0].cw;
@@ -432,14 +481,14 @@ void Curve::cw(bool direction)
 		reverse();
 }
 
-float Curve::length()
+geometry::real Curve::length()
 {
 	if (_length != -1)
 		return _length;
 
 	std::vector<Segment>::iterator from = begin();
 	std::vector<Segment>::iterator it = begin() + 1;
-	float angle = 0;
+	geometry::real angle = 0;
 
 	_length = 0;
 
@@ -452,7 +501,7 @@ float Curve::length()
 			_length += (*from).length; // geometry::distance((*it).ref_point, from.ref_point);
 			break;
 		case SegmentType::Circle:
-			(*from).length = _length = (*from).radius * glm::two_pi<float>();
+			(*from).length = _length = (*from).radius * glm::two_pi<geometry::real>();
 			break;
 		case SegmentType::Arc:
 			angle = geometry::oriented_angle((*from).point, (*it).point, (*from).center, (*from).cw);
@@ -488,14 +537,14 @@ float Curve::length()
 	return _length;
 }
 
-float Curve::area()
+geometry::real Curve::area()
 {
 	if (_area == -1) {
 
-		std::vector<glm::vec2> points;
+		std::vector<geometry::rvec2> points;
 
 		if (size() == 1 && (*this)[0].type == SegmentType::Circle)
-			return _area = (*this)[0].radius * glm::two_pi<float>();
+			return _area = (*this)[0].radius * glm::two_pi<geometry::real>();
 
 		Segment from = front();
 		auto it = begin() + 1;
@@ -521,7 +570,7 @@ float Curve::area()
 			points.push_back(front().point);
 
 		_area = 0;
-		glm::vec2 f = points.front();
+		geometry::rvec2 f = points.front();
 		auto pit = points.begin() + 1;
 		while (pit != points.end())
 		{
@@ -536,12 +585,12 @@ float Curve::area()
 }
 
 
-float Curve::limited_area()
+geometry::real Curve::limited_area()
 {
-	std::vector<glm::vec2> points;
+	std::vector<geometry::rvec2> points;
 
 	if (size() == 1 && (*this)[0].type == SegmentType::Circle)
-		return _area = (*this)[0].radius * glm::two_pi<float>();
+		return _area = (*this)[0].radius * glm::two_pi<geometry::real>();
 
 	Segment from = front();
 	auto it = begin() + 1;
@@ -558,8 +607,8 @@ float Curve::limited_area()
 	if (front().point != back().point)
 		points.push_back(front().point);
 
-	float area = 0;
-	glm::vec2 f = points.front();
+	geometry::real area = 0;
+	geometry::rvec2 f = points.front();
 	auto pit = points.begin() + 1;
 	while (pit != points.end())
 	{
@@ -570,7 +619,7 @@ float Curve::limited_area()
 	return area;
 }
 
-bool Curve::inside(glm::vec2 p)
+bool Curve::inside(geometry::rvec2 p)
 {
 	if (size() == 2)
 	{
@@ -585,81 +634,14 @@ bool Curve::inside(glm::vec2 p)
 		}
 	}
 
-	std::vector<glm::vec2> points;
-	auto it = begin();
-	glm::vec2 dst = (*it).point;
+	// the outline with arcs as points is built on the first query, the slab index on the second one
+	CurveView& v = view();
+	if (!v.outlined())
+		v.outline(*this);
+	else if (!v.indexed())
+		v.index();
 
-	while (it != end())
-	{
-		if ((*it).type == SegmentType::Line)
-		{
-			points.push_back((*it).point);
-		}
-		else
-		{
-			auto dst = (it == end() - 1) ? front().point : (*(it + 1)).point;
-			auto arc = geometry::arc((*it).point, (*it).center, dst, (*it).cw);
-			points.insert(points.end(), arc.begin(), arc.end());
-		}
-		it++;
-	}
-	
-	bool inside = false;
-
-	//int e = 0; // points.front() == points.back() ? 1 : 0;
-	//auto start_it = begin();
-	//auto end_it = end() - 1;
-
-	//while (start_it != end() - e)
-	//{
-	//	if ((((*start_it).ref_point.y > p.y) != ((*end_it).ref_point.y > p.y)) &&
-	//		(p.x < ((*end_it).ref_point.x - (*start_it).ref_point.x) * (p.y - (*start_it).ref_point.y) / ((*end_it).ref_point.y - (*start_it).ref_point.y) + (*start_it).ref_point.x))
-	//		inside = !inside;
-	//	end_it = start_it;
-	//	start_it++;
-	//}
-
-	int count = (int)(points.front() == points.back() ? points.size() - 1 : points.size());
-	glm::vec2 p1 = points.front(), p2;
-
-	for (int i = 1; i <= count; i++) {
-		// Get the next ref_point in the polygon
-		p2 = points[i % count];
-
-		// Check if the ref_point is above the minimum y
-		// coordinate of the edge
-		if (p.y > glm::min(p1.y, p2.y)) {
-			// Check if the ref_point is below the maximum y
-			// coordinate of the edge
-			if (p.y <= glm::max(p1.y, p2.y)) {
-				// Check if the ref_point is to the left of the
-				// maximum x coordinate of the edge
-				if (p.x <= glm::max(p1.x, p2.x)) {
-					// Calculate the x-intersection of the
-					// line connecting the ref_point to the edge
-					double x_intersection
-						= (p.y - p1.y) * (p2.x - p1.x)
-						/ (p2.y - p1.y)
-						+ p1.x;
-
-					// Check if the ref_point is on the same
-					// line as the edge or to the left of
-					// the x-intersection
-					if (p1.x == p2.x
-						|| p.x <= x_intersection) {
-						// Flip the inside flag
-						inside = !inside;
-					}
-				}
-			}
-		}
-
-		// Store the current ref_point as the first ref_point for
-		// the next iteration
-		p1 = p2;
-	}
-
-	return inside;
+	return v.inside(p);
 }
 
 bool Curve::inside(Curve& b)
@@ -670,23 +652,27 @@ bool Curve::inside(Curve& b)
 	// we check for first ref_point, if it is inside, then we look for an intersection
 	if (b.inside((*this)[0].point))
 	{
-		// we test smaller against bigger
-		Curve& a = *this, c = b;
+		// we test smaller against bigger, b is not copied to keep its spatial index and view
+		Curve& a = *this;
+		Curve& c = b;
 
+		std::vector<int> candidates;
 		auto i1 = a.begin();
 		while (i1 != a.end())
 		{
 			auto s1 = *i1;
 			auto dst1 = (i1 == a.end() - 1) ? a.front().point : (*(i1+1)).point;
-			auto candidates = c.search(s1.bounds);
+			candidates.clear();
+			c.search(s1.bounds, std::back_inserter(candidates));
 
 			auto i2 = candidates.begin();
 			while (i2 != candidates.end())
 			{
-				auto s2 = *i2;
-				auto dst2 = ((*i2).index == c.size() - 1) ? c.front().point : c[(*i2).index+1].point;
+				auto& s2 = c[*i2];
+				auto dst2 = (*i2 == c.size() - 1) ? c.front().point : c[*i2 + 1].point;
 
-				glm::vec2 result[2];
+				geometry::rvec2 result[2];
+				Stats::add(Stats::intersection_tests);
 				if (s1.intersect(dst1, s2, dst2, result) > 0)
 					return false;
 				i2 = i2 + 1;
@@ -709,23 +695,27 @@ bool Curve::outside(Curve& b)
 	// we check for first ref_point, if it is inside, then we look for an intersection
 	if (!b.inside((*this)[0].point))
 	{
-		// we test smaller against bigger
-		Curve& a = *this, c = b;
+		// we test smaller against bigger, b is not copied to keep its spatial index and view
+		Curve& a = *this;
+		Curve& c = b;
 
+		std::vector<int> candidates;
 		auto i1 = a.begin();
 		while (i1 != a.end())
 		{
 			auto s1 = *i1;
 			auto dst1 = (i1 == a.end() - 1) ? a.front().point : (*(i1 + 1)).point;
-			auto candidates = c.search(s1.bounds);
+			candidates.clear();
+			c.search(s1.bounds, std::back_inserter(candidates));
 
 			auto i2 = candidates.begin();
 			while (i2 != candidates.end())
 			{
-				auto s2 = *i2;
-				auto dst2 = ((*i2).index == c.size() - 1) ? c.front().point : c[(*i2).index + 1].point;
+				auto& s2 = c[*i2];
+				auto dst2 = (*i2 == c.size() - 1) ? c.front().point : c[*i2 + 1].point;
 
-				glm::vec2 result[2];
+				geometry::rvec2 result[2];
+				Stats::add(Stats::intersection_tests);
 				if (s1.intersect(dst1, s2, dst2, result) > 0)
 					return false;
 				i2 = i2 + 1;
@@ -745,24 +735,27 @@ Position Curve::relative(Curve& b)
 	if (bounds().outside(b.bounds()))
 		return Position::outside;
 
-	auto c1 = *this;
-	auto c2 = b;
+	Curve& c1 = *this;
+	Curve& c2 = b;
 
 	// we check for first ref_point, if it is inside, then we look for an intersection
+	std::vector<int> candidates;
 	auto i1 = c1.begin();
 	while (i1 != c1.end())
 	{
 		auto s1 = *i1;
 		auto dst1 = (i1 == c1.end() - 1) ? c1.front().point : (*(i1 + 1)).point;
-		auto candidates = c2.search(s1.bounds);
+		candidates.clear();
+		c2.search(s1.bounds, std::back_inserter(candidates));
 
 		auto i2 = candidates.begin();
 		while (i2 != candidates.end())
 		{
-			auto s2 = *i2;
-			auto dst2 = ((*i2).index == c2.size() - 1) ? c2.front().point : c2[(*i2).index + 1].point;
+			auto& s2 = c2[*i2];
+			auto dst2 = (*i2 == c2.size() - 1) ? c2.front().point : c2[*i2 + 1].point;
 
-			glm::vec2 result[2];
+			geometry::rvec2 result[2];
+			Stats::add(Stats::intersection_tests);
 			if (s1.intersect(dst1, s2, dst2, result) > 0)
 				return Position::intersect;
 			i2 = i2 + 1;
@@ -780,20 +773,23 @@ bool Curve::intersect(Curve& b)
 		return false;
 
 	// we check for first ref_point, if it is inside, then we look for an intersection
+	std::vector<int> candidates;
 	auto i1 = begin();
 	while (i1 != end())
 	{
 		auto s1 = *i1;
 		auto dst1 = (i1 == end() - 1) ? front().point : (*(i1 + 1)).point;
-		auto candidates = b.search(s1.bounds);
+		candidates.clear();
+		b.search(s1.bounds, std::back_inserter(candidates));
 
 		auto i2 = candidates.begin();
 		while (i2 != candidates.end())
 		{
-			auto s2 = *i2;
-			auto dst2 = ((*i2).index == b.size() - 1) ? b.front().point : b[(*i2).index + 1].point;
+			auto& s2 = b[*i2];
+			auto dst2 = (*i2 == b.size() - 1) ? b.front().point : b[*i2 + 1].point;
 
-			glm::vec2 result[2];
+			geometry::rvec2 result[2];
+			Stats::add(Stats::intersection_tests);
 			if (s1.intersect(dst1, s2, dst2, result) > 0)
 				return true;
 			i2 = i2 + 1;
@@ -848,12 +844,12 @@ std::vector<glm::vec2> Curve::coordinates()
 	return points;
 }
 
-std::vector<Curve> Curve::cut(glm::vec2 point, int index)
+std::vector<Curve> Curve::cut(geometry::rvec2 point, int index)
 {
 	return cut(point, begin() + index);
 }
 
-std::vector<Curve> Curve::cut(glm::vec2 point, std::vector<Segment>::iterator it)
+std::vector<Curve> Curve::cut(geometry::rvec2 point, std::vector<Segment>::iterator it)
 {
 	std::vector<Curve> result;
 
@@ -930,7 +926,7 @@ std::vector<Curve> Curve::merge(Curve& b)
 	return result;
 }
 
-void Curve::scale(float factor)
+void Curve::scale(geometry::real factor)
 {
 	for (Segment& s : *this)
 	{
@@ -953,7 +949,26 @@ void Curve::scale(float factor)
 //  3 - split the trimmed curve at intersection points. Indeed the trimmed result can create curve with self intersections.
 //      we need to split the trimmed curve and output a new curve following the intersection points
 //  4 - we have to check and refuse curves that are tout small (size of offset) or curves to close to the original curve
-std::vector<Curve> Curve::offset(float o, float max)
+std::vector<Curve> Curve::offset(geometry::real o, geometry::real max)
+{
+	if (!OffsetCache::enabled())
+		return compute_offset(o, max);
+
+	std::vector<Curve> result;
+	auto key = OffsetCache::key(*this, o, max);
+	if (OffsetCache::find(key, result))
+	{
+		for (Curve& c : result)
+			c.level(_level);
+		return result;
+	}
+
+	result = compute_offset(o, max);
+	OffsetCache::store(key, result);
+	return result;
+}
+
+std::vector<Curve> Curve::compute_offset(geometry::real o, geometry::real max)
 {
 	bool outside = o > 0;
 	std::vector<Curve> result;
@@ -965,7 +980,7 @@ std::vector<Curve> Curve::offset(float o, float max)
 	//	o *= factor;
 	//}
 
-	bounds();
+	prepare();
 
 	if (!outside && (bounds().width() < glm::abs(o) || bounds().height() < glm::abs(o)))
 		return result;
@@ -983,7 +998,7 @@ std::vector<Curve> Curve::offset(float o, float max)
 
 	if (false)
 	{
-		for (Curve c : splitted)
+		for (Curve& c : splitted)
 			result.push_back(c);
 	}
 
@@ -993,7 +1008,7 @@ std::vector<Curve> Curve::offset(float o, float max)
 		c.close();
 		c.reset_bounds();
 	}
-	for (Curve c : splitted)
+	for (Curve& c : splitted)
 	{
 		if (curve_intersect(c))
 		{
@@ -1013,8 +1028,10 @@ std::vector<Curve> Curve::offset(float o, float max)
 				c.tag_inside(outside ? Position::outside : Position::inside);
 				if (max > 0)
 					c.reduce(max);
-				result.push_back(c);
+				result.push_back(std::move(c));
 			}
+			else
+				Stats::add(Stats::offset_rejected);
 		}
 	}
 
@@ -1025,18 +1042,18 @@ std::vector<Curve> Curve::offset(float o, float max)
 	return result;
 }
 
-void Curve::middle(glm::vec2& position, float& angle)
+void Curve::middle(geometry::rvec2& position, geometry::real& angle)
 {
 	if (this->size() > 1)
 	{
 		if ((*this)[0].type == SegmentType::Circle)
 		{
-			position = (*this)[0].center + glm::vec2(-(*this)[0].radius, 0);
-			angle = geometry::oriented_angle((*this)[0].cw ? glm::half_pi<float>() : -glm::half_pi<float>());
+			position = (*this)[0].center + geometry::rvec2(-(*this)[0].radius, 0);
+			angle = geometry::oriented_angle((*this)[0].cw ? glm::half_pi<geometry::real>() : -glm::half_pi<geometry::real>());
 		}
 		else
 		{
-			float pos = length() / 2, len = 0;
+			geometry::real pos = length() / 2, len = 0;
 
 			auto from = (*this).begin();
 			auto to = from + 1;
@@ -1059,11 +1076,11 @@ void Curve::middle(glm::vec2& position, float& angle)
 				}
 				else // arc
 				{
-					float a_r = rest / (*from).radius;
-					float a_s = geometry::oriented_angle((*from).point, (*from).center);
-					float a_d = geometry::oriented_angle((*from).cw ? a_s - a_r : a_s + a_r);
+					geometry::real a_r = rest / (*from).radius;
+					geometry::real a_s = geometry::oriented_angle((*from).point, (*from).center);
+					geometry::real a_d = geometry::oriented_angle((*from).cw ? a_s - a_r : a_s + a_r);
 
-					angle = geometry::oriented_angle((*from).cw ? a_d - glm::half_pi<float>(): a_d + glm::half_pi<float>());
+					angle = geometry::oriented_angle((*from).cw ? a_d - glm::half_pi<geometry::real>(): a_d + glm::half_pi<geometry::real>());
 					position.x = glm::cos(a_d) * (*from).radius + (*from).center.x;
 					position.y = glm::sin(a_d) * (*from).radius + (*from).center.y;
 				}
@@ -1072,72 +1089,168 @@ void Curve::middle(glm::vec2& position, float& angle)
 	}
 }
 
-std::vector<Curve> Curve::split(float length)
+std::vector<Curve> Curve::split(geometry::real length)
 {
 	return std::vector<Curve>();
 }
 
-void Curve::reduce(float max)
+void Curve::reduce(geometry::real max)
 {
 	length();
 
-	auto it = begin();
-	auto from = it;
-	auto to = it;
-	float len = (*from).length;
+	size_t n = size();
+	if (n == 0)
+		return;
 
-	while (it != end())
+	// a short line absorbs the following lines while it stays shorter than max, segments are compacted in place
+	Curve& c = *this;
+	size_t w = 0;
+	for (size_t r = 1; r < n; r++)
+	{
+		if (c[w].length < max && c[w].type == SegmentType::Line && c[r].type == SegmentType::Line)
+			c[w].length = geometry::distance(c[w].point, r + 1 < n ? c[r + 1].point : c[0].point);
+		else
+			c[++w] = c[r];
+	}
+	resize(w + 1);
+
+	reset_bounds();
+}
+
+/// <summary>
+/// Return true if vertices from + 1 to to - 1 are closer than tolerance to the line from vertex from to vertex to
+/// </summary>
+static bool fit_line(Curve& c, size_t from, size_t to, geometry::real tolerance)
+{
+	geometry::rvec2 a = c[from].point, d = c[to].point - a;
+	geometry::real l2 = glm::dot(d, d);
+	for (size_t k = from + 1; k < to; k++)
+	{
+		geometry::rvec2 p = c[k].point - a;
+		geometry::real t = l2 > 0 ? glm::clamp(glm::dot(p, d) / l2, geometry::real(0), geometry::real(1)) : 0;
+		if (glm::length(p - t * d) > tolerance)
+			return false;
+	}
+	return true;
+}
+
+/// <summary>
+/// Return true if the arc going through vertices from, (from + to) / 2 and to is closer than tolerance to all vertices and lines between them.
+/// Vertices must go forward along the arc
+/// </summary>
+static bool fit_arc(Curve& c, size_t from, size_t to, geometry::real tolerance, geometry::rvec2& center, geometry::real& radius, bool& cw)
+{
+	geometry::rvec2 p1 = c[from].point, p2 = c[(from + to) / 2].point, p3 = c[to].point;
+	geometry::rvec2 b = p2 - p1, q = p3 - p1;
+	geometry::real d = 2 * (b.x * q.y - b.y * q.x);
+	if (d == 0)
+		return false;
+
+	geometry::real b2 = glm::dot(b, b), q2 = glm::dot(q, q);
+	center = p1 + geometry::rvec2((q.y * b2 - b.y * q2) / d, (b.x * q2 - q.x * b2) / d);
+	radius = geometry::distance(center, p1);
+	cw = d < 0;
+
+	geometry::real previous = 0;
+	for (size_t k = from + 1; k <= to; k++)
+	{
+		geometry::rvec2 p = c[k].point;
+		if (glm::abs(geometry::distance(center, p) - radius) > tolerance)
+			return false;
+
+		// vertices go forward along the arc, less than one turn
+		geometry::real angle = geometry::oriented_angle(p1, p, center, cw);
+		if (angle <= previous || angle >= glm::two_pi<geometry::real>())
+			return false;
+		previous = angle;
+
+		// the line between two vertices is not farther than tolerance from the arc
+		geometry::real half = geometry::distance(c[k - 1].point, p) / 2;
+		if (half > radius || radius - glm::sqrt(radius * radius - half * half) > tolerance)
+			return false;
+	}
+	return true;
+}
+
+/// <summary>
+/// Return the last vertex to in [from + shortest, last] for which fits(to) is true, from if there is none.
+/// The length is doubled while it fits, then the limit is found by bisection
+/// </summary>
+template<class F> static size_t longest_fit(size_t from, size_t last, size_t shortest, F fits)
+{
+	size_t good = from, bad = last + 1, step = shortest;
+	while (bad == last + 1 && good < last)
 	{
-		if ((*it).length < max)
+		size_t to = glm::min(from + step, last);
+		if (fits(to))
+			good = to;
+		else
+			bad = to;
+		step *= 2;
+	}
+
+	if (good > from)
+	{
+		while (bad - good > 1)
+		{
+			size_t middle = (good + bad) / 2;
+			if (fits(middle))
+				good = middle;
+			else
+				bad = middle;
+		}
+	}
+
+	return good;
+}
+
+void Curve::simplify(geometry::real tolerance)
+{
+	size_t n = size();
+	if (n < 3)
+		return;
+
+	// segments are written over the ones already read, vertices ahead are still the original ones
+	Curve& c = *this;
+	size_t w = 0, s = 0;
+	while (s + 1 < n)
+	{
+		if (c[s].type != SegmentType::Line)
 		{
-			if (it + 1 != end())
+			c[w++] = c[s++];
+			continue;
+		}
+
+		// the run of lines from s stops at vertex last
+		size_t last = s + 1;
+		while (last + 1 < n && c[last].type == SegmentType::Line)
+			last++;
+
+		while (s < last)
+		{
+			geometry::rvec2 center;
+			geometry::real radius = 0;
+			bool cw = false;
+			size_t line = longest_fit(s, last, 1, [&c, s, tolerance](size_t to) { return fit_line(c, s, to, tolerance); });
+			// an arc is kept when it goes farther than a line, nearly straight runs stay lines
+			size_t arc = longest_fit(s, last, 3, [&](size_t to) { return fit_arc(c, s, to, tolerance, center, radius, cw); });
+
+			if (arc > line && fit_arc(c, s, arc, tolerance, center, radius, cw))
 			{
-				if ((*it).type == SegmentType::Line && (*(it + 1)).type == SegmentType::Line)
-				{
-					erase(it + 1);
-					if (it != end() - 1)
-						(*it).length = geometry::distance((*it).point, (*(it + 1)).point);
-					else
-						(*it).length = geometry::distance((*it).point, front().point);
-				}
-				else
-					it++;
+				c[w++] = Segment(c[s].point, center, radius, cw, SegmentType::Arc, c[s].tag);
+				s = arc;
 			}
 			else
 			{
-				/*if ((*it).type == SegmentType::Line && front().type == SegmentType::Line)
-				{
-					erase(begin());
-					(*it).length = geometry::distance((*it).ref_point, (*begin()).ref_point);
-				}
-				else */
-					it++;
+				c[w++] = Segment(c[s].point, c[s].tag);
+				s = line;
 			}
-		} else
-			it++;
+		}
 	}
+	c[w++] = c[n - 1];
+	resize(w);
 
-	//while (it != end())
-	//{
-	//	if (len < max)
-	//	{
-	//		if (len + (*it).length >= max)
-	//		{
-	//			len = (*it).length;
-	//			it = erase(from, to) + 1;
-	//			from = to = it + 1;
-	//		}
-	//		else
-	//		{
-	//			to = it;
-	//			len += (*it).length;
-	//		}
-	//	}
-	//	else
-	//		len = (*it).length;
-	//	it++;
-	//}
-
+	_area = -1;
 	reset_bounds();
 }
 
@@ -1146,12 +1259,13 @@ void Curve::reduce(float max)
 //  - if arc or circle, reduce or increase the radius
 // the process depends of curve direction, clockwise or counter-clockwise
 
-std::vector<SegmentUntrim> Curve::untrim(float o)
+std::vector<SegmentUntrim> Curve::untrim(geometry::real o)
 {
-	length();
+	prepare();
 
 	std::vector<SegmentUntrim> result;
-	float offset = glm::abs(o);
+	result.reserve(size());
+	geometry::real offset = glm::abs(o);
 	bool inside = o < 0;
 	bool cw = this->cw();
 
@@ -1192,16 +1306,16 @@ std::vector<SegmentUntrim> Curve::untrim(float o)
 						if (cw)
 						{
 							if (inside)
-								angle = angle - glm::half_pi<float>();
+								angle = angle - glm::half_pi<geometry::real>();
 							else
-								angle = angle + glm::half_pi<float>();
+								angle = angle + glm::half_pi<geometry::real>();
 						}
 						else
 						{
 							if (inside)
-								angle = angle + glm::half_pi<float>();
+								angle = angle + glm::half_pi<geometry::real>();
 							else
-								angle = angle - glm::half_pi<float>();
+								angle = angle - glm::half_pi<geometry::real>();
 						}
 						auto start = geometry::position(angle, offset, s.point);
 						auto stop = geometry::position(angle, offset, dst);
@@ -1300,16 +1414,18 @@ std::vector<SegmentUntrim> Curve::untrim(float o)
 	return result;
 }
 
-Curve Curve::trim(std::vector<SegmentUntrim>& original, float o)
+Curve Curve::trim(std::vector<SegmentUntrim>& original, geometry::real o)
 {
 	Curve result;
 
 	if (original.size() == 0)
 		return result;
 
+	prepare();
+
 	bool inside = o < 0;
 	bool clock = inside ? !cw() : cw();
-	float v = glm::abs(o);
+	geometry::real v = glm::abs(o);
 
 	if (original.size() == 1 && original[0].type == SegmentType::Circle)
 	{
@@ -1342,7 +1458,7 @@ Curve Curve::trim(std::vector<SegmentUntrim>& original, float o)
 			}
 			else
 			{
-				glm::vec2 pp[2], p = glm::vec2();
+				geometry::rvec2 pp[2], p = geometry::rvec2();
 				bool left1 = false, left2 = false, tip1 = false, tip2 = false;
 				int count = 0;
 
@@ -1389,11 +1505,11 @@ Curve Curve::trim(std::vector<SegmentUntrim>& original, float o)
 					p = s2.point;
 					if (geometry::distance2(s1.dst, s2.point) > geometry::ERR_FLOAT3)
 					{
-						float a = geometry::oriented_angle(s1.dst, s2.point, (*this)[s2.index].point, clock);
+						geometry::real a = geometry::oriented_angle(s1.dst, s2.point, (*this)[s2.index].point, clock);
 						// if segment is tagged as excluded, we forward the tag 
 						// if the linked arc angle is greater than PI, this means that there is already an intersection
 						// earlier and this arc link will intersect original curve, so it needs to be excluded
-						if (s1.excluded || s2.excluded || a > glm::pi<float>())
+						if (s1.excluded || s2.excluded || a > glm::pi<geometry::real>())
 						{
 							result.add(s1.dst);
 							(&result.back())->excluded = true;
@@ -1446,7 +1562,7 @@ Curve Curve::trim(std::vector<SegmentUntrim>& original, float o)
 								// if segment is tagged as excluded, we forward the tag 
 								// if the linked arc angle is greater than PI, this means that there is already an intersection
 								// earlier and this arc link will intersect original curve, so it needs to be excluded
-								if (s1.excluded || s2.excluded || a > glm::pi<float>())
+								if (s1.excluded || s2.excluded || a > glm::pi<geometry::real>())
 									(&result.back())->excluded = true;
 							}
 						}
@@ -1473,10 +1589,10 @@ struct Intersection
 {
 	int index1 = -1;		// index of first origin segment that intersects
 	int index2 = -1;		// index of second origin segment that intersects
-	glm::vec2 point;		// coordinates of intersection
+	geometry::rvec2 point;		// coordinates of intersection
 	int tag = -1;			// the pair of Intersection will have the same tag
 	int index = -1;			// index in the intersection list of the index1 segment
-	float a = 0;			// oriented angle for arcs sorting :
+	geometry::real a = 0;			// oriented angle for arcs sorting :
 							//		when one segment has multiple intersections, intersections needs to be sorted
 							//		if for a segment, we can sort intersections based on x or y coordinates
 							//		for arcs, we need to sort intersections based on the arc angle from start ref_point to intersection  ref_point
@@ -1486,13 +1602,13 @@ struct Intersection
 	std::vector<Segment>::iterator it1;	// this holds the iterator which holds the segment before the intersection ref_point
 	std::vector<Segment>::iterator it2;	// this holds the iterator which holds the segment after the intersection ref_point
 
-	Intersection(int index1, glm::vec2 point)
+	Intersection(int index1, geometry::rvec2 point)
 	{
 		this->index1 = index1;
 		this->point = point;
 	}
 
-	Intersection(int index1, int index2, glm::vec2 point, int tag)
+	Intersection(int index1, int index2, geometry::rvec2 point, int tag)
 	{
 		this->index1 = index1;
 		this->index2 = index2;
@@ -1537,7 +1653,7 @@ bool compare_intersection_a_lower(Intersection& v1, Intersection& v2)
 // we store coordinates intersections, a segment can be intersected several times
 // we then sort for each index intersection points to be in "line" from src to dst
 // we then go through the curve, for each intersection we jump to next index
-std::vector<Curve> Curve::split_at_intersections()
+std::vector<Curve> Curve::split_at_intersections(bool sweep)
 {
 	//float s_f = 1;
 	std::vector<Curve> result;
@@ -1557,81 +1673,123 @@ std::vector<Curve> Curve::split_at_intersections()
 	{
 		//scale(s_f);
 
-		std::vector<int> indices; // hold indices of 
-		std::vector<std::vector<Intersection>> intersections;
+		// work containers are allocated from the arena
+		std::pmr::vector<int> indices(Arena::resource()); // hold indices of 
+		std::pmr::vector<std::pmr::vector<Intersection>> intersections(Arena::resource());
 
 		// we construct an array to store intersection points for each index
 		// a segment can have several intersections
 		// so we will push into the list associated to the segment every intersections detected
 		// as it is self intersection, we have to push the intersection for both segments i and j
-		intersections.reserve(a.size());
-		for (int i = 0; i < a.size(); i++)
-			intersections.push_back(std::vector<Intersection>());
+		intersections.resize(a.size());
 
 		int tag = 0;
-		counter[5] = 0;
 
-		for (int i = 0; i < a.size() - 1; i++)
+		// candidate pairs (i, j), i < j, are given by the sweep-line over the x-monotone pieces
+		// or by a spatial index search for each segment
+		CurveView& v = view();
+		std::pmr::vector<std::pair<int, int>> pairs(Arena::resource());
+		if (sweep)
+		{
+			SweepLine line;
+			for (int i = 0; i < a.size(); i++)
+				line.add(a[i], (i == a.size() - 1) ? a[0].point : a[i + 1].point, i);
+			line.pairs(pairs);
+		}
+		else
+		{
+			std::pmr::vector<int> candidates(Arena::resource());
+			for (int i = 0; i < a.size() - 1; i++)
+			{
+				candidates.clear();
+				a.search(a[i].bounds, std::back_inserter(candidates));
+				for (int j : candidates)
+					if (j > i)
+						pairs.push_back(std::make_pair(i, j));
+			}
+		}
+
+		// pairs of a segment are consecutive, the segment is tested against all its candidates at once :
+		// sweep pairs keep the spatial index rule on segments bounds, as pieces bounds have a margin,
+		// then line pairs too far apart to intersect are dropped
+		std::pmr::vector<int> run(Arena::resource());
+		std::pmr::vector<uint8_t> keep(Arena::resource());
+		size_t kept = 0;
+		for (size_t k = 0; k < pairs.size();)
+		{
+			int i = pairs[k].first;
+			run.clear();
+			for (; k < pairs.size() && pairs[k].first == i; k++)
+				run.push_back(pairs[k].second);
+
+			keep.assign(run.size(), 1);
+			if (sweep)
+				v.hits(i, run.data(), run.size(), keep.data());
+			if (v.line(i))
+				v.straddle(i, run.data(), run.size(), keep.data());
+
+			for (size_t r = 0; r < run.size(); r++)
+				if (keep[r])
+					pairs[kept++] = std::make_pair(i, run[r]);
+		}
+		pairs.resize(kept);
+		if (sweep)
+			Stats::add(Stats::candidates, pairs.size());
+
+		for (auto& pair : pairs)
 		{
-			Segment s1 = a[i];
-			glm::vec dst1 = a[i + 1].point;
+			int i = pair.first;
+			int j = pair.second;
 
-			auto candidates = a.search(s1.bounds);
+			// segments are read from the arrays view, the last one goes back to the first point
+			geometry::rvec2 src1 = geometry::rvec2(v.x[i], v.y[i]), dst1 = geometry::rvec2(v.x[i + 1], v.y[i + 1]);
+			geometry::rvec2 src2 = geometry::rvec2(v.x[j], v.y[j]), dst2 = geometry::rvec2(v.x[j + 1], v.y[j + 1]);
+			geometry::rvec2 c1 = geometry::rvec2(v.cx[i], v.cy[i]), c2 = geometry::rvec2(v.cx[j], v.cy[j]);
+			bool arc1 = (v.flags[i] & CurveView::arc) != 0, arc2 = (v.flags[j] & CurveView::arc) != 0;
+			bool cw1 = (v.flags[i] & CurveView::cw) != 0, cw2 = (v.flags[j] & CurveView::cw) != 0;
 
-			//for (int j = i + 1; j < a.size(); j++)
-			for (int k = 0; k < candidates.size(); k++)
+			if (j == i + 1 && !(v.line(i) && v.line(j)) || j != i + 1) // we do not test adjacente line segments
 			{
-				int j = candidates[k].index;
+				Stats::add(Stats::intersection_tests);
+				int count = 0;
+				geometry::rvec2 pp[2];
 
-				if (j > i)
+				if (v.line(i) && v.line(j))
 				{
-					Segment s2 = a[j];
-					glm::vec2 dst2 = (j == a.size() - 1) ? a[0].point : a[j + 1].point;
-
-					if (j == i + 1 && !(a[i].type == SegmentType::Line && a[j].type == SegmentType::Line) || j != i + 1) // we do not test adjacente line segments
+					geometry::rvec2 p = geometry::rvec2();
+					if (geometry::segment_segment_intersect(src1, dst1, src2, dst2, p))
 					{
-						counter[5]++;
-						int count = 0;
-						glm::vec2 pp[2];
-
-						if (s1.type == SegmentType::Line && s2.type == SegmentType::Line)
-						{
-							glm::vec2 p = glm::vec2();
-							if (geometry::segment_segment_intersect(s1.point, dst1, s2.point, dst2, p))
-							{
-								pp[0] = p;
-								count = 1;
-							}
-						}
-						else if (s1.type == SegmentType::Line && s2.type == SegmentType::Arc)
-						{
-							count = geometry::segment_arc_intersect(s1.point, dst1, s2.point, s2.center, dst2, s2.radius, s2.cw, pp);
-						}
-						else if (s1.type == SegmentType::Arc && s2.type == SegmentType::Line)
-						{
-							count = geometry::segment_arc_intersect(s2.point, dst2, s1.point, s1.center, dst1, s1.radius, s1.cw, pp);
-						}
-						else if (s1.type == SegmentType::Arc && s2.type == SegmentType::Arc)
-						{
-							count = geometry::arc_arc_intersect(s1.point, s1.center, dst1, s1.radius, s1.cw, s2.point, s2.center, dst2, s2.radius, s2.cw, pp);
-						}
-
-						if (count == 1 && (glm::abs(i - j) == 1 || (i == 0 && j == a.size() - 1) || (j == 0 && i == a.size() - 1)))
-							count = 0;
+						pp[0] = p;
+						count = 1;
+					}
+				}
+				else if (v.line(i) && arc2)
+				{
+					count = geometry::segment_arc_intersect(src1, dst1, src2, c2, dst2, v.r[j], cw2, pp);
+				}
+				else if (arc1 && v.line(j))
+				{
+					count = geometry::segment_arc_intersect(src2, dst2, src1, c1, dst1, v.r[i], cw1, pp);
+				}
+				else if (arc1 && arc2)
+				{
+					count = geometry::arc_arc_intersect(src1, c1, dst1, v.r[i], cw1, src2, c2, dst2, v.r[j], cw2, pp);
+				}
 
-						for (int c = 0; c < count; c++)
-						{
-							intersections[i].push_back(Intersection(i, j, pp[c], tag));
-							intersections[j].push_back(Intersection(j, i, pp[c], tag));
-							if (std::find(indices.begin(), indices.end(), i) == indices.end())
-								indices.push_back(i);
-							if (std::find(indices.begin(), indices.end(), j) == indices.end())
-								indices.push_back(j);
-							tag++;
-						}
+				if (count == 1 && (glm::abs(i - j) == 1 || (i == 0 && j == a.size() - 1) || (j == 0 && i == a.size() - 1)))
+					count = 0;
 
-					}
+				for (int c = 0; c < count; c++)
+				{
+					intersections[i].push_back(Intersection(i, j, pp[c], tag));
+					intersections[j].push_back(Intersection(j, i, pp[c], tag));
+					if (intersections[i].size() == 1)
+						indices.push_back(i);
+					if (intersections[j].size() == 1)
+						indices.push_back(j);
+					tag++;
 				}
+
 			}
 		}
 
@@ -1651,22 +1809,22 @@ std::vector<Curve> Curve::split_at_intersections()
 			// for arcs, we use the angle between [a] and intersection ref_point
 			// so we go through 'indices' which hold where intersections have occured to avoid looking the entire 'intersections' list
 
-			float _3_4_pi = 3 * glm::quarter_pi<float>();
-			float _5_4_pi = 5 * glm::quarter_pi<float>();
-			float _7_4_pi = 7 * glm::quarter_pi<float>();
+			geometry::real _3_4_pi = 3 * glm::quarter_pi<geometry::real>();
+			geometry::real _5_4_pi = 5 * glm::quarter_pi<geometry::real>();
+			geometry::real _7_4_pi = 7 * glm::quarter_pi<geometry::real>();
 
 			for (int i = 0; i < indices.size(); i++)
 			{
 				// if segment has more than one intersections, need to be sorted
 				if (intersections[indices[i]].size() > 1) 
 				{
-					Segment s1 = a[indices[i]];
-					Segment s2 = a[indices[i] == a.size() - 1 ? 0 : indices[i] + 1];
+					Segment& s1 = a[indices[i]];
+					Segment& s2 = a[indices[i] == a.size() - 1 ? 0 : indices[i] + 1];
 
 					if (s1.type == SegmentType::Line)
 					{
 						auto a = geometry::oriented_angle(s2.point, s1.point);
-						if (a > glm::quarter_pi<float>() && a < _3_4_pi || a > _5_4_pi && a < _7_4_pi)
+						if (a > glm::quarter_pi<geometry::real>() && a < _3_4_pi || a > _5_4_pi && a < _7_4_pi)
 						//if (s1.ref_point.x == s2.ref_point.x) // vertical
 						{
 							if (s1.point.y < s2.point.y)
@@ -1685,14 +1843,14 @@ std::vector<Curve> Curve::split_at_intersections()
 					else // for arcs, we have to sort following the oriented angle
 					{
 						auto a1 = geometry::oriented_angle(s1.point, s1.center);
-						float at = 0;
+						geometry::real at = 0;
 						if (s1.cw)
 						{
 							for (Intersection& inter : intersections[indices[i]])
 							{
 								inter.a = geometry::oriented_angle(inter.point, s1.center);
 								if (inter.a > a1)
-									inter.a -= glm::two_pi<float>();
+									inter.a -= glm::two_pi<geometry::real>();
 							}
 							std::sort(intersections[indices[i]].begin(), intersections[indices[i]].end(), compare_intersection_a_greater);
 						}
@@ -1702,7 +1860,7 @@ std::vector<Curve> Curve::split_at_intersections()
 							{
 								inter.a = geometry::oriented_angle(inter.point, s1.center);
 								if (inter.a < a1)
-									inter.a += glm::two_pi<float>();
+									inter.a += glm::two_pi<geometry::real>();
 							}
 							std::sort(intersections[indices[i]].begin(), intersections[indices[i]].end(), compare_intersection_a_lower);
 						}
@@ -1715,9 +1873,9 @@ std::vector<Curve> Curve::split_at_intersections()
 			// then we link into segment's tag  with the intersected segment
 			// then we are able to go throught the curve and split it into several curves
 
-			std::list<Segment> b;
+			std::pmr::list<Segment> b(Arena::resource());
 
-			std::map<int, std::list<Segment>::iterator> tags;
+			std::pmr::map<int, std::pmr::list<Segment>::iterator> tags(Arena::resource());
 
 			for (int i = 0; i < a.size(); i++)
 			{
@@ -1818,7 +1976,7 @@ std::vector<Curve> Curve::split_at_intersections()
 				c.reset_bounds();
 				if (!excluded)
 				{
-					result.push_back(c);
+					result.push_back(std::move(c));
 				}
 			}
 		}
@@ -1858,62 +2016,46 @@ std::vector<Curve> Curve::boolean_not_intersect(Curve& b)
 	return weiler(b, false, false);
 }
 
-bool Curve::too_small(float o)
+bool Curve::too_small(geometry::real o)
 {
 	return /*bounds().width() + bounds().height() < glm::abs(o)/2 ||*/ bounds().height() < 0.05 * glm::abs(o) || bounds().width() < 0.05 * glm::abs(o);
 }
 
-bool Curve::too_close(Curve& test, float o)
+bool Curve::too_close(Curve& test, geometry::real o)
 {
+	prepare();
+	test.prepare();
+
 	auto r = glm::abs(o);
 	auto hr = r * 0.98f;
 	auto hr2 = hr * hr;
+	CurveView& a = view();
+	CurveView& t = test.view();
+
+	std::pmr::vector<int> candidates(Arena::resource());
 	for (int i = 0; i < test.size(); i++)
 	{
 		Segment& s1 = test[i];
-		glm::vec2 d1 = test[i < test.size() - 1 ? i + 1 : 0].point;
-		glm::vec2 m1 = s1.type == SegmentType::Line ? geometry::middle(s1.point, d1) : geometry::arc_middle(s1.point, s1.center, d1, s1.cw);
+		geometry::rvec2 d1 = geometry::rvec2(t.x[i + 1], t.y[i + 1]);
 
-		auto candidates = search(s1.bounds.offset(r));
+		candidates.clear();
+		search(s1.bounds.offset(r), std::back_inserter(candidates));
+		Stats::add(Stats::proximity_tests, candidates.size());
+
+		// start, middle and stop points of both segments, all the candidates at once
+		geometry::real qx[3] = { t.x[i], t.mx[i], t.x[i + 1] };
+		geometry::real qy[3] = { t.y[i], t.my[i], t.y[i + 1] };
+		if (a.near(candidates.data(), candidates.size(), qx, qy, 3, hr2))
+			return true;
 
 		for (int k = 0; k < candidates.size(); k++)
 		{
-			counter[0]++;
-			int j = candidates[k].index;
+			int j = candidates[k];
 
-			Segment& s2 = candidates[k]; //original[j];
-			glm::vec2 d2 = (*this)[j < size() - 1 ? j + 1 : 0].point;
-			glm::vec2 m2 = s2.type == SegmentType::Line ? geometry::middle(s2.point, d2) : geometry::arc_middle(s2.point, s2.center, d2, s2.cw);
+			Segment& s2 = (*this)[j];
+			geometry::rvec2 d2 = geometry::rvec2(a.x[j + 1], a.y[j + 1]);
 
-			glm::vec2 p, pp[2];
-			float d;
-			d = geometry::distance2(s2.point, m1);
-			if (d < hr2)
-				return true;
-			d = geometry::distance2(d2, m1);
-			if (d < hr2)
-				return true;
-			d = geometry::distance2(m2, m1);
-			if (d < hr2)
-				return true;
-			d = geometry::distance2(s2.point, s1.point);
-			if (d < hr2)
-				return true;
-			d = geometry::distance2(d2, s1.point);
-			if (d < hr2)
-				return true;
-			d = geometry::distance2(m2, s1.point);
-			if (d < hr2)
-				return true;
-			d = geometry::distance2(s2.point, d1);
-			if (d < hr2)
-				return true;
-			d = geometry::distance2(d2, d1);
-			if (d < hr2)
-				return true;
-			d = geometry::distance2(m2, d1);
-			if (d < hr2)
-				return true;
+			geometry::rvec2 p, pp[2];
 
 
 			//if (s1.type == SegmentType::Arc && s2.type == SegmentType::Arc && geometry::arc_arc_intersect(s2.ref_point, s2.center, d2, s2.cw, m1, hr, pp) == 2)
@@ -2098,26 +2240,31 @@ bool Curve::too_close(Curve& test, float o)
 	return false;
 }
 
-bool Curve::too_close2(Curve& test, float o)
+bool Curve::too_close2(Curve& test, geometry::real o)
 {
+	prepare();
+	test.prepare();
+
 	auto r = glm::abs(o);
 	auto hr = r * 0.999;
 
+	std::vector<int> candidates;
 	for (int i = 0; i < test.size(); i++)
 	{
 		Segment& s1 = test[i];
-		glm::vec2 src1 = s1.point, dst1 = test[i < test.size() - 1 ? i + 1 : 0].point;
+		geometry::rvec2 src1 = s1.point, dst1 = test[i < test.size() - 1 ? i + 1 : 0].point;
 
-		auto candidates = search(s1.bounds.offset(r));
+		candidates.clear();
+		search(s1.bounds.offset(r), std::back_inserter(candidates));
 
 		for (int k = 0; k < candidates.size(); k++)
 		{
-			counter[0]++;
-			int j = candidates[k].index;
-			float d = 0;
+			Stats::add(Stats::proximity_tests);
+			int j = candidates[k];
+			geometry::real d = 0;
 
-			Segment& s2 = candidates[k]; //original[j];
-			glm::vec2 src2 = s2.point, dst2 = (*this)[j < size() - 1 ? j + 1 : 0].point;
+			Segment& s2 = (*this)[j];
+			geometry::rvec2 src2 = s2.point, dst2 = (*this)[j < size() - 1 ? j + 1 : 0].point;
 
 			if (s1.type == SegmentType::Line && s2.type == SegmentType::Line)
 			{
@@ -2171,41 +2318,47 @@ bool Curve::too_close2(Curve& test, float o)
 
 bool Curve::curve_intersect(Curve& test)
 {
+	prepare();
+	test.prepare();
+
 	Curve& a = size() < test.size() ? *this : test;
 	Curve& b = size() < test.size() ? test : *this;
 
+	std::pmr::vector<int> candidates(Arena::resource());
 	for (int i = 0; i < a.size(); i++)
 	{
-		auto candidates = b.search(a[i].bounds);
+		candidates.clear();
+		b.search(a[i].bounds, std::back_inserter(candidates));
 
 		for (int j = 0; j < candidates.size(); j++)
 		{
 			Segment& s1 = a[i];
-			glm::vec2 d1 = i == a.size() - 1 ? a[0].point : a[i + 1].point;
-			Segment& s2 = candidates[j];
-			glm::vec2 d2 = candidates[j].index == b.size() - 1 ? b[0].point : b[candidates[j].index + 1].point;
+			geometry::rvec2 d1 = i == a.size() - 1 ? a[0].point : a[i + 1].point;
+			Segment& s2 = b[candidates[j]];
+			geometry::rvec2 d2 = candidates[j] == b.size() - 1 ? b[0].point : b[candidates[j] + 1].point;
+			Stats::add(Stats::intersection_tests);
 
 			if (s1.type == SegmentType::Line && s2.type == SegmentType::Line)
 			{
-				glm::vec2 p;
+				geometry::rvec2 p;
 				if (geometry::segment_segment_intersect(s1.point, d1, s2.point, d2, p))
 					return true;
 			}
 			else if (s1.type == SegmentType::Line && s2.type == SegmentType::Arc)
 			{
-				glm::vec2 pp[2];
+				geometry::rvec2 pp[2];
 				if (geometry::segment_arc_intersect(s1.point, d1, s2.point, s2.center, d2, s2.cw, pp) > 0)
 					return true;
 			}
 			else if (s1.type == SegmentType::Arc && s2.type == SegmentType::Line)
 			{
-				glm::vec2 pp[2];
+				geometry::rvec2 pp[2];
 				if (geometry::segment_arc_intersect(s2.point, d2, s1.point, s1.center, d1, s1.cw, pp) > 0)
 					return true;
 			}
 			else if (s1.type == SegmentType::Arc && s2.type == SegmentType::Arc)
 			{
-				glm::vec2 pp[2];
+				geometry::rvec2 pp[2];
 				if (geometry::arc_arc_intersect(s2.point, s2.center, d2, s2.cw, s1.point, s1.center, d1, s1.cw, pp) > 0)
 					return true;
 			}
@@ -2221,7 +2374,7 @@ bool Curve::curve_intersect(Curve& test)
 //	return (v1.bounds.bottom_right.x > v2.bounds.bottom_right.x);
 //}
 
-std::vector<Segment> Curve::search(geometry::rectangle bounds)
+PackedRTree& Curve::tree()
 {
 	// Method one, segments are sorted following the x coordinate
 	// then we compare the bounds with segments bounds. 
@@ -2248,18 +2401,21 @@ std::vector<Segment> Curve::search(geometry::rectangle bounds)
 	//}
 	//return _sorted;
 	
-	// Second method, a quadtree is created with bounds which is divided into four areas
-	// then each segment is classified following the 1/4 bounds
-	// a tree of quad bounds is generated
-	// searching will then be a tree branch comparison
+	// Second method, a packed R-tree is bulk loaded with the segments bounds,
+	// segments are grouped by tiles of neighbours and the tree only stores segment indices
+	// searching will then be a tree branch comparison without allocation
 	if (!_tree.created())
-	{
-		_tree.create(this->bounds(), 0, glm::min<int>(255, (int)size() / 4));
-		for (Segment p : *this)
-			_tree.add(p, p.bounds);
-	}
+		_tree.create(*this, [](Segment& s) -> geometry::rectangle& { return s.bounds; });
 
-	return _tree.search(bounds);
+	return _tree;
+}
+
+CurveView& Curve::view()
+{
+	if (!_view.created() || _view.size() != size())
+		_view.create(*this);
+
+	return _view;
 }
 
 void Curve::sort_level(std::vector<Curve>& curves)
@@ -2327,32 +2483,34 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 			intersections_b.push_back(std::vector<Intersection>());
 
 		int tag = 0;
-		counter[5] = 0;
 
 		// we construct an array to store intersection points for each index
 		// a segment can have several intersections
 		// so we will push into the list associated to the segment every intersections detected
+		std::vector<int> candidates;
 		for (int i = 0; i < a.size(); i++)
 		{
-			Segment s1 = a[i];
+			Segment& s1 = a[i];
 			glm::vec dst1 = (i == a.size() - 1)? a[0].point : a[i + 1].point;
 
-			auto candidates = b.search(s1.bounds);
+			candidates.clear();
+			b.search(s1.bounds, std::back_inserter(candidates));
 
 			//for (int j = i + 1; j < a.size(); j++)
 			for (int k = 0; k < candidates.size(); k++)
 			{
-				int j = candidates[k].index;
+				int j = candidates[k];
+				Stats::add(Stats::intersection_tests);
 
-				Segment s2 = b[j];
-				glm::vec2 dst2 = (j == b.size() - 1) ? dst2 = b[0].point : dst2 = b[j + 1].point;
+				Segment& s2 = b[j];
+				geometry::rvec2 dst2 = (j == b.size() - 1) ? dst2 = b[0].point : dst2 = b[j + 1].point;
 
 				int count = 0;
-				glm::vec2 pp[2];
+				geometry::rvec2 pp[2];
 
 				if (s1.type == SegmentType::Line && s2.type == SegmentType::Line)
 				{
-					glm::vec2 p = glm::vec2();
+					geometry::rvec2 p = geometry::rvec2();
 					if (geometry::segment_segment_intersect(s1.point, dst1, s2.point, dst2, p))
 					{
 						pp[0] = p;
@@ -2393,14 +2551,15 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 		// for arcs, we use the angle between [a] and intersection ref_point
 		// so we go through 'indices' which hold where intersections have occured to avoid looking the entire 'intersections' list
 		Curve* c = &a;
-		std::vector<int> indices = indices_a;
-		std::vector<std::vector<Intersection>> intersections = intersections_a;
+		// intersections of each curve are moved in and out of the working arrays, never copied
+		std::vector<int> indices = std::move(indices_a);
+		std::vector<std::vector<Intersection>> intersections = std::move(intersections_a);
 		int pass = 0;
 		if (indices.size() > 0)
 		{
-			float _3_4_pi = 3 * glm::quarter_pi<float>();
-			float _5_4_pi = 5 * glm::quarter_pi<float>();
-			float _7_4_pi = 7 * glm::quarter_pi<float>();
+			geometry::real _3_4_pi = 3 * glm::quarter_pi<geometry::real>();
+			geometry::real _5_4_pi = 5 * glm::quarter_pi<geometry::real>();
+			geometry::real _7_4_pi = 7 * glm::quarter_pi<geometry::real>();
 
 			do
 			{
@@ -2410,14 +2569,14 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 				{
 					if (intersections[indices[i]].size() > 1)
 					{
-						Segment s1 = (*c)[indices[i]];
-						Segment s2 = (*c)[indices[i] == (*c).size() - 1 ? 0 : indices[i] + 1];
+						Segment& s1 = (*c)[indices[i]];
+						Segment& s2 = (*c)[indices[i] == (*c).size() - 1 ? 0 : indices[i] + 1];
 
 						if (s1.type == SegmentType::Line)
 						{
 							//if (s1.ref_point.x == s2.ref_point.x) // vertical
 							auto a = geometry::oriented_angle(s2.point, s1.point);
-							if (a > glm::quarter_pi<float>() && a < _3_4_pi || a > _5_4_pi && a < _7_4_pi)
+							if (a > glm::quarter_pi<geometry::real>() && a < _3_4_pi || a > _5_4_pi && a < _7_4_pi)
 							{
 								if (s1.point.y < s2.point.y)
 									std::sort(intersections[indices[i]].begin(), intersections[indices[i]].end(), compare_intersection_y_smaller);
@@ -2435,14 +2594,14 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 						else // for arcs, we have to sort following the oriented angle
 						{
 							auto a1 = geometry::oriented_angle(s1.point, s1.center);
-							float at = 0;
+							geometry::real at = 0;
 							if (s1.cw)
 							{
 								for (Intersection& inter : intersections[indices[i]])
 								{
 									inter.a = geometry::oriented_angle(inter.point, s1.center);
 									if (inter.a > a1)
-										inter.a -= glm::two_pi<float>();
+										inter.a -= glm::two_pi<geometry::real>();
 								}
 								std::sort(intersections[indices[i]].begin(), intersections[indices[i]].end(), compare_intersection_a_greater);
 							}
@@ -2452,7 +2611,7 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 								{
 									inter.a = geometry::oriented_angle(inter.point, s1.center);
 									if (inter.a < a1)
-										inter.a += glm::two_pi<float>();
+										inter.a += glm::two_pi<geometry::real>();
 								}
 								std::sort(intersections[indices[i]].begin(), intersections[indices[i]].end(), compare_intersection_a_lower);
 							}
@@ -2464,12 +2623,12 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 				if (pass == 0)
 				{
 					c = &b;
-					indices = indices_b;
-					intersections_a = intersections;
-					intersections = intersections_b;
+					indices = std::move(indices_b);
+					intersections_a = std::move(intersections);
+					intersections = std::move(intersections_b);
 				}
 				else
-					intersections_b = intersections;
+					intersections_b = std::move(intersections);
 				pass++;
 
 			} while (pass != 2);
@@ -2489,12 +2648,12 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 		// then we link into segment's tag  with the intersected segment
 		// then we are able to go throught the curve and split it into several curves
 
-		std::map<int, std::list<Segment>::iterator> tags;
-		std::list<Segment> b_a, b_b;
+		std::pmr::map<int, std::pmr::list<Segment>::iterator> tags(Arena::resource());
+		std::pmr::list<Segment> b_a(Arena::resource()), b_b(Arena::resource());
 		pass = 0;
 		c = &a;
-		std::list<Segment>* l = &b_a;
-		intersections = intersections_a;
+		std::pmr::list<Segment>* l = &b_a;
+		intersections = std::move(intersections_a);
 
 		while (pass != 2)
 		{
@@ -2554,7 +2713,7 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 			{
 				c = &b;
 				l = &b_b;
-				intersections = intersections_b;
+				intersections = std::move(intersections_b);
 			}
 		}
 
@@ -2579,7 +2738,7 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 			bool excluded = false;
 			bool exit = false, first_segment_from_ba = true;
 
-			std::list<Segment>::iterator it, next;
+			std::pmr::list<Segment>::iterator it, next;
 			Segment first = Segment(geometry::vec2_empty);
 			if (b_a.size() > 0)
 			{
@@ -2634,7 +2793,7 @@ std::vector<Curve> Curve::weiler(Curve& b, bool same_direction, bool outside)
 
 			if (c.size() > 1)
 			{
-				glm::vec2 dst;
+				geometry::rvec2 dst;
 				if (c[0].type == SegmentType::Line)
 					dst = geometry::middle(c[0].point, c[1].point);
 				else
@@ -2741,6 +2900,69 @@ void TreeCurve::sort()
 	}
 }
 
+void TreeCurve::nest()
+{
+	size_t n = children.size();
+	if (n > 1)
+	{
+		// a curve inside another one has smaller bounds, curves are ranked by decreasing bounds area and a parent always comes first
+		std::vector<int> order(n);
+		std::vector<geometry::real> areas(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			order[i] = (int)i;
+			areas[i] = children[i]->curve->bounds().width() * children[i]->curve->bounds().height();
+		}
+		std::stable_sort(order.begin(), order.end(), [&areas](int a, int b) { return areas[a] > areas[b]; });
+
+		std::vector<int> rank(n);
+		for (size_t k = 0; k < n; k++)
+			rank[order[k]] = (int)k;
+
+		PackedRTree tree;
+		tree.create(children, [](TreeCurve* t) { return t->curve->bounds(); });
+
+		std::vector<int> parent(n, -1);
+		std::vector<int> candidates;
+		for (size_t i = 0; i < n; i++)
+		{
+			Curve* c = children[i]->curve;
+			candidates.clear();
+			tree.visit(c->bounds(), [this, c, i, &rank, &candidates](int j) {
+				if (rank[j] < rank[i] && children[j]->curve->bounds().contains(c->bounds()))
+					candidates.push_back(j);
+				return true;
+			});
+
+			// the smallest curve containing c is its parent
+			std::sort(candidates.begin(), candidates.end(), [&rank](int a, int b) { return rank[a] > rank[b]; });
+			for (int j : candidates)
+			{
+				if (c->inside(*children[j]->curve))
+				{
+					parent[i] = j;
+					break;
+				}
+			}
+		}
+
+		std::vector<TreeCurve*> roots;
+		for (size_t i = 0; i < n; i++)
+		{
+			if (parent[i] < 0)
+				roots.push_back(children[i]);
+			else
+				children[parent[i]]->add(children[i]);
+		}
+		children.swap(roots);
+	}
+
+	std::stable_sort(children.begin(), children.end(), compare_treecurve_tag);
+
+	for (TreeCurve* c : children)
+		c->nest();
+}
+
 void TreeCurve::cw_all(bool direction)
 {
 	if (curve->size() > 0)
@@ -2807,6 +3029,15 @@ TreeCurve::~TreeCurve()
 	children.clear();
 }
 
+TreeCurve* TreeCurve::copy()
+{
+	TreeCurve* result = new TreeCurve(curve != nullptr ? new Curve(*curve) : nullptr);
+	result->level = level;
+	for (TreeCurve* c : children)
+		result->add(c->copy());
+	return result;
+}
+
 size_t TreeCurve::size()
 {
 	size_t count = children.size();
@@ -2823,7 +3054,7 @@ std::vector<Curve> TreeCurve::curves()
 	for (TreeCurve* c : children)
 	{
 		auto list = c->curves();
-		result.insert(result.end(), list.begin(), list.end());
+		result.insert(result.end(), std::make_move_iterator(list.begin()), std::make_move_iterator(list.end()));
 	}
 
 	std::sort(result.begin(), result.end(), compare_curve_level);
@@ -10,7 +10,10 @@
 #include <forward_list>
 #include <deque>
 #include <list>
+#include <memory_resource>
+#include <mutex>
 #include <ftree.h>
+#include <curveview.h>
 
 enum class SegmentType
 {
@@ -24,53 +27,67 @@ class Segment
 private:
 
 public:
-	glm::vec2 point = glm::vec2();
-	glm::vec2 center = glm::vec2();
-	float radius = 0;
+	geometry::rvec2 point = geometry::rvec2();
+	geometry::rvec2 center = geometry::rvec2();
+	geometry::real radius = 0;
 	SegmentType type = SegmentType::Line;
 	bool cw = false;
 	int tag = -1;
 	int next_tag = -1;
-	float length = -1;
-	std::list<Segment>::iterator next;
+	geometry::real length = -1;
+	std::pmr::list<Segment>::iterator next;
 	bool excluded = false;
 	int index = -1;
 
 #ifdef _DEBUG
-	float perimeter = 0;
+	geometry::real perimeter = 0;
 #endif
 
 	geometry::rectangle bounds = geometry::rectangle();
 
 	Segment() {}
-	Segment(glm::vec2 point, int tag = -1);
-	Segment(glm::vec2 point, glm::vec2 center, float radius, bool cw, SegmentType type = SegmentType::Arc, int tag = -1, bool excluded=false);
+	Segment(geometry::rvec2 point, int tag = -1);
+	Segment(geometry::rvec2 point, geometry::rvec2 center, geometry::real radius, bool cw, SegmentType type = SegmentType::Arc, int tag = -1, bool excluded=false);
 
-	int intersect(glm::vec2 dst1, Segment s2, glm::vec2 dst2, glm::vec2 result[2]);
+	int intersect(geometry::rvec2 dst1, const Segment& s2, geometry::rvec2 dst2, geometry::rvec2 result[2]);
 
-	glm::vec2 coordinates_at(float length, glm::vec2 dst);
-	std::vector<Segment> split_at(float length, glm::vec2 dst);
+	geometry::rvec2 coordinates_at(geometry::real length, geometry::rvec2 dst);
+	std::vector<Segment> split_at(geometry::real length, geometry::rvec2 dst);
 };
 
 class SegmentUntrim : public Segment
 {
 public:
-	glm::vec2 dst = glm::vec2();
+	geometry::rvec2 dst = geometry::rvec2();
 
-	SegmentUntrim(glm::vec2 point, glm::vec2 dst, int index, bool excluded = false) : Segment(point)
+	SegmentUntrim(geometry::rvec2 point, geometry::rvec2 dst, int index, bool excluded = false) : Segment(point)
 	{
 		this->dst = dst;
 		this->index = index;
 		this->excluded = excluded;
 	};
 
-	SegmentUntrim(glm::vec2 point, glm::vec2 center, glm::vec2 dst, float radius, bool cw, int index, SegmentType type = SegmentType::Arc) : Segment(point, center, radius, cw, type)
+	SegmentUntrim(geometry::rvec2 point, geometry::rvec2 center, geometry::rvec2 dst, geometry::real radius, bool cw, int index, SegmentType type = SegmentType::Arc) : Segment(point, center, radius, cw, type)
 	{
 		this->dst = dst;
 		this->index = index;
 	};
 };
 
+/// <summary>
+/// Mutex guarding the lazily computed data of a curve. A copied or moved curve gets its own mutex
+/// </summary>
+struct CurveLock
+{
+	std::mutex mutex;
+
+	CurveLock() {}
+	CurveLock(const CurveLock&) {}
+	CurveLock(CurveLock&&) noexcept {}
+	CurveLock& operator=(const CurveLock&) { return *this; }
+	CurveLock& operator=(CurveLock&&) noexcept { return *this; }
+};
+
 enum class Position
 {
 	inside,
@@ -86,23 +103,34 @@ enum class Position
 class Curve : public std::vector<Segment>
 {
 private:
-	float _length = -1;
-	float _area = -1;
+	geometry::real _length = -1;
+	geometry::real _area = -1;
 	int _cw = -1;
 	geometry::rectangle _bounds;
 
 	std::vector<Segment> _sorted;
-	QuadNode<Segment> _tree;
+	PackedRTree _tree;
+	CurveView _view;
 	int _tag = -1;
 	int _reference = -1;
 	int _index = -1;
 	int _level = -1;
 	Position _tag_inside = Position::outline;
+	CurveLock _lock;
 
 public:
-	static int counter[10];
 	std::vector<glm::vec2> intersection_points; // for debug purpose
 
+	Curve() = default;
+
+	/// <summary>
+	/// Copies are counted by Stats::copies, moves are not
+	/// </summary>
+	Curve(const Curve& c);
+	Curve(Curve&& c) = default;
+	Curve& operator=(const Curve& c);
+	Curve& operator=(Curve&& c) = default;
+
 	int tag();
 	void tag(int value);
 
@@ -122,11 +150,18 @@ public:
 
 	void reset_bounds();
 
+	/// <summary>
+	/// Compute the lazily cached data : bounds, lengths, direction, segments spatial index and arrays view.
+	/// Once prepared, offset, untrim, trim, too_close and curve_intersect do not modify the curve
+	/// and can be called from several threads
+	/// </summary>
+	void prepare();
+
 	/// <summary>
 	/// Add a segment ref_point
 	/// </summary>
 	/// <param name="ref_point">ref_point coordinates</param>
-	void add(glm::vec2 point);
+	void add(geometry::rvec2 point);
 
 	/// <summary>
 	/// Add a arc ref_point, 
@@ -135,7 +170,7 @@ public:
 	/// <param name="center">center coordinates</param>
 	/// <param name="radius">radius</param>
 	/// <param name="cw">if true, clockwise</param>
-	void add(glm::vec2 point, glm::vec2 center, float radius, bool cw);
+	void add(geometry::rvec2 point, geometry::rvec2 center, geometry::real radius, bool cw);
 
 	/// <summary>
 	/// Add a circle ref_point. This method will add twice the 0 radian coordinates, for start and stop
@@ -143,7 +178,7 @@ public:
 	/// <param name="center">center coordinates</param>
 	/// <param name="radius">radius</param>
 	/// <param name="cw">if true, clockwise</param>
-	void add(glm::vec2 center, float radius, bool cw);
+	void add(geometry::rvec2 center, geometry::real radius, bool cw);
 
 	/// <summary>
 	/// Add following the type
@@ -153,7 +188,7 @@ public:
 	/// <param name="center"></param>
 	/// <param name="radius"></param>
 	/// <param name="cw"></param>
-	void add(SegmentType type, glm::vec2 point, glm::vec2 center, float radius, bool cw);
+	void add(SegmentType type, geometry::rvec2 point, geometry::rvec2 center, geometry::real radius, bool cw);
 
 	/// <summary>
 	/// Add following the type
@@ -165,13 +200,13 @@ public:
 	/// Return curve start coordinates
 	/// </summary>
 	/// <returns>coordinates</returns>
-	glm::vec2 first();
+	geometry::rvec2 first();
 
 	/// <summary>
 	/// return curve stop coordinates
 	/// </summary>
 	/// <returns>corrdinates</returns>
-	glm::vec2 last();
+	geometry::rvec2 last();
 
 	/// <summary>
 	/// return true if closed, start and stop coordinates are equal
@@ -205,20 +240,20 @@ public:
 	/// return curve length
 	/// </summary>
 	/// <returns></returns>
-	float length();
+	geometry::real length();
 
 	/// <summary>
 	/// return curve area
 	/// </summary>
 	/// <returns></returns>
-	float area();
+	geometry::real area();
 
 	/// <summary>
 	/// return true if ref_point p is inside the curve. if not closed, start coordinate is added for computation
 	/// </summary>
 	/// <param name="p">coordinates to test</param>
 	/// <returns></returns>
-	bool inside(glm::vec2 p);
+	bool inside(geometry::rvec2 p);
 
 	/// <summary>
 	/// return true if curve is inside b
@@ -269,7 +304,7 @@ public:
 	/// <param name="ref_point"></param>
 	/// <param name="index"></param>
 	/// <returns></returns>
-	std::vector<Curve> cut(glm::vec2 point, int index);
+	std::vector<Curve> cut(geometry::rvec2 point, int index);
 
 	/// <summary>
 	/// Cut a curve at the ref_point coordinates. Point is supposed to be part of the segment curve. There is no verification
@@ -277,7 +312,7 @@ public:
 	/// <param name="ref_point"></param>
 	/// <param name="it"></param>
 	/// <returns></returns>
-	std::vector<Curve> cut(glm::vec2 point, std::vector<Segment>::iterator it);
+	std::vector<Curve> cut(geometry::rvec2 point, std::vector<Segment>::iterator it);
 
 	/// <summary>
 	/// Return a curve which append curve b to current curve 
@@ -290,7 +325,7 @@ public:
 	/// Apply scale factor to the curve
 	/// </summary>
 	/// <param name="factor"></param>
-	void scale(float factor);
+	void scale(geometry::real factor);
 
 	/// <summary>
 	/// Return a curve that represent the boolean union of current curve with b curve
@@ -323,30 +358,44 @@ public:
 
 	/// <summary>
 	/// create an offseted curve. if cw && positive offset or !cw && negative offset, outside, else inside
+	/// Results are looked up in the OffsetCache first
 	/// </summary>
 	/// <param name="o">offset value</param>
 	/// <returns>new curve</returns>
-	std::vector<Curve> offset(float o, float max=0);
+	std::vector<Curve> offset(geometry::real o, geometry::real max=0);
+
+	/// <summary>
+	/// Internal purpose
+	/// Offset computation of offset, without the cache
+	/// </summary>
+	std::vector<Curve> compute_offset(geometry::real o, geometry::real max);
 
 	/// <summary>
 	/// fill position with the middle coordinates of the curve, angle with the derivative angle at position
 	/// </summary>
 	/// <param name="position"></param>
 	/// <param name="angle"></param>
-	void middle(glm::vec2& position, float& angle);
+	void middle(geometry::rvec2& position, geometry::real& angle);
 
 	/// <summary>
 	/// split the actual curve at lenth position and return the two resulted curves
 	/// </summary>
 	/// <param name="length"></param>
 	/// <returns></returns>
-	std::vector<Curve> split(float length);
+	std::vector<Curve> split(geometry::real length);
 
 	/// <summary>
 	/// Remove segments less than max
 	/// </summary>
 	/// <param name="max"></param>
-	void reduce(float max);
+	void reduce(geometry::real max);
+
+	/// <summary>
+	/// Replace runs of line segments by the longest lines and arcs that stay within tolerance of their vertices, in place.
+	/// Arcs of the curve are kept, the first and last points do not move
+	/// </summary>
+	/// <param name="tolerance">maximum distance between the vertices and the result</param>
+	void simplify(geometry::real tolerance);
 
 public:
 	/// <summary>
@@ -357,7 +406,7 @@ public:
 	/// </summary>
 	/// <param name="o">Offset</param>
 	/// <returns></returns>
-	std::vector<SegmentUntrim> untrim(float o);
+	std::vector<SegmentUntrim> untrim(geometry::real o);
 
 	/// <summary>
 	/// Internal purpose
@@ -366,33 +415,52 @@ public:
 	/// <param name="original"></param>
 	/// <param name="o"></param>
 	/// <returns></returns>
-	Curve trim(std::vector<SegmentUntrim>& original, float o);
+	Curve trim(std::vector<SegmentUntrim>& original, geometry::real o);
 
 	/// <summary>
 	/// Split the curve into several parts following the self intersections points detected
 	/// </summary>
+	/// <param name="sweep">if true, candidate segments are found with a sweep-line, otherwise with the spatial index</param>
 	/// <returns></returns>
-	std::vector<Curve> split_at_intersections();
+	std::vector<Curve> split_at_intersections(bool sweep = true);
 
-	bool too_small(float o);
+	bool too_small(geometry::real o);
 
-	bool too_close(Curve& test, float o);
-	bool too_close2(Curve& test, float o);
+	bool too_close(Curve& test, geometry::real o);
+	bool too_close2(Curve& test, geometry::real o);
 
 	bool curve_intersect(Curve& test);
 
-	std::vector<Segment> search(geometry::rectangle bounds);
+	/// <summary>
+	/// Write to out the index of the segments whose bounds match bounds. The spatial index is built on first call
+	/// </summary>
+	template<class OutputIt> OutputIt search(const geometry::rectangle& bounds, OutputIt out) { return tree().search(bounds, out); }
+
+	/// <summary>
+	/// Call visitor(index) for the segments whose bounds match bounds, until visitor returns false
+	/// </summary>
+	template<class F> bool visit(const geometry::rectangle& bounds, F visitor) { return tree().visit(bounds, visitor); }
 
 	static void sort_level(std::vector<Curve>& curves);
 
 private:
 
+	/// <summary>
+	/// Return the segments spatial index, built if needed
+	/// </summary>
+	PackedRTree& tree();
+
+	/// <summary>
+	/// Return the structure of arrays view of the segments, built if needed
+	/// </summary>
+	CurveView& view();
+
 	/// <summary>
 	/// Internal purpose
 	/// Return curve area without arc interpolation for clockwise computing. if area < 0, then clockwise
 	/// </summary>
 	/// <returns></returns>
-	float limited_area();
+	geometry::real limited_area();
 
 	/// <summary>
 	/// Return the result of union/intersection/substraction using Weiler algorythm
@@ -411,12 +479,23 @@ struct TreeCurve
 	std::vector<TreeCurve*> children;
 	void add(TreeCurve* c);
 	void sort();
+
+	/// <summary>
+	/// Same hierarchy as sort, children are moved under the smallest curve that contains them.
+	/// Candidate parents come from a spatial index on the curve bounds, so it stays fast with thousands of curves
+	/// </summary>
+	void nest();
 	void cw_all(bool direction);
 	void cw_alter();
 	void cw_alter(bool direction);
 	TreeCurve(Curve* c);
 	TreeCurve(std::vector<Curve>& curves);
 	~TreeCurve();
+
+	/// <summary>
+	/// Return a deep copy of the tree, curves included
+	/// </summary>
+	TreeCurve* copy();
 	size_t size();
 	std::vector<Curve> curves();
 
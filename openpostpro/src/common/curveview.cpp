@@ -0,0 +1,245 @@
+#include <curveview.h>
+#include <curve.h>
+#include <simd.h>
+#include <limits>
+
+void CurveView::reset()
+{
+	_data.clear();
+	_flags.clear();
+	x = y = cx = cy = r = left = bottom = right = top = mx = my = nullptr;
+	flags = nullptr;
+	px.clear();
+	py.clear();
+	_size = 0;
+	_created = false;
+	_middles = false;
+	_outlined = false;
+	_indexed = false;
+	_slab_first.clear();
+	_sx1.clear();
+	_sy1.clear();
+	_sx2.clear();
+	_sy2.clear();
+}
+
+void CurveView::create(Curve& c)
+{
+	reset();
+
+	c.bounds();
+
+	size_t n = c.size();
+	_data.resize(11 * n + 2);
+	_flags.resize(n);
+
+	x = _data.data();
+	y = x + n + 1;
+	cx = y + n + 1;
+	cy = cx + n;
+	r = cy + n;
+	left = r + n;
+	bottom = left + n;
+	right = bottom + n;
+	top = right + n;
+	mx = top + n;
+	my = mx + n;
+	flags = _flags.data();
+
+	for (size_t i = 0; i < n; i++)
+	{
+		Segment& s = c[i];
+		x[i] = s.point.x;
+		y[i] = s.point.y;
+		cx[i] = s.center.x;
+		cy[i] = s.center.y;
+		r[i] = s.radius;
+		left[i] = s.bounds.top_left.x;
+		top[i] = s.bounds.top_left.y;
+		right[i] = s.bounds.bottom_right.x;
+		bottom[i] = s.bounds.bottom_right.y;
+		flags[i] = (s.type == SegmentType::Arc ? arc : 0) | (s.type == SegmentType::Circle ? circle : 0) | (s.cw ? cw : 0);
+	}
+
+	if (n > 0)
+	{
+		x[n] = x[0];
+		y[n] = y[0];
+	}
+
+	_size = n;
+	_created = true;
+}
+
+void CurveView::middles(Curve& c)
+{
+	for (size_t i = 0; i < _size; i++)
+	{
+		Segment& s = c[i];
+		geometry::rvec2 dst = geometry::rvec2(x[i + 1], y[i + 1]);
+		geometry::rvec2 m = s.type == SegmentType::Line ? geometry::middle(s.point, dst) : geometry::arc_middle(s.point, s.center, dst, s.cw);
+		mx[i] = m.x;
+		my[i] = m.y;
+	}
+
+	_middles = true;
+}
+
+void CurveView::outline(Curve& c)
+{
+	px.clear();
+	py.clear();
+
+	// same points as Curve::inside used to build, arcs are replaced by their points
+	size_t n = c.size();
+	for (size_t i = 0; i < n; i++)
+	{
+		Segment& s = c[i];
+		if (s.type == SegmentType::Line)
+		{
+			px.push_back(s.point.x);
+			py.push_back(s.point.y);
+		}
+		else
+		{
+			geometry::rvec2 dst = c[i < n - 1 ? i + 1 : 0].point;
+			auto points = geometry::arc(s.point, s.center, dst, s.cw);
+			for (auto& p : points)
+			{
+				px.push_back(p.x);
+				py.push_back(p.y);
+			}
+		}
+	}
+
+	// the outline is closed, the last point is the first one
+	if (px.size() > 0 && (px.front() != px.back() || py.front() != py.back()))
+	{
+		px.push_back(px.front());
+		py.push_back(py.front());
+	}
+
+	_left = _bottom = std::numeric_limits<geometry::real>::max();
+	_right = _top = -std::numeric_limits<geometry::real>::max();
+	for (size_t i = 0; i < px.size(); i++)
+	{
+		_left = glm::min(_left, px[i]);
+		_bottom = glm::min(_bottom, py[i]);
+		_right = glm::max(_right, px[i]);
+		_top = glm::max(_top, py[i]);
+	}
+
+	_outlined = true;
+}
+
+int CurveView::slab(geometry::real y) const
+{
+	int k = (int)((y - _bottom) * _scale);
+	return glm::clamp(k, 0, (int)_slab_first.size() - 2);
+}
+
+size_t CurveView::slab_edges() const
+{
+	size_t total = 0;
+	for (size_t i = 0; i + 1 < px.size(); i++)
+		if (py[i] != py[i + 1])
+			total += slab(glm::max(py[i], py[i + 1])) - slab(glm::min(py[i], py[i + 1])) + 1;
+	return total;
+}
+
+void CurveView::index()
+{
+	size_t n = px.size() < 2 ? 0 : px.size() - 1;
+
+	// about 4 edges per slab, with fewer slabs when long edges would be copied in too many of them
+	int count = (int)glm::clamp(n / 4, (size_t)1, (size_t)4096);
+	for (;;)
+	{
+		_scale = _top > _bottom ? count / (_top - _bottom) : 0;
+		_slab_first.assign(count + 1, 0);
+		if (count == 1 || slab_edges() <= 8 * n)
+			break;
+		count /= 2;
+	}
+
+	// horizontal edges are never crossed by the ray, they are left out
+	for (size_t i = 0; i < n; i++)
+		if (py[i] != py[i + 1])
+			for (int k = slab(glm::min(py[i], py[i + 1])), last = slab(glm::max(py[i], py[i + 1])); k <= last; k++)
+				_slab_first[k + 1]++;
+
+	for (int k = 0; k < count; k++)
+		_slab_first[k + 1] += _slab_first[k];
+
+	size_t total = _slab_first[count];
+	_sx1.resize(total);
+	_sy1.resize(total);
+	_sx2.resize(total);
+	_sy2.resize(total);
+
+	std::vector<int> next(_slab_first.begin(), _slab_first.end() - 1);
+	for (size_t i = 0; i < n; i++)
+		if (py[i] != py[i + 1])
+			for (int k = slab(glm::min(py[i], py[i + 1])), last = slab(glm::max(py[i], py[i + 1])); k <= last; k++)
+			{
+				int e = next[k]++;
+				_sx1[e] = px[i];
+				_sy1[e] = py[i];
+				_sx2[e] = px[i + 1];
+				_sy2[e] = py[i + 1];
+			}
+
+	_indexed = true;
+}
+
+void CurveView::hits(int i, const int* indices, size_t count, uint8_t* result) const
+{
+	geometry::real box[4] = { left[i], bottom[i], right[i], top[i] };
+	Simd::hits(box, left, bottom, right, top, indices, count, result);
+}
+
+void CurveView::straddle(int i, const int* indices, size_t count, uint8_t* result) const
+{
+	// the intersection of two lines is accepted up to ERR_FLOAT3 out of the segments,
+	// a segment farther than twice this distance from the other line can not be accepted
+	const size_t block = 64;
+	int lines[block];
+	uint8_t crossing[block];
+
+	for (size_t k = 0; k < count; k += block)
+	{
+		size_t m = glm::min(block, count - k), n = 0;
+		for (size_t b = 0; b < m; b++)
+			if (line(indices[k + b]))
+				lines[n++] = indices[k + b];
+
+		Simd::straddle(geometry::rvec2(x[i], y[i]), geometry::rvec2(x[i + 1], y[i + 1]), x, y, lines, n, 2 * geometry::ERR_FLOAT3, crossing);
+
+		n = 0;
+		for (size_t b = 0; b < m; b++)
+			if (line(indices[k + b]))
+				result[k + b] &= crossing[n++];
+	}
+}
+
+bool CurveView::near(const int* indices, size_t count, const geometry::real* qx, const geometry::real* qy, int points, geometry::real d2) const
+{
+	return Simd::near(x, y, mx, my, indices, count, qx, qy, points, d2);
+}
+
+bool CurveView::inside(geometry::rvec2 p) const
+{
+	// no edge can flip the result above, below or on the right of the outline
+	if (px.size() < 2 || p.y > _top || p.y <= _bottom || p.x > _right)
+		return false;
+
+	// p.y is in the slab range, edges out of the slab of p can not be crossed by its ray
+	if (_indexed)
+	{
+		int k = slab(p.y);
+		size_t first = _slab_first[k];
+		return (Simd::crossings(_sx1.data() + first, _sy1.data() + first, _sx2.data() + first, _sy2.data() + first, _slab_first[k + 1] - first, p) & 1) != 0;
+	}
+
+	return (Simd::crossings(px.data(), py.data(), px.data() + 1, py.data() + 1, px.size() - 1, p) & 1) != 0;
+}
@@ -0,0 +1,142 @@
+#pragma once
+#ifndef CURVEVIEW_H
+#define CURVEVIEW_H
+
+#include <geometry.h>
+#include <vector>
+#include <cstdint>
+
+class Curve;
+
+/// <summary>
+/// Structure of arrays copy of the geometry of a curve, for the intersection, distance and inside loops.
+/// Segment i goes from (x[i], y[i]) to (x[i + 1], y[i + 1]), the last segment goes back to the first point.
+/// The arrays share one buffer and each one is contiguous so the kernels below are plain loops without branches that the compiler can vectorize.
+/// The view is built once per curve and must be reset when the curve is modified.
+/// </summary>
+class CurveView
+{
+public:
+	enum Flags : uint8_t
+	{
+		arc = 1,
+		cw = 2,
+		circle = 4
+	};
+
+	// arrays of the same buffer
+	geometry::real* x = nullptr;		// size + 1
+	geometry::real* y = nullptr;
+	geometry::real* cx = nullptr;
+	geometry::real* cy = nullptr;
+	geometry::real* r = nullptr;
+	geometry::real* left = nullptr;		// segment bounds
+	geometry::real* bottom = nullptr;
+	geometry::real* right = nullptr;
+	geometry::real* top = nullptr;
+	geometry::real* mx = nullptr;		// segment middle, built on demand
+	geometry::real* my = nullptr;
+	uint8_t* flags = nullptr;
+
+	std::vector<geometry::real> px;		// outline with arcs as points, for inside, closed, built on demand
+	std::vector<geometry::real> py;
+
+private:
+	std::vector<geometry::real> _data;
+	std::vector<uint8_t> _flags;
+	size_t _size = 0;
+	bool _created = false;
+	bool _middles = false;
+	bool _outlined = false;
+	bool _indexed = false;
+	geometry::real _left = 0;			// outline bounds
+	geometry::real _bottom = 0;
+	geometry::real _right = 0;
+	geometry::real _top = 0;
+
+	// outline edges sorted in horizontal slabs, edges of slab k are [_slab_first[k], _slab_first[k + 1]),
+	// an edge is copied in every slab it crosses
+	geometry::real _scale = 0;			// slabs per unit of height
+	std::vector<int> _slab_first;
+	std::vector<geometry::real> _sx1;
+	std::vector<geometry::real> _sy1;
+	std::vector<geometry::real> _sx2;
+	std::vector<geometry::real> _sy2;
+
+	int slab(geometry::real y) const;
+	size_t slab_edges() const;
+
+public:
+	CurveView() {}
+
+	/// <summary>
+	/// A copy is empty, curves are copied far more often than they are tested, the view is built again when needed.
+	/// A move is empty too and does not throw, so vectors of curves move them when they grow
+	/// </summary>
+	CurveView(const CurveView&) {}
+	CurveView(CurveView&&) noexcept {}
+	CurveView& operator=(const CurveView&) { reset(); return *this; }
+	CurveView& operator=(CurveView&&) noexcept { reset(); return *this; }
+
+	bool created() const { return _created; }
+	bool middles() const { return _middles; }
+	bool outlined() const { return _outlined; }
+	bool indexed() const { return _indexed; }
+
+	/// <summary>
+	/// Number of segments
+	/// </summary>
+	size_t size() const { return _size; }
+
+	/// <summary>
+	/// Clear the view, memory is kept for the next create
+	/// </summary>
+	void reset();
+
+	/// <summary>
+	/// Copy the geometry of c, segment bounds are computed by the curve
+	/// </summary>
+	void create(Curve& c);
+
+	/// <summary>
+	/// Compute the segment middles used by near, arcs need trigonometry so it is only done when needed
+	/// </summary>
+	void middles(Curve& c);
+
+	/// <summary>
+	/// Build the outline used by inside, arcs are interpolated so it is only done when needed
+	/// </summary>
+	void outline(Curve& c);
+
+	/// <summary>
+	/// Sort the edges of the outline in horizontal slabs, inside then only tests the edges of the slab of the point.
+	/// The outline must be built, it is worth it when the curve is tested many times
+	/// </summary>
+	void index();
+
+	bool line(int i) const { return (flags[i] & (arc | circle)) == 0; }
+
+	/// <summary>
+	/// result[k] = 1 if the bounds of i and of indices[k] match, same rule as rectangle and spatial index :
+	/// one contains the other or they intersect
+	/// </summary>
+	void hits(int i, const int* indices, size_t count, uint8_t* result) const;
+
+	/// <summary>
+	/// result[k] = 0 if line segments i and indices[k] are too far apart to intersect, unchanged if they have to be tested.
+	/// Segment i must be a line, result is not changed for the curved candidates
+	/// </summary>
+	void straddle(int i, const int* indices, size_t count, uint8_t* result) const;
+
+	/// <summary>
+	/// Middles must be computed. Return true if the start, stop or middle point of one of the segments is closer than sqrt(d2) to one of the points (qx, qy)
+	/// </summary>
+	bool near(const int* indices, size_t count, const geometry::real* qx, const geometry::real* qy, int points, geometry::real d2) const;
+
+	/// <summary>
+	/// Ray casting over the outline, which must be built, or over the edges of one slab when it is indexed
+	/// </summary>
+	bool inside(geometry::rvec2 p) const;
+};
+
+#endif
@@ -252,4 +252,20 @@ namespace environment
 		return result.str();
 	}
 
+	void attach_console()
+	{
+#ifdef _WIN32
+		if (!AttachConsole(ATTACH_PARENT_PROCESS))
+			return;
+
+		FILE* f = nullptr;
+		if (_fileno(stdout) < 0)
+			freopen_s(&f, "CONOUT$", "w", stdout);
+		if (_fileno(stderr) < 0)
+			freopen_s(&f, "CONOUT$", "w", stderr);
+		std::cout.clear();
+		std::cerr.clear();
+#endif
+	}
+
 }
\ No newline at end of file
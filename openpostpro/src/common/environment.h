@@ -84,6 +84,11 @@ namespace environment
 	std::tm local_time(time_t timer);
 
 	const std::string current_date_time();
+
+	/// <summary>
+	/// Headless runs of the windows subsystem exe print to the console they are started from, unless redirected
+	/// </summary>
+	void attach_console();
 };
 
 #endif
\ No newline at end of file
@@ -7,8 +7,14 @@
 #ifndef _WIN32
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <unistd.h>
+#else
+#include <Windows.h>
 #endif
+#include <stdexcept>
+#include <algorithm>
 
 namespace file
 {
@@ -83,4 +89,181 @@ namespace file
 		else
 			return "";
 	}
+
+	Writer::Writer(std::string path, size_t capacity, bool threaded) : _capacity((std::max)(capacity, (size_t)4096)), _threaded(threaded)
+	{
+		// text mode, as write_all_text
+		_file.open(path, std::ios::out);
+		_buffer.reserve(_capacity);
+		if (_threaded && _file.is_open())
+			_thread = std::thread(&Writer::loop, this);
+	}
+
+	Writer::~Writer()
+	{
+		try
+		{
+			close();
+		}
+		catch (const std::exception&)
+		{
+		}
+	}
+
+	bool Writer::is_open()
+	{
+		return _file.is_open();
+	}
+
+	void Writer::write(const std::string& text)
+	{
+		_buffer += text;
+		_size += text.size();
+		if (_buffer.size() >= _capacity)
+			send();
+	}
+
+	void Writer::send()
+	{
+		if (_buffer.empty())
+			return;
+
+		if (_threaded)
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			// bounded : the producer waits while two buffers are pending
+			_condition.wait(lock, [this] { return _pending.size() < 2; });
+			_pending.push_back(std::move(_buffer));
+			_condition.notify_all();
+		}
+		else if ((size_t)_file.sputn(_buffer.data(), _buffer.size()) != _buffer.size())
+			_failed = true;
+
+		_buffer = std::string();
+		_buffer.reserve(_capacity);
+	}
+
+	void Writer::loop()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (true)
+		{
+			_condition.wait(lock, [this] { return _closing || !_pending.empty(); });
+			if (_pending.empty())
+				break;
+
+			std::string chunk = std::move(_pending.front());
+			_pending.pop_front();
+			_condition.notify_all();
+
+			lock.unlock();
+			bool failed = (size_t)_file.sputn(chunk.data(), chunk.size()) != chunk.size();
+			lock.lock();
+			_failed = _failed || failed;
+		}
+	}
+
+	void Writer::close()
+	{
+		if (!_file.is_open())
+			return;
+
+		send();
+		if (_thread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_closing = true;
+			}
+			_condition.notify_all();
+			_thread.join();
+		}
+		if (_file.close() == nullptr)
+			_failed = true;
+
+		if (_failed)
+			throw std::runtime_error("write failed");
+	}
+
+	Mapping::~Mapping()
+	{
+		close();
+	}
+
+	bool Mapping::open(std::string path)
+	{
+		close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileW(std::filesystem::path(path).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE map = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		const void* data = map != NULL ? MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0) : nullptr;
+		if (data == nullptr)
+		{
+			if (map != NULL)
+				CloseHandle(map);
+			CloseHandle(file);
+			return false;
+		}
+
+		_file = file;
+		_map = map;
+		_data = (const char*)data;
+		_size = (size_t)size.QuadPart;
+#else
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0)
+		{
+			::close(fd);
+			return false;
+		}
+
+		void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			::close(fd);
+			return false;
+		}
+
+		_fd = fd;
+		_data = (const char*)data;
+		_size = (size_t)st.st_size;
+#endif
+		return true;
+	}
+
+	void Mapping::close()
+	{
+#ifdef _WIN32
+		if (_data != nullptr)
+			UnmapViewOfFile(_data);
+		if (_map != nullptr)
+			CloseHandle(_map);
+		if (_file != nullptr)
+			CloseHandle(_file);
+		_file = _map = nullptr;
+#else
+		if (_data != nullptr)
+			munmap((void*)_data, _size);
+		if (_fd >= 0)
+			::close(_fd);
+		_fd = -1;
+#endif
+		_data = nullptr;
+		_size = 0;
+	}
 }
\ No newline at end of file
@@ -26,6 +26,8 @@
 
 /************************************************************************
 * methods to read/write text files in a single line
+* Writer streams large text files through a bounded buffer, Mapping
+* maps a file in memory to read it without loading it
 *************************************************************************/
 
 #pragma once
@@ -34,6 +36,11 @@
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace file
 {
@@ -44,6 +51,90 @@ namespace file
 	std::vector<std::string> read_all_lines(std::string path);
 
 	std::string read_all_text(std::string path);
+
+	/// <summary>
+	/// Text file written by chunks : the text is gathered in a buffer of capacity bytes, written when full.
+	/// When threaded, full buffers are written by a background thread, at most two of them waiting
+	/// </summary>
+	class Writer
+	{
+	private:
+		std::filebuf _file;
+		std::string _buffer;
+		size_t _capacity;
+		size_t _size = 0;
+		bool _threaded;
+		bool _failed = false;
+
+		std::thread _thread;
+		std::mutex _mutex;
+		std::condition_variable _condition;
+		std::deque<std::string> _pending;
+		bool _closing = false;
+
+		/// <summary>
+		/// Write the buffer, or hand it to the thread
+		/// </summary>
+		void send();
+
+		/// <summary>
+		/// Background thread, writes the pending buffers until closed
+		/// </summary>
+		void loop();
+
+	public:
+		Writer(std::string path, size_t capacity = 1 << 20, bool threaded = false);
+		~Writer();
+
+		Writer(const Writer&) = delete;
+		Writer& operator=(const Writer&) = delete;
+
+		bool is_open();
+
+		void write(const std::string& text);
+
+		/// <summary>
+		/// Write the remaining text and close the file. Throw a runtime_error if a write failed
+		/// </summary>
+		void close();
+
+		/// <summary>
+		/// Bytes written so far
+		/// </summary>
+		size_t size() { return _size; }
+	};
+
+	/// <summary>
+	/// Read only memory map of a whole file
+	/// </summary>
+	class Mapping
+	{
+	private:
+		const char* _data = nullptr;
+		size_t _size = 0;
+#ifdef _WIN32
+		void* _file = nullptr;
+		void* _map = nullptr;
+#else
+		int _fd = -1;
+#endif
+
+	public:
+		Mapping() {}
+		~Mapping();
+
+		Mapping(const Mapping&) = delete;
+		Mapping& operator=(const Mapping&) = delete;
+
+		/// <summary>
+		/// Map the file at path, false if it does not exist or is empty
+		/// </summary>
+		bool open(std::string path);
+		void close();
+
+		const char* data() { return _data; }
+		size_t size() { return _size; }
+	};
 };
 
 #endif
\ No newline at end of file
@@ -3,157 +3,232 @@
 #define FTREE_H
 
 #include <geometry.h>
-#include <list>
-
-
-template <class T> class SearchNode
+#include <stats.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+/// <summary>
+/// Static spatial index : a packed R-tree bulk loaded with the Sort-Tile-Recursive algorithm.
+/// Nodes are stored in a single contiguous array, children of a node are contiguous,
+/// and leaves only reference the index of the objects in the source container.
+/// The tree is built once from all the objects, searches do not allocate.
+/// </summary>
+class PackedRTree
 {
 public:
-	virtual void add(T data, geometry::rectangle& bounds) {}
-	virtual std::vector<T> search(geometry::rectangle& bounds) { return std::vector<T>(); }
-};
+	static const int node_size = 16;
 
+private:
+	struct Box
+	{
+		geometry::real left = 0;
+		geometry::real bottom = 0;
+		geometry::real right = 0;
+		geometry::real top = 0;
+	};
 
-template <class T> class QuadNode : public SearchNode<T>
-{
-private:		
-	geometry::rectangle _bounds;
-	std::vector<QuadNode<T>> _children;
-	geometry::rectangle _b0;
-	geometry::rectangle _b1;
-	geometry::rectangle _b2;
-	geometry::rectangle _b3;
-	std::vector<T> _objects;
-	std::vector<geometry::rectangle> _objects_bounds;
-	int _index = 0;
-	int _depth = 0;
+	struct Node
+	{
+		Box box;
+		int first = 0;		// first child in _nodes, or first entry in _items if leaf
+		int count = 0;
+		bool leaf = true;
+	};
+
+	std::vector<Node> _nodes;
+	std::vector<Box> _boxes;	// object bounds, in leaf order
+	std::vector<int> _items;	// object index, in leaf order
+	int _root = -1;
 	bool _created = false;
 
-	void check_children();
+	static Box box(const geometry::rectangle& r) { return Box{ r.top_left.x, r.bottom_right.y, r.bottom_right.x, r.top_left.y }; }
 
-public:
-	bool created() { return _created; }
-
-	void create(geometry::rectangle& bounds, int index = 0, int depth = 100);
-	void reset();
-	void add(T data, geometry::rectangle& bounds) override;
-	std::vector<T> search(geometry::rectangle& bounds) override;
-};
-
-
-template<class T>
-inline void QuadNode<T>::check_children()
-{
-	if (_children.size() == 0) {
-		_children.push_back(QuadNode<T>());
-		_children.back().create(_b0, _index + 1, _depth);
-		_children.push_back(QuadNode<T>());
-		_children.back().create(_b1, _index + 1, _depth);
-		_children.push_back(QuadNode<T>());
-		_children.back().create(_b2, _index + 1, _depth);
-		_children.push_back(QuadNode<T>());
-		_children.back().create(_b3, _index + 1, _depth);
+	static void merge(Box& a, const Box& b)
+	{
+		a.left = glm::min(a.left, b.left);
+		a.bottom = glm::min(a.bottom, b.bottom);
+		a.right = glm::max(a.right, b.right);
+		a.top = glm::max(a.top, b.top);
 	}
-}
-
-
-//template<class T>
-//inline void QuadNode<T>::create(glm::vec2& top_left, glm::vec2& bottom_right, int index, int depth)
-//{
-//	_bounds = geometry::rectangle(top_left, bottom_right);
-//	create(_bounds, index, depth);
-//}
-
-template<class T>
-inline void QuadNode<T>::create(geometry::rectangle& bounds, int index, int depth)
-{
-	_depth = depth;
-	_bounds = bounds;
-
-	float w = bounds.width() / 2;
-	float h = bounds.height() / 2;
 
-	_b0 = geometry::rectangle(bounds.left(), bounds.top(), bounds.left() + w, bounds.bottom() + h);
-	_b1 = geometry::rectangle(bounds.left() + w, bounds.top(), bounds.right(), bounds.bottom() + h);
-	_b2 = geometry::rectangle(bounds.left(), bounds.bottom() + h, bounds.left() + w, bounds.bottom());
-	_b3 = geometry::rectangle(bounds.left() + w, bounds.bottom() + h, bounds.right(), bounds.bottom());
+	/// <summary>
+	/// node pruning, closed overlap
+	/// </summary>
+	static bool overlap(const Box& a, const Box& b)
+	{
+		return !(a.right < b.left || a.left > b.right || a.top < b.bottom || a.bottom > b.top);
+	}
 
-	_index = index;
+	/// <summary>
+	/// object test, same rule as rectangle : r contains q, r intersects q or q contains r
+	/// </summary>
+	static bool hit(const Box& r, const Box& q)
+	{
+		if (q.left >= r.left && q.right <= r.right && q.bottom >= r.bottom && q.top <= r.top)
+			return true;
+		if (r.left < q.right && r.right > q.left && r.top > q.bottom && r.bottom < q.top)
+			return true;
+		return r.left >= q.left && r.right <= q.right && r.bottom >= q.bottom && r.top <= q.top;
+	}
 
-	_created = true;
-}
+	/// <summary>
+	/// Sort-Tile-Recursive ordering : sort by x center, cut into vertical slices, sort each slice by y center
+	/// </summary>
+	template<class E, class F> static void str_sort(std::vector<E>& entries, F box_of)
+	{
+		size_t n = entries.size();
+		size_t leaves = (n + node_size - 1) / node_size;
+		size_t slices = (size_t)std::ceil(std::sqrt((double)leaves));
+		size_t slice = slices * node_size;
+
+		std::sort(entries.begin(), entries.end(), [&](const E& a, const E& b) {
+			const Box& ba = box_of(a), & bb = box_of(b);
+			return ba.left + ba.right < bb.left + bb.right;
+			});
+
+		for (size_t i = 0; i < n; i += slice)
+			std::sort(entries.begin() + i, entries.begin() + glm::min(n, i + slice), [&](const E& a, const E& b) {
+				const Box& ba = box_of(a), & bb = box_of(b);
+				return ba.bottom + ba.top < bb.bottom + bb.top;
+				});
+	}
 
-template<class T>
-inline void QuadNode<T>::reset()
-{
-	_created = false;
-	for (auto c : _children)
-		c.reset();
-	_objects.clear();
-	_objects_bounds.clear();
-	_children.clear();
-}
-
-template<class T>
-inline void QuadNode<T>::add(T data, geometry::rectangle& bounds)
-{
-	if (_index < _depth)
+	template<class F> bool visit(int node, const Box& q, F& visitor) const
 	{
-		if (_b0.contains(bounds)) {
-			check_children();
-			_children[0].add(data, bounds);
-		}
-		else if (_b1.contains(bounds)) {
-			check_children();
-			_children[1].add(data, bounds);
-		}
-		else if (_b2.contains(bounds)) {
-			check_children();
-			_children[2].add(data, bounds);
-		}
-		else if (_b3.contains(bounds)) {
-			check_children();
-			_children[3].add(data, bounds);
+		const Node& n = _nodes[node];
+		Stats::add(Stats::nodes_visited);
+		if (n.leaf)
+		{
+			for (int i = n.first; i < n.first + n.count; i++)
+				if (hit(_boxes[i], q))
+				{
+					Stats::add(Stats::candidates);
+					if (!visitor(_items[i]))
+						return false;
+				}
 		}
-		else {
-			_objects.push_back(data);
-			_objects_bounds.push_back(bounds);
+		else
+		{
+			for (int i = n.first; i < n.first + n.count; i++)
+				if (overlap(_nodes[i].box, q) && !visit(i, q, visitor))
+					return false;
 		}
+		return true;
 	}
-	else
-	{
-		_objects.push_back(data);
-		_objects_bounds.push_back(bounds);
-	}
-}
 
-template<class T>
-inline std::vector<T> QuadNode<T>::search(geometry::rectangle& bounds)
-{
-	std::vector<T> result;
+public:
+	bool created() const { return _created; }
 
-	if (_bounds.contains(bounds) || _bounds.intersect(bounds) || bounds.contains(_bounds)) {
-		if (_children.size() == 4) {
-			auto c0 = _children[0].search(bounds);
-			result.insert(result.end(), c0.begin(), c0.end());
+	/// <summary>
+	/// Number of indexed objects
+	/// </summary>
+	size_t size() const { return _items.size(); }
 
-			auto c1 = _children[1].search(bounds);
-			result.insert(result.end(), c1.begin(), c1.end());
+	/// <summary>
+	/// Clear the tree, memory is kept for the next create
+	/// </summary>
+	void reset()
+	{
+		_nodes.clear();
+		_boxes.clear();
+		_items.clear();
+		_root = -1;
+		_created = false;
+	}
 
-			auto c2 = _children[2].search(bounds);
-			result.insert(result.end(), c2.begin(), c2.end());
+	/// <summary>
+	/// Bulk load the tree. bounds(object) must return the geometry::rectangle of the object.
+	/// Searches will return the index of the object in objects
+	/// </summary>
+	template<class C, class F> void create(C& objects, F bounds)
+	{
+		reset();
+
+		std::vector<std::pair<Box, int>> entries;
+		entries.reserve(objects.size());
+		int index = 0;
+		for (auto& o : objects)
+			entries.push_back(std::make_pair(box(bounds(o)), index++));
+
+		_created = true;
+		if (entries.size() == 0)
+			return;
+
+		str_sort(entries, [](const std::pair<Box, int>& e) -> const Box& { return e.first; });
+
+		_boxes.reserve(entries.size());
+		_items.reserve(entries.size());
+		for (auto& e : entries)
+		{
+			_boxes.push_back(e.first);
+			_items.push_back(e.second);
+		}
 
-			auto c3 = _children[3].search(bounds);
-			result.insert(result.end(), c3.begin(), c3.end());
+		// leaves
+		std::vector<Node> level;
+		level.reserve((entries.size() + node_size - 1) / node_size);
+		for (int i = 0; i < (int)entries.size(); i += node_size)
+		{
+			Node n;
+			n.first = i;
+			n.count = glm::min(node_size, (int)entries.size() - i);
+			n.box = _boxes[i];
+			for (int j = i + 1; j < i + n.count; j++)
+				merge(n.box, _boxes[j]);
+			level.push_back(n);
 		}
-		for (int i = 0; i < _objects_bounds.size(); i++) {
-			geometry::rectangle r = _objects_bounds[i];
-			if (r.contains(bounds) || r.intersect(bounds) || bounds.contains(r))
-				result.push_back(_objects[i]);
+
+		// upper levels, children of each parent are stored contiguously
+		_nodes.reserve(level.size() * node_size / (node_size - 1) + 1);
+		while (level.size() > 1)
+		{
+			str_sort(level, [](const Node& n) -> const Box& { return n.box; });
+
+			int start = (int)_nodes.size();
+			_nodes.insert(_nodes.end(), level.begin(), level.end());
+
+			std::vector<Node> parents;
+			parents.reserve((level.size() + node_size - 1) / node_size);
+			for (int i = 0; i < (int)level.size(); i += node_size)
+			{
+				Node n;
+				n.leaf = false;
+				n.first = start + i;
+				n.count = glm::min(node_size, (int)level.size() - i);
+				n.box = level[i].box;
+				for (int j = i + 1; j < i + n.count; j++)
+					merge(n.box, level[j].box);
+				parents.push_back(n);
+			}
+			level.swap(parents);
 		}
+
+		_nodes.push_back(level[0]);
+		_root = (int)_nodes.size() - 1;
 	}
 
-	return result;
-}
+	/// <summary>
+	/// Call visitor(index) for each object whose bounds match the search bounds.
+	/// Stop the search as soon as visitor returns false
+	/// </summary>
+	/// <returns>false if the search has been stopped by the visitor</returns>
+	template<class F> bool visit(const geometry::rectangle& bounds, F visitor) const
+	{
+		if (_root < 0)
+			return true;
+		Box q = box(bounds);
+		return visit(_root, q, visitor);
+	}
+
+	/// <summary>
+	/// Write the index of each object whose bounds match the search bounds to out
+	/// </summary>
+	template<class OutputIt> OutputIt search(const geometry::rectangle& bounds, OutputIt out) const
+	{
+		visit(bounds, [&out](int index) { *out++ = index; return true; });
+		return out;
+	}
+};
 
 #endif
@@ -7,14 +7,14 @@ namespace geometry
 /// </summary>
 /// <param name="p">Point to test</param>
 /// <returns>Angle in radiant</returns>
-float angle(glm::vec2 p)
+real angle(rvec2 p)
 {
 	if (p.x == 0)
 	{
 		if (p.y > 0)
-			return glm::half_pi<float>();
+			return glm::half_pi<real>();
 		else
-			return glm::pi<float>() + glm::half_pi<float>();
+			return glm::pi<real>() + glm::half_pi<real>();
 	}
 	else
 		return glm::atan(p.y, p.x);
@@ -26,12 +26,12 @@ float angle(glm::vec2 p)
 /// <param name="p">Point to test</param>
 /// <param name="center">offset center</param>
 /// <returns>Angle in radiant</returns>
-float angle(glm::vec2 p, glm::vec2 origin)
+real angle(rvec2 p, rvec2 origin)
 {
 	return angle(p - origin);
 }
 
-float oriented_angle(glm::vec2 p1, glm::vec2 p2, glm::vec2 origin)
+real oriented_angle(rvec2 p1, rvec2 p2, rvec2 origin)
 {
 	auto cross = (p1.x-origin.x)*(p2.y-origin.y) - (p2.x - origin.x) * (p1.y - origin.y);
 	auto cw = cross > 0;
@@ -43,12 +43,12 @@ float oriented_angle(glm::vec2 p1, glm::vec2 p2, glm::vec2 origin)
 /// </summary>
 /// <param name="radian">angle</param>
 /// <returns></returns>
-float oriented_angle(float radian)
+real oriented_angle(real radian)
 {
-	while (radian > glm::two_pi<float>())
-		radian -= glm::two_pi<float>();
+	while (radian > glm::two_pi<real>())
+		radian -= glm::two_pi<real>();
 	while (radian < 0)
-		radian += glm::two_pi<float>();
+		radian += glm::two_pi<real>();
 	return radian;
 }
 
@@ -57,14 +57,14 @@ float oriented_angle(float radian)
 /// </summary>
 /// <param name="p">Coordinates to test. Origin is (0,0).</param>
 /// <returns></returns>
-float oriented_angle(glm::vec2 p)
+real oriented_angle(rvec2 p)
 {
 	if (p.x == 0)
 	{
 		if (p.y > 0)
-			return glm::half_pi<float>();
+			return glm::half_pi<real>();
 		else
-			return glm::pi<float>() + glm::half_pi<float>();
+			return glm::pi<real>() + glm::half_pi<real>();
 	}
 
 	return oriented_angle(glm::atan(p.y, p.x));
@@ -76,39 +76,39 @@ float oriented_angle(glm::vec2 p)
 /// <param name="p">Coordinates to test</param>
 /// <param name="origin"></param>
 /// <returns></returns>
-float oriented_angle(glm::vec2 p, glm::vec2 origin)
+real oriented_angle(rvec2 p, rvec2 origin)
 {
 	return oriented_angle(p - origin);
 }
 
 
-float oriented_angle(float a_start, float a_stop, bool cw)
+real oriented_angle(real a_start, real a_stop, bool cw)
 {
-	float angle = 0;
+	real angle = 0;
 	if (cw)
 	{
 		if (a_start > a_stop)
 			angle = a_start - a_stop;
 		else
-			angle = a_start + glm::two_pi<float>() - a_stop;
+			angle = a_start + glm::two_pi<real>() - a_stop;
 	}
 	else
 	{
 		if (a_stop > a_start)
 			angle = a_stop - a_start;
 		else
-			angle = glm::two_pi<float>() - a_start + a_stop;
+			angle = glm::two_pi<real>() - a_start + a_stop;
 	}
 
 	return angle;
 }
 
-float oriented_angle(glm::vec2 p1, glm::vec2 p2, bool cw)
+real oriented_angle(rvec2 p1, rvec2 p2, bool cw)
 {
-	return oriented_angle(p1, p2, geometry::vec2_empty, cw);
+	return oriented_angle(p1, p2, geometry::rvec2_empty, cw);
 }
 
-float oriented_angle(glm::vec2 p1, glm::vec2 p2, glm::vec2 origin, bool cw)
+real oriented_angle(rvec2 p1, rvec2 p2, rvec2 origin, bool cw)
 {
 	auto a_start = geometry::oriented_angle(geometry::oriented_angle(p1, origin));
 	auto a_stop = geometry::oriented_angle(geometry::oriented_angle(p2, origin));
@@ -122,10 +122,10 @@ float oriented_angle(glm::vec2 p1, glm::vec2 p2, glm::vec2 origin, bool cw)
 /// <param name="p1">first ref_point</param>
 /// <param name="p2">second ref_point</param>
 /// <returns>the square distance</returns>
-float distance(glm::vec2 p1, glm::vec2 p2)
+real distance(rvec2 p1, rvec2 p2)
 {
-	float dx = p1.x - p2.x;
-	float dy = p1.y - p2.y;
+	real dx = p1.x - p2.x;
+	real dy = p1.y - p2.y;
 	return glm::sqrt(dx * dx + dy * dy);
 }
 
@@ -135,10 +135,10 @@ float distance(glm::vec2 p1, glm::vec2 p2)
 /// <param name="p1">first ref_point</param>
 /// <param name="p2">second ref_point</param>
 /// <returns>the square distance</returns>
-float distance2(glm::vec2 p1, glm::vec2 p2)
+real distance2(rvec2 p1, rvec2 p2)
 {
-	float dx = p1.x - p2.x;
-	float dy = p1.y - p2.y;
+	real dx = p1.x - p2.x;
+	real dy = p1.y - p2.y;
 	return dx * dx + dy * dy;
 }
 
@@ -149,7 +149,7 @@ float distance2(glm::vec2 p1, glm::vec2 p2)
 /// <param name="p2"></param>
 /// <param name="ref_point"></param>
 /// <returns></returns>
-float foretriangle2(glm::vec2 p1, glm::vec2 p2, glm::vec2 point)
+real foretriangle2(rvec2 p1, rvec2 p2, rvec2 point)
 {
 	// vertical
 	if (glm::abs(p1.x - p2.x) < geometry::ERR_FLOAT3)
@@ -171,7 +171,7 @@ float foretriangle2(glm::vec2 p1, glm::vec2 p2, glm::vec2 point)
 /// <param name="p2"></param>
 /// <param name="ref_point"></param>
 /// <returns></returns>
-float foretriangle(glm::vec2& p1, glm::vec2& p2, glm::vec2& point)
+real foretriangle(const rvec2& p1, const rvec2& p2, const rvec2& point)
 {
 	// vertical
 	if (glm::abs(p1.x - p2.x) < geometry::ERR_FLOAT3)
@@ -191,17 +191,17 @@ float foretriangle(glm::vec2& p1, glm::vec2& p2, glm::vec2& point)
 /// <param name="bottom_right"></param>
 /// <param name="ref_point"></param>
 /// <returns></returns>
-bool rectangle_contains(glm::vec2& top_left, glm::vec2& bottom_right, glm::vec2& point)
+bool rectangle_contains(const rvec2& top_left, const rvec2& bottom_right, const rvec2& point)
 {
 	return (point.x >= top_left.x && point.x <= bottom_right.x && point.y >= bottom_right.y && point.y <= top_left.y);
 }
 
-bool rectangle_contains(rectangle& r, glm::vec2& point)
+bool rectangle_contains(rectangle& r, const rvec2& point)
 {
 	return (point.x >= r.top_left.x && point.x <= r.bottom_right.x && point.y >= r.bottom_right.y && point.y <= r.top_left.y);
 }
 
-bool rectangle_contains(float top, float left, float bottom, float right, glm::vec2& point)
+bool rectangle_contains(real top, real left, real bottom, real right, const rvec2& point)
 {
 	return (point.x >= left && point.x <= right && point.y >= bottom && point.y <= top);
 }
@@ -214,7 +214,7 @@ bool rectangle_contains(float top, float left, float bottom, float right, glm::v
 /// <param name="top_left2"></param>
 /// <param name="bottom_right2"></param>
 /// <returns></returns>
-bool rectangle_contains(glm::vec2& top_left1, glm::vec2& bottom_right1, glm::vec2& top_left2, glm::vec2& bottom_right2)
+bool rectangle_contains(const rvec2& top_left1, const rvec2& bottom_right1, const rvec2& top_left2, const rvec2& bottom_right2)
 {
 	// check if 2 is outside 1
 	return rectangle_contains(top_left1, bottom_right1, top_left2) && rectangle_contains(top_left1, bottom_right1, bottom_right2);
@@ -225,7 +225,7 @@ bool rectangle_contains(rectangle& r1, rectangle& r2)
 	return rectangle_contains(r1.top_left, r1.bottom_right, r2.top_left) && rectangle_contains(r1.top_left, r1.bottom_right, r2.bottom_right);
 }
 
-bool rectangle_intersect(glm::vec2& top_left1, glm::vec2& bottom_right1, glm::vec2& top_left2, glm::vec2& bottom_right2)
+bool rectangle_intersect(const rvec2& top_left1, const rvec2& bottom_right1, const rvec2& top_left2, const rvec2& bottom_right2)
 {
 	// check if 2 is outside 1
 	return (top_left1.x < bottom_right2.x && bottom_right1.x > top_left2.x && top_left1.y > bottom_right2.y && bottom_right1.y < top_left2.y);
@@ -236,7 +236,7 @@ bool rectangle_intersect(rectangle& r1, rectangle& r2)
 	return (r1.top_left.x < r2.bottom_right.x && r1.bottom_right.x > r2.top_left.x && r1.top_left.y > r2.bottom_right.y && r1.bottom_right.y < r2.top_left.y);
 }
 
-bool rectangle_outside(glm::vec2& top_left1, glm::vec2& bottom_right1, glm::vec2& top_left2, glm::vec2& bottom_right2)
+bool rectangle_outside(const rvec2& top_left1, const rvec2& bottom_right1, const rvec2& top_left2, const rvec2& bottom_right2)
 {
 	if (top_left1.y < bottom_right2.y ||	// rect2 over rect1
 		bottom_right1.y > top_left2.y ||	// rect2 under rect 1
@@ -423,20 +423,20 @@ std::vector<glm::vec2> bezier_from_QBSpline(std::vector<glm::vec2> spline)
 	return vertices;
 }
 
-rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw)
+rectangle arc_bounds(rvec2 start, rvec2 center, rvec2 stop, bool cw)
 {
-	float radius = geometry::distance(start, center);
+	real radius = geometry::distance(start, center);
 
 	return arc_bounds(start, center, stop, radius, cw);
 }
 
-rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw)
+rectangle arc_bounds(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw)
 {
 	rectangle result;
 
-	float start_a = geometry::oriented_angle(start, center);
-	float stop_a = geometry::oriented_angle(stop, center);
-	float three_forth_pi = glm::half_pi<float>() + glm::pi<float>();
+	real start_a = geometry::oriented_angle(start, center);
+	real stop_a = geometry::oriented_angle(stop, center);
+	real three_forth_pi = glm::half_pi<real>() + glm::pi<real>();
 
 	result.top_left.x = glm::min(start.x, stop.x);
 	result.top_left.y = glm::max(start.y, stop.y);
@@ -445,7 +445,7 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 
 	if (cw)
 	{
-		float pivot = start_a;
+		real pivot = start_a;
 		start_a = stop_a;
 		stop_a = pivot;
 		cw = !cw;
@@ -453,7 +453,7 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 
 	if (start_a < stop_a)
 	{
-		if (start_a < glm::half_pi<float>())
+		if (start_a < glm::half_pi<real>())
 		{
 			if (stop_a >= three_forth_pi)
 			{
@@ -461,24 +461,24 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 				result.top_left.x = center.x - radius;
 				result.bottom_right.y = center.y - radius;
 			}
-			else if (stop_a >= glm::pi<float>())
+			else if (stop_a >= glm::pi<real>())
 			{
 				result.top_left.y = center.y + radius;
 				result.top_left.x = center.x - radius;
 			}
-			else if (stop_a >= glm::half_pi<float>())
+			else if (stop_a >= glm::half_pi<real>())
 			{
 				result.top_left.y = center.y + radius;
 			}
 		}
-		else if (start_a < glm::pi<float>())
+		else if (start_a < glm::pi<real>())
 		{
 			if (stop_a >= three_forth_pi)
 			{
 				result.top_left.x = center.x - radius;
 				result.bottom_right.y = center.y - radius;
 			}
-			else if (stop_a >= glm::pi<float>())
+			else if (stop_a >= glm::pi<real>())
 			{
 				result.top_left.x = center.x - radius;
 			}
@@ -502,13 +502,13 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 				result.bottom_right.y = center.y - radius;
 				result.bottom_right.x = center.x + radius;
 			}
-			else if (stop_a >= glm::pi<float>())
+			else if (stop_a >= glm::pi<real>())
 			{
 				result.top_left.y = center.y + radius;
 				result.top_left.x = center.x - radius;
 				result.bottom_right.x = center.x + radius;
 			}
-			else if (stop_a >= glm::half_pi<float>())
+			else if (stop_a >= glm::half_pi<real>())
 			{
 				result.top_left.y = center.y + radius;
 				result.bottom_right.x = center.x + radius;
@@ -518,16 +518,16 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 				result.bottom_right.x = center.x + radius;
 			}
 		}
-		else if (start_a >= glm::pi<float>())
+		else if (start_a >= glm::pi<real>())
 		{
-			if (stop_a >= glm::pi<float>())
+			if (stop_a >= glm::pi<real>())
 			{
 				result.top_left.y = center.y + radius;
 				result.top_left.x = center.x - radius;
 				result.bottom_right.y = center.y - radius;
 				result.bottom_right.x = center.x + radius;
 			}
-			else if (stop_a >= glm::half_pi<float>())
+			else if (stop_a >= glm::half_pi<real>())
 			{
 				result.top_left.y = center.y + radius;
 				result.bottom_right.x = center.x + radius;
@@ -539,9 +539,9 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 				result.bottom_right.y = center.y - radius;
 			}
 		}
-		else if (start_a >= glm::half_pi<float>())
+		else if (start_a >= glm::half_pi<real>())
 		{
-			if (stop_a >= glm::half_pi<float>())
+			if (stop_a >= glm::half_pi<real>())
 			{
 				result.top_left.y = center.y + radius;
 				result.top_left.x = center.x - radius;
@@ -568,9 +568,9 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 
 	//rectangle result;
 
-	//float start_a = geometry::oriented_angle(start, center);
-	//float stop_a = geometry::oriented_angle(stop, center);
-	//float three_forth_pi = glm::half_pi<float>() + glm::pi<float>();
+	//real start_a = geometry::oriented_angle(start, center);
+	//real stop_a = geometry::oriented_angle(stop, center);
+	//real three_forth_pi = glm::half_pi<real>() + glm::pi<real>();
 
 	//result.top_left.x = glm::min(start.x, stop.x);
 	//result.top_left.y = glm::max(start.y, stop.y);
@@ -579,7 +579,7 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 
 	//if (cw)
 	//{
-	//	float pivot = start_a;
+	//	real pivot = start_a;
 	//	start_a = stop_a;
 	//	stop_a = pivot;
 	//	cw = !cw;
@@ -587,7 +587,7 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 
 	//if (start_a < stop_a)
 	//{
-	//	if (start_a < glm::half_pi<float>())
+	//	if (start_a < glm::half_pi<real>())
 	//	{
 	//		if (stop_a >= three_forth_pi)
 	//		{
@@ -595,24 +595,24 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 	//			result.top_left.x = center.x - radius;
 	//			result.bottom_right.y = center.y - radius;
 	//		}
-	//		else if (stop_a >= glm::pi<float>())
+	//		else if (stop_a >= glm::pi<real>())
 	//		{
 	//			result.top_left.y = center.y + radius;
 	//			result.top_left.x = center.x - radius;
 	//		}
-	//		else if (stop_a >= glm::half_pi<float>())
+	//		else if (stop_a >= glm::half_pi<real>())
 	//		{
 	//			result.top_left.y = center.y + radius;
 	//		}
 	//	}
-	//	else if (start_a < glm::pi<float>())
+	//	else if (start_a < glm::pi<real>())
 	//	{
 	//		if (stop_a >= three_forth_pi)
 	//		{
 	//			result.top_left.x = center.x - radius;
 	//			result.bottom_right.y = center.y - radius;
 	//		}
-	//		else if (stop_a >= glm::pi<float>())
+	//		else if (stop_a >= glm::pi<real>())
 	//		{
 	//			result.top_left.x = center.x - radius;
 	//		}
@@ -636,13 +636,13 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 	//			result.bottom_right.y = center.y - radius;
 	//			result.bottom_right.x = center.x + radius;
 	//		}
-	//		else if (stop_a >= glm::pi<float>())
+	//		else if (stop_a >= glm::pi<real>())
 	//		{
 	//			result.top_left.y = center.y + radius;
 	//			result.top_left.x = center.x - radius;
 	//			result.bottom_right.x = center.x + radius;
 	//		}
-	//		else if (stop_a >= glm::half_pi<float>())
+	//		else if (stop_a >= glm::half_pi<real>())
 	//		{
 	//			result.top_left.y = center.y + radius;
 	//			result.bottom_right.x = center.x + radius;
@@ -652,16 +652,16 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 	//			result.bottom_right.x = center.x + radius;
 	//		}
 	//	}
-	//	else if (start_a >= glm::pi<float>())
+	//	else if (start_a >= glm::pi<real>())
 	//	{
-	//		if (stop_a >= glm::pi<float>())
+	//		if (stop_a >= glm::pi<real>())
 	//		{
 	//			result.top_left.y = center.y + radius;
 	//			result.top_left.x = center.x - radius;
 	//			result.bottom_right.y = center.y - radius;
 	//			result.bottom_right.x = center.x + radius;
 	//		}
-	//		else if (stop_a >= glm::half_pi<float>())
+	//		else if (stop_a >= glm::half_pi<real>())
 	//		{
 	//			result.top_left.y = center.y + radius;
 	//			result.bottom_right.x = center.x + radius;
@@ -673,9 +673,9 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 	//			result.bottom_right.y = center.y - radius;
 	//		}
 	//	}
-	//	else if (start_a >= glm::half_pi<float>())
+	//	else if (start_a >= glm::half_pi<real>())
 	//	{
-	//		if (stop_a >= glm::half_pi<float>())
+	//		if (stop_a >= glm::half_pi<real>())
 	//		{
 	//			result.top_left.y = center.y + radius;
 	//			result.top_left.x = center.x - radius;
@@ -701,14 +701,14 @@ rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 	//return result;
 }
 
-glm::vec2 circle_center(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3)
+rvec2 circle_center(rvec2 p1, rvec2 p2, rvec2 p3)
 {
-	glm::vec2 result = glm::vec2();
+	rvec2 result = rvec2();
 
-	float x1 = p1.x, x2 = p2.x, x3 = p3.x, y1 = p1.y, y2 = p2.y, y3 = p3.y;
+	real x1 = p1.x, x2 = p2.x, x3 = p3.x, y1 = p1.y, y2 = p2.y, y3 = p3.y;
 
-	float a1 = (y1 - y3) / (x1 - x3);
-	float a2 = (y2 - y3) / (x2 - x3);
+	real a1 = (y1 - y3) / (x1 - x3);
+	real a2 = (y2 - y3) / (x2 - x3);
 
 	if (a1 == 0 || a2 == 0) {
 		bool permuted = false;
@@ -743,52 +743,52 @@ glm::vec2 circle_center(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3)
 	}
 
 	// P1-P3
-	float xe = (x1 + x3) / 2;
-	float ye = (y1 + y3) / 2;
+	real xe = (x1 + x3) / 2;
+	real ye = (y1 + y3) / 2;
 
 	// P2-P3
-	float xf = (x2 + x3) / 2;
-	float yf = (y2 + y3) / 2;
+	real xf = (x2 + x3) / 2;
+	real yf = (y2 + y3) / 2;
 
-	float b1 = ye + (xe / a1);
-	float b2 = yf + (xf / a2);
+	real b1 = ye + (xe / a1);
+	real b2 = yf + (xf / a2);
 
 	result.x = (b2 - b1) / (1 / a2 - 1 / a1);
 	result.y = -result.x / a1 + b1;
 	return result;
 }
 
-bool arc_point(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 point, float err)
+bool arc_point(rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 point, real err)
 {
-	float r1 = distance(center, start);
-	float r2 = distance(center, point);
+	real r1 = distance(center, start);
+	real r2 = distance(center, point);
 	if (glm::abs(r1 - r2) > err)
 		return false;
 
 	return colinear_arc_point(start, center, stop, cw, point);
 }
 
-bool arc_point(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw, glm::vec2 point, float err)
+bool arc_point(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw, rvec2 point, real err)
 {
-	float r2 = distance(center, point);
+	real r2 = distance(center, point);
 	if (glm::abs(radius - r2) > err)
 		return false;
 
 	return colinear_arc_point(start, center, stop, cw, point);
 }
 
-bool colinear_arc_point(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 point)
+bool colinear_arc_point(rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 point)
 {
-	float a1 = oriented_angle(start, center);
-	float a2 = oriented_angle(stop, center);
-	float a3 = oriented_angle(point, center);
+	real a1 = oriented_angle(start, center);
+	real a2 = oriented_angle(stop, center);
+	real a3 = oriented_angle(point, center);
 
 	return colinear_arc_point(a1, center, a2, cw, point);
 }
 
-bool colinear_arc_point(float start, glm::vec2 center, float stop, bool cw, glm::vec2 point)
+bool colinear_arc_point(real start, rvec2 center, real stop, bool cw, rvec2 point)
 {
-	float ctr = oriented_angle(point, center);
+	real ctr = oriented_angle(point, center);
 
 	if (ctr == start || ctr == stop)
 		return true;
@@ -823,16 +823,16 @@ bool colinear_arc_point(float start, glm::vec2 center, float stop, bool cw, glm:
 	return false;
 }
 
-glm::vec2 arc_middle(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw)
+rvec2 arc_middle(rvec2 start, rvec2 center, rvec2 stop, bool cw)
 {
 	return arc_middle(start, center, stop, geometry::distance(start, center), cw);
 }
 
-glm::vec2 arc_middle(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw)
+rvec2 arc_middle(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw)
 {
-	float a1 = oriented_angle(start, center);
-	float a2 = oriented_angle(stop, center);
-	float a3 = 0;
+	real a1 = oriented_angle(start, center);
+	real a2 = oriented_angle(stop, center);
+	real a3 = 0;
 
 	if (radius == 0)
 		radius = geometry::distance(start, center);
@@ -842,25 +842,25 @@ glm::vec2 arc_middle(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float ra
 		if (a1 > a2)
 			a3 = a1 - ((a1 - a2) / 2);
 		else
-			a3 = oriented_angle(a1 - ((a1 - (a2 - glm::two_pi<float>())) / 2));
+			a3 = oriented_angle(a1 - ((a1 - (a2 - glm::two_pi<real>())) / 2));
 	}
 	else
 	{
 		if (a1 < a2)
 			a3 = a2 - ((a2 - a1) / 2);
 		else
-			a3 = oriented_angle(a2 - ((a2 - (a1 - glm::two_pi<float>())) / 2));
+			a3 = oriented_angle(a2 - ((a2 - (a1 - glm::two_pi<real>())) / 2));
 	}
 
 	return position(a3, radius, center);
 }
 
-float arc_thickness(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw)
+real arc_thickness(rvec2 start, rvec2 center, rvec2 stop, bool cw)
 {
 	return arc_thickness(start, center, stop, geometry::distance(center, start), cw);
 }
 
-float arc_thickness(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw)
+real arc_thickness(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw)
 {
 	auto middle = arc_middle(start, center, stop, radius, cw);
 	auto axe = geometry::middle(start, stop);
@@ -868,33 +868,33 @@ float arc_thickness(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float rad
 	return geometry::distance(middle, axe);
 }
 
-float arc_length(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw)
+real arc_length(rvec2 start, rvec2 center, rvec2 stop, bool cw)
 {
 	return arc_length(start, center, stop, distance(start, center), cw);
 }
 
-float arc_length(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw)
+real arc_length(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw)
 {
-	float a1 = oriented_angle(start, center);
-	float a2 = oriented_angle(stop, center);
+	real a1 = oriented_angle(start, center);
+	real a2 = oriented_angle(stop, center);
 
 	if (!cw)
 	{
 		if (a1 < a2)
 			return (a2 - a1) * radius;
 		else
-			return (glm::two_pi<float>() - a1 + a2) * radius;
+			return (glm::two_pi<real>() - a1 + a2) * radius;
 	}
 	else
 	{
 		if (a1 > a2)
 			return (a1 - a2) * radius;
 		else
-			return (glm::two_pi<float>() - a2 + a1) * radius;
+			return (glm::two_pi<real>() - a2 + a1) * radius;
 	}
 }
 
-int arc_position(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 test)
+int arc_position(rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 test)
 {
 	auto a1 = geometry::oriented_angle(start,center);
 	auto a2 = geometry::oriented_angle(stop, center);
@@ -944,7 +944,7 @@ int arc_position(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm
 	}
 }
 
-bool arc_position_left(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 test)
+bool arc_position_left(rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 test)
 {
 	auto a1 = geometry::oriented_angle(start, center);
 	auto a2 = geometry::oriented_angle(stop, center);
@@ -985,22 +985,22 @@ bool arc_position_left(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool c
 /// <param name="angle">angle in radian</param>
 /// <param name="radius">radius</param>
 /// <returns>coordinates</returns>
-glm::vec2 position(float angle, float radius)
+rvec2 position(real angle, real radius)
 {
 	// remove modulo [2*PI]
-	while (angle > glm::two_pi<float>()) angle -= glm::two_pi<float>();
-	while (angle < 0) angle += glm::two_pi<float>();
+	while (angle > glm::two_pi<real>()) angle -= glm::two_pi<real>();
+	while (angle < 0) angle += glm::two_pi<real>();
 
-	if (angle == glm::half_pi<float>())
-		return glm::vec2(0, radius);
-	if (angle == glm::pi<float>() + glm::half_pi<float>())
-		return glm::vec2(0, -radius);
+	if (angle == glm::half_pi<real>())
+		return rvec2(0, radius);
+	if (angle == glm::pi<real>() + glm::half_pi<real>())
+		return rvec2(0, -radius);
 	if (angle == 0)
-		return glm::vec2(radius, 0);
-	if (angle == glm::pi<float>())
-		return glm::vec2(-radius, 0);
+		return rvec2(radius, 0);
+	if (angle == glm::pi<real>())
+		return rvec2(-radius, 0);
 
-	return glm::vec2(radius * glm::cos(angle), radius * glm::sin(angle));
+	return rvec2(radius * glm::cos(angle), radius * glm::sin(angle));
 }
 
 /// <summary>
@@ -1010,22 +1010,22 @@ glm::vec2 position(float angle, float radius)
 /// <param name="radius">radius</param>
 /// <param name="origin">position of the center of circle</param>
 /// <returns></returns>
-glm::vec2 position(float angle, float radius, glm::vec2 origin)
+rvec2 position(real angle, real radius, rvec2 origin)
 {
 	// remove modulo [2*PI]
-	while (angle > glm::two_pi<float>()) angle -= glm::two_pi<float>();
-	while (angle < 0) angle += glm::two_pi<float>();
+	while (angle > glm::two_pi<real>()) angle -= glm::two_pi<real>();
+	while (angle < 0) angle += glm::two_pi<real>();
 
-	if (angle == glm::half_pi<float>())
-		return glm::vec2(origin.x, origin.y + radius);
-	if (angle == glm::pi<float>() + glm::half_pi<float>())
-		return glm::vec2(origin.x, origin.y - radius);
+	if (angle == glm::half_pi<real>())
+		return rvec2(origin.x, origin.y + radius);
+	if (angle == glm::pi<real>() + glm::half_pi<real>())
+		return rvec2(origin.x, origin.y - radius);
 	if (angle == 0)
-		return glm::vec2(origin.x + radius, origin.y);
-	if (angle == glm::pi<float>())
-		return glm::vec2(origin.x - radius, origin.y);
+		return rvec2(origin.x + radius, origin.y);
+	if (angle == glm::pi<real>())
+		return rvec2(origin.x - radius, origin.y);
 
-	return glm::vec2(radius * glm::cos(angle) + origin.x, radius * glm::sin(angle) + origin.y);
+	return rvec2(radius * glm::cos(angle) + origin.x, radius * glm::sin(angle) + origin.y);
 }
 
 /// <summary>
@@ -1035,24 +1035,24 @@ glm::vec2 position(float angle, float radius, glm::vec2 origin)
 /// <param name="radius">radius to apply</param>
 /// <param name="origin">position of the center of circle</param>
 /// <returns></returns>
-glm::vec2 position(glm::vec2 source, float radius, glm::vec2 origin)
+rvec2 position(rvec2 source, real radius, rvec2 origin)
 {
 	auto a = angle(source, origin);
 
 	if (a == 0)
-		return glm::vec2(origin.x + radius, origin.y);
-	else if (a == glm::half_pi<float>())
-		return glm::vec2(origin.x, origin.y + radius);
-	else if (a == glm::pi<float>())
-		return glm::vec2(origin.x - radius, origin.y);
-	else if (a == glm::half_pi<float>() + glm::pi<float>())
-		return glm::vec2(origin.x, origin.y - radius);
+		return rvec2(origin.x + radius, origin.y);
+	else if (a == glm::half_pi<real>())
+		return rvec2(origin.x, origin.y + radius);
+	else if (a == glm::pi<real>())
+		return rvec2(origin.x - radius, origin.y);
+	else if (a == glm::half_pi<real>() + glm::pi<real>())
+		return rvec2(origin.x, origin.y - radius);
 
-	return glm::vec2(radius * glm::cos(a) + origin.x, radius * glm::sin(a) + origin.y);
+	return rvec2(radius * glm::cos(a) + origin.x, radius * glm::sin(a) + origin.y);
 }
 
 /// <summary>
-/// convert a float/double to string with a decimal precision number
+/// convert a real/double to string with a decimal precision number
 /// </summary>
 /// <typeparam name="T"></typeparam>
 /// <param name="a_value">value to convert</param>
@@ -1654,15 +1654,15 @@ void offset(glm::vec3& p, float value)
 /// <param name="p1">first segment ref_point</param>
 /// <param name="p2">second segment ref_point</param>
 /// <returns>coordinates of projection</returns>
-glm::vec2 projection(glm::vec2 p, glm::vec2 p1, glm::vec2 p2)
+rvec2 projection(rvec2 p, rvec2 p1, rvec2 p2)
 {
-	float dh = p1.x - p2.x;
+	real dh = p1.x - p2.x;
 	if (glm::abs(dh) <= geometry::ERR_FLOAT3)
-		return glm::vec2(p1.x, p.y);
+		return rvec2(p1.x, p.y);
 
-	float dv = p1.y - p2.y;
+	real dv = p1.y - p2.y;
 	if (glm::abs(dv) <= geometry::ERR_FLOAT3)
-		return glm::vec2(p.x, p1.y);
+		return rvec2(p.x, p1.y);
 
 	// y = a * x + b
 	auto a = dv / dh;
@@ -1675,7 +1675,7 @@ glm::vec2 projection(glm::vec2 p, glm::vec2 p1, glm::vec2 p2)
 	// intersection
 	auto x = (o_b - b) / (a - o_a);
 	auto y = a * x + b;
-	return glm::vec2(x, y);
+	return rvec2(x, y);
 }
 
 /// <summary>
@@ -1709,29 +1709,29 @@ glm::vec2 symmetry(glm::vec2 p, glm::vec2 center)
 	return geometry::position(a, r, center);
 }
 
-glm::vec2 middle(glm::vec2 p1, glm::vec2 p2)
+rvec2 middle(rvec2 p1, rvec2 p2)
 {
-	return (p1 + p2) / 2.0f;
+	return (p1 + p2) / real(2);
 }
 
 /// <summary>
 /// check if ref_point is a segment. the 3 points are supposed to be colinear
 /// </summary>
-bool colinear_segment_point(glm::vec2 p1, glm::vec2 p2, glm::vec2 test)
+bool colinear_segment_point(rvec2 p1, rvec2 p2, rvec2 test)
 {
 	auto x = test.x >= glm::min(p1.x, p2.x) && test.x <= glm::max(p1.x, p2.x);
 	auto y = test.y >= glm::min(p1.y, p2.y) && test.y <= glm::max(p1.y, p2.y);
 	return  x && y;
 }
 
-bool colinear_segment_point(glm::vec2 p1, glm::vec2 p2, glm::vec2 test, float err)
+bool colinear_segment_point(rvec2 p1, rvec2 p2, rvec2 test, real err)
 {
 	auto x = test.x >= (glm::min(p1.x, p2.x) - err) && test.x <= (glm::max(p1.x, p2.x) + err);
 	auto y = test.y >= (glm::min(p1.y, p2.y) - err) && test.y <= (glm::max(p1.y, p2.y) + err);
 	return  x && y;
 }
 
-bool colinear_segments(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4)
+bool colinear_segments(rvec2 p1, rvec2 p2, rvec2 p3, rvec2 p4)
 {
 	// vertical
 	if (p1.x == p2.x && p1.x == p3.x && p1.x == p4.x)
@@ -1744,7 +1744,7 @@ bool colinear_segments(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4)
 	auto u = p2 - p1;
 	auto v = p4 - p3;
 
-	float d = u.x * v.y - u.y * v.x;
+	real d = u.x * v.y - u.y * v.x;
 
 	return glm::abs(d) < ERR_FLOAT;
 }
@@ -1752,7 +1752,7 @@ bool colinear_segments(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4)
 /// <summary>
 /// check if ref_point is a segment.
 /// </summary>
-bool segment_point(glm::vec2 p1, glm::vec2 p2, glm::vec2 test)
+bool segment_point(rvec2 p1, rvec2 p2, rvec2 test)
 {
 	auto a = p2 - p1;
 	auto b = test - p1;
@@ -1763,7 +1763,7 @@ bool segment_point(glm::vec2 p1, glm::vec2 p2, glm::vec2 test)
 	return false;
 }
 
-int segment_position(glm::vec2 start, glm::vec2 stop, glm::vec2 test)
+int segment_position(rvec2 start, rvec2 stop, rvec2 test)
 {
 	// vertical
 	if (start.x == stop.x)
@@ -1810,7 +1810,7 @@ int segment_position(glm::vec2 start, glm::vec2 stop, glm::vec2 test)
 	}
 }
 
-bool segment_position_left(glm::vec2 start, glm::vec2 stop, glm::vec2 test)
+bool segment_position_left(rvec2 start, rvec2 stop, rvec2 test)
 {
 	// vertical
 	if (start.x == stop.x)
@@ -1836,7 +1836,7 @@ bool segment_position_left(glm::vec2 start, glm::vec2 stop, glm::vec2 test)
 	return false;
 }
 
-bool line_line_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4, glm::vec2& result)
+bool line_line_intersect(rvec2 p1, rvec2 p2, rvec2 p3, rvec2 p4, rvec2& result)
 {
 	// line p1,p2 is horizontal and p3,p4 is vertical
 	if (p1.y == p2.y && p3.x == p4.x)
@@ -1872,8 +1872,8 @@ bool line_line_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4,
 
 				//if (denom != 0)
 				//{
-				//	result.x = (float)(xnom / denom);
-				//	result.y = (float)(ynom / denom);
+				//	result.x = (real)(xnom / denom);
+				//	result.y = (real)(ynom / denom);
 				//	
 				//	if (glm::abs(p1.x - p2.x) < geometry::ERR_FLOAT5)
 				//		result.x = p1.x;
@@ -1890,8 +1890,8 @@ bool line_line_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4,
 
 
 				//// parametric solution
-				glm::vec2 i = p2 - p1;
-				glm::vec2 j = p4 - p3;
+				rvec2 i = p2 - p1;
+				rvec2 j = p4 - p3;
 				double m = 0, k = 0;
 				double div = (i.x * j.y - i.y * j.x);
 
@@ -1908,9 +1908,9 @@ bool line_line_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4,
 				//		+ j.y * p3.x
 				//		) / div;
 				
-					result = p3 + (j * (float)m);
-					result.x = p3.x + (float)(j.x * m);
-					result.y = p3.y + (float)(j.y * m);
+					result = p3 + (j * (real)m);
+					result.x = p3.x + (real)(j.x * m);
+					result.y = p3.y + (real)(j.y * m);
 
 					// check for verticality or horizontality to increase accuracy
 				if (glm::abs(p1.x - p2.x) < geometry::ERR_FLOAT5)
@@ -1951,22 +1951,22 @@ bool line_line_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4,
 				//if (glm::abs(a1 - a2) > 0)
 				//{
 				//	if (dh1 == 0) {
-				//		result.x = (float)b1;
-				//		result.y = (float)(a2 * b1 + b2);
+				//		result.x = (real)b1;
+				//		result.y = (real)(a2 * b1 + b2);
 				//	}
 				//	else if (dh2 == 0) {
-				//		result.x = (float)b2;
-				//		result.y = (float)(a1 * b2 + b1);
+				//		result.x = (real)b2;
+				//		result.y = (real)(a1 * b2 + b1);
 				//	}
 				//	else {
-				//		result.x = (float)((b2 - b1) / (a1 - a2));
+				//		result.x = (real)((b2 - b1) / (a1 - a2));
 
-				//		if (a1 == 0) // if segment 1 is horizontal, then y intersection is p1.y or p2.y, so we avoid float rounding
+				//		if (a1 == 0) // if segment 1 is horizontal, then y intersection is p1.y or p2.y, so we avoid real rounding
 				//			result.y = p1.y;
 				//		else if (a2 == 0)  // if segment 2 is horizontal, then y intersection is p3.y oy p4.y
 				//			result.y = p3.y;
 				//		else
-				//			result.y = (float)(a1 * result.x + b1);
+				//			result.y = (real)(a1 * result.x + b1);
 				//	}
 				//	return true;
 				//}
@@ -1974,7 +1974,7 @@ bool line_line_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4,
 	return false;
 }
 
-bool segment_segment_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4, glm::vec2& result)
+bool segment_segment_intersect(rvec2 p1, rvec2 p2, rvec2 p3, rvec2 p4, rvec2& result)
 {
 	bool intersect = line_line_intersect(p1, p2, p3, p4, result);
 
@@ -2007,7 +2007,7 @@ bool segment_polyline_intersect(glm::vec2 p1, glm::vec2 p2, std::vector<glm::vec
 	//}
 
 	//if (geometry::rectangle_intersect(p1, p2))
-	glm::vec2 p = glm::vec2();
+	rvec2 p = rvec2();
 	for (size_t i = 0; i < coordinates.size() - 1; i++)
 	{
 		if (segment_segment_intersect(p1, p2, coordinates[i], coordinates[i + 1], p))
@@ -2017,7 +2017,7 @@ bool segment_polyline_intersect(glm::vec2 p1, glm::vec2 p2, std::vector<glm::vec
 	return result.size() > 0;
 }
 
-int line_circle_intersect2(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float radius, glm::vec2 result[2], float err)
+int line_circle_intersect2(rvec2 p1, rvec2 p2, rvec2 center, real radius, rvec2 result[2], real err)
 {
 	// translate center to origin
 	p1 -= center;
@@ -2055,27 +2055,27 @@ int line_circle_intersect2(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float r
 
 		if (glm::abs(c2 - r2 * (a2 + b2)) < err)
 		{
-			result[0].x = center.x + (float)(x0);
-			result[0].y = center.y + (float)(y0);
+			result[0].x = center.x + (real)(x0);
+			result[0].y = center.y + (real)(y0);
 			return 1;
 		}
 		else if (c2 < r2 * (a2 + b2) + err)
 		{
 			double d = r2 - c2 / (a2 + b2);
 			double mult = sqrt(d / (a2 + b2));
-			result[0].x = center.x + (float)(x0 + b * mult);
-			result[1].x = center.x + (float)(x0 - b * mult);
-			result[0].y = center.y + (float)(y0 - a * mult);
-			result[1].y = center.y + (float)(y0 + a * mult);
+			result[0].x = center.x + (real)(x0 + b * mult);
+			result[1].x = center.x + (real)(x0 - b * mult);
+			result[0].y = center.y + (real)(y0 - a * mult);
+			result[1].y = center.y + (real)(y0 + a * mult);
 			return 2;
 		}
 	}
 	return 0;
 }
 
-int line_circle_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float radius, glm::vec2 result[2], float err)
+int line_circle_intersect(rvec2 p1, rvec2 p2, rvec2 center, real radius, rvec2 result[2], real err)
 {
-	float distance = foretriangle(p1, p2, center);
+	real distance = foretriangle(p1, p2, center);
 	
 	if (distance == radius) // tangente
 	{
@@ -2125,14 +2125,14 @@ int line_circle_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float ra
 			//}
 			//if (delta == 0) {
 			//	double x = -B / (2 * A);
-			//	result[0] = glm::vec2(center.x + x, center.y + (a * x + b));
+			//	result[0] = rvec2(center.x + x, center.y + (a * x + b));
 			//	return 1;
 			//}
 			//auto sqrt_delta = glm::sqrt(delta);
-			//float x1 = (float)(((-B - sqrt_delta) / (2 * A)));
-			//float x2 = (float)(((-B + sqrt_delta) / (2 * A)));
-			//result[0] = glm::vec2(x1, a * x1 + b);
-			//result[1] = glm::vec2(x2, a * x2 + b);
+			//real x1 = (real)(((-B - sqrt_delta) / (2 * A)));
+			//real x2 = (real)(((-B + sqrt_delta) / (2 * A)));
+			//result[0] = rvec2(x1, a * x1 + b);
+			//result[1] = rvec2(x2, a * x2 + b);
 			double a = (p1.y - p2.y) / (p1.x - p2.x);
 			double b = -1;
 			double c = p1.y - a * p1.x;
@@ -2147,10 +2147,10 @@ int line_circle_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float ra
 
 			double d = r2 - c2 / (a2 + b2);
 			double mult = sqrt(d / (a2 + b2));
-			result[0].x = (float)(x0 + b * mult);
-			result[1].x = (float)(x0 - b * mult);
-			result[0].y = (float)(y0 - a * mult);
-			result[1].y = (float)(y0 + a * mult);
+			result[0].x = (real)(x0 + b * mult);
+			result[1].x = (real)(x0 - b * mult);
+			result[0].y = (real)(y0 - a * mult);
+			result[1].y = (real)(y0 + a * mult);
 			}
 
 		result[0] += center;
@@ -2162,9 +2162,9 @@ int line_circle_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float ra
 	return 0;
 }
 
-int segment_circle_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float radius, glm::vec2 result[2])
+int segment_circle_intersect(rvec2 p1, rvec2 p2, rvec2 center, real radius, rvec2 result[2])
 {
-	glm::vec2 points[2];
+	rvec2 points[2];
 
 	if (line_circle_intersect(p1, p2, center, radius, points))
 	{
@@ -2187,7 +2187,7 @@ int segment_circle_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float
 	return 0;
 }
 
-int circle_circle_intersect(glm::vec2 c1, float r1, glm::vec2 c2, float r2, glm::vec2 result[2])
+int circle_circle_intersect(rvec2 c1, real r1, rvec2 c2, real r2, rvec2 result[2])
 {
 	auto dist = glm::distance(c1, c2);
 	auto radius = r1 + r2;
@@ -2202,7 +2202,7 @@ int circle_circle_intersect(glm::vec2 c1, float r1, glm::vec2 c2, float r2, glm:
 		return 0;
 
 	// solving equation
-	//float d = glm::sqrt((c2.x - c1.x) * (c2.x - c1.x) + (c2.y - c1.y) * (c2.y - c1.y));
+	//real d = glm::sqrt((c2.x - c1.x) * (c2.x - c1.x) + (c2.y - c1.y) * (c2.y - c1.y));
 	//double factor = glm::sqrt(((r1 + r2) * (r1 + r2) - d * d) * (d * d - (r2 - r1) * (r2 - r1)));
 	//double x = (c2.x + c1.x) / 2 + ((c2.x - c1.x) * (r1 * r1 - r2 * r2)) / (2 * d * d);
 	//double y = (c2.y + c1.y) / 2 + ((c2.y - c1.y) * (r1 * r1 - r2 * r2)) / (2 * d * d);
@@ -2210,8 +2210,8 @@ int circle_circle_intersect(glm::vec2 c1, float r1, glm::vec2 c2, float r2, glm:
 	//double x2 = x - ((c2.y - c1.y) / (2 * d * d)) * factor;
 	//double y1 = y - ((c2.x - c1.x) / (2 * d * d)) * factor;
 	//double y2 = y + ((c2.x - c1.x) / (2 * d * d)) * factor;
-	//result[0] = glm::vec2(x1, y1);
-	//result[1] = glm::vec2(x2, y2);
+	//result[0] = rvec2(x1, y1);
+	//result[1] = rvec2(x2, y2);
 
 	double r1_2 = r1 * r1;
 	double r2_2 = r2 * r2;
@@ -2219,9 +2219,9 @@ int circle_circle_intersect(glm::vec2 c1, float r1, glm::vec2 c2, float r2, glm:
 	double a = (r1_2 - r2_2 + d_2) / (2 * dist);
 	double h = glm::sqrt(r1_2 - (a * a));
 	double h_d = h / dist;
-	glm::vec2 p3 = c1 + (float)((a / dist)) * (c2 - c1);
-	result[0] = glm::vec2(p3.x + h_d * (c2.y - c1.y), p3.y - h_d * (c2.x - c1.x));
-	result[1] = glm::vec2(p3.x - h_d * (c2.y - c1.y), p3.y + h_d * (c2.x - c1.x));
+	rvec2 p3 = c1 + (real)((a / dist)) * (c2 - c1);
+	result[0] = rvec2(p3.x + h_d * (c2.y - c1.y), p3.y - h_d * (c2.x - c1.x));
+	result[1] = rvec2(p3.x - h_d * (c2.y - c1.y), p3.y + h_d * (c2.x - c1.x));
 
 	if (h == 0)
 		return 1;
@@ -2231,7 +2231,7 @@ int circle_circle_intersect(glm::vec2 c1, float r1, glm::vec2 c2, float r2, glm:
 
 int circle_polyline_intersect(glm::vec2 c1, float r1, std::vector<glm::vec2> coordinates, std::vector<glm::vec2>& result)
 {
-	glm::vec2 points[2] { vec2_empty, vec2_empty };
+	rvec2 points[2] { rvec2_empty, rvec2_empty };
 	for (int i = 0; i < coordinates.size() - 1; i++)
 	{
 		auto count = segment_circle_intersect(coordinates[i], coordinates[i + 1], c1, r1, points);
@@ -2244,15 +2244,15 @@ int circle_polyline_intersect(glm::vec2 c1, float r1, std::vector<glm::vec2> coo
 	return (int)result.size();
 }
 
-int line_arc_intersect(glm::vec2 p1, glm::vec2 p2, float start, glm::vec2 center, float stop, float radius, bool cw, glm::vec2 result[2], float err)
+int line_arc_intersect(rvec2 p1, rvec2 p2, real start, rvec2 center, real stop, real radius, bool cw, rvec2 result[2], real err)
 {
-	glm::vec2 points[2];
+	rvec2 points[2];
 
 	if (line_circle_intersect(p1, p2, center, radius, points, err))
 	{
 		int count = 0;
 
-		for (glm::vec2 p : points)
+		for (rvec2 p : points)
 		{
 			if (colinear_arc_point(start, center, stop, cw, p))
 			{
@@ -2266,31 +2266,31 @@ int line_arc_intersect(glm::vec2 p1, glm::vec2 p2, float start, glm::vec2 center
 	return 0;
 }
 
-int line_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw, glm::vec2 result[2], float err)
+int line_arc_intersect(rvec2 p1, rvec2 p2, rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw, rvec2 result[2], real err)
 {
-	float start_a = geometry::oriented_angle(start, center);
-	float stop_a = geometry::oriented_angle(stop, center);
+	real start_a = geometry::oriented_angle(start, center);
+	real stop_a = geometry::oriented_angle(stop, center);
 
 	return line_arc_intersect(p1, p2, start_a, center, stop_a, radius, cw, result, err);
 }
 
-int line_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 result[2], float err)
+int line_arc_intersect(rvec2 p1, rvec2 p2, rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 result[2], real err)
 {
-	float radius = geometry::distance(start, center);
+	real radius = geometry::distance(start, center);
 	return line_arc_intersect(p1, p2, start, center, stop, radius, cw, result, err);
 }
 
-int segment_arc_intersect(glm::vec2 p1, glm::vec2 p2, float start, glm::vec2 center, float stop, float radius, bool cw, glm::vec2 result[2])
+int segment_arc_intersect(rvec2 p1, rvec2 p2, real start, rvec2 center, real stop, real radius, bool cw, rvec2 result[2])
 {
-	glm::vec2 points[2];
+	rvec2 points[2];
 
 	if (line_circle_intersect(p1, p2, center, radius, points))
 	{
 		int count = 0;
 
-		for (glm::vec2 p : points)
+		for (rvec2 p : points)
 		{
-			for (glm::vec2 p : points)
+			for (rvec2 p : points)
 			{
 				if (colinear_segment_point(p1, p2, p) && colinear_arc_point(start, center, stop, cw, p))
 				{
@@ -2305,16 +2305,16 @@ int segment_arc_intersect(glm::vec2 p1, glm::vec2 p2, float start, glm::vec2 cen
 	return 0;
 }
 
-int segment_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 result[2])
+int segment_arc_intersect(rvec2 p1, rvec2 p2, rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 result[2])
 {
-	float radius = geometry::distance(start, center);
+	real radius = geometry::distance(start, center);
 
 	return segment_arc_intersect(p1, p2, start, center, stop, radius, cw, result);
 }
 
-int segment_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw, glm::vec2 result[2])
+int segment_arc_intersect(rvec2 p1, rvec2 p2, rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw, rvec2 result[2])
 {
-	glm::vec2 points[2];
+	rvec2 points[2];
 	
 	if (radius == 0)
 		radius = geometry::distance(start, center);
@@ -2323,10 +2323,10 @@ int segment_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2
 	{
 		int count = 0;
 		
-		float start_a = geometry::oriented_angle(start, center);
-		float stop_a  = geometry::oriented_angle(stop, center);
+		real start_a = geometry::oriented_angle(start, center);
+		real stop_a  = geometry::oriented_angle(stop, center);
 
-		for (glm::vec2 p : points)
+		for (rvec2 p : points)
 		{
 			if (colinear_segment_point(p1, p2, p) && colinear_arc_point(start_a, center, stop_a, cw, p))
 			{
@@ -2340,14 +2340,14 @@ int segment_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2
 	return 0;
 }
 
-int arc_circle_intersect(glm::vec2 c1, float r1, float start, float stop, glm::vec2 c2, float r2, glm::vec2 result[2])
+int arc_circle_intersect(rvec2 c1, real r1, real start, real stop, rvec2 c2, real r2, rvec2 result[2])
 {
-	glm::vec2 points[2];
+	rvec2 points[2];
 	if (circle_circle_intersect(c1, r1, c2, r2, points))
 	{
 		int count = 0;
 
-		for (glm::vec2 p : points)
+		for (rvec2 p : points)
 		{
 			auto angle = oriented_angle(p, c1);
 
@@ -2378,9 +2378,9 @@ int arc_circle_intersect(glm::vec2 c1, float r1, float start, float stop, glm::v
 	return 0;
 }
 
-int arc_circle_intersect(float arc_start, glm::vec2 arc_center, float arc_stop, float arc_radius, bool arc_cw, glm::vec2 circle_center, float circle_radius, glm::vec2 result[2])
+int arc_circle_intersect(real arc_start, rvec2 arc_center, real arc_stop, real arc_radius, bool arc_cw, rvec2 circle_center, real circle_radius, rvec2 result[2])
 {
-	glm::vec2 points[2];
+	rvec2 points[2];
 	int count = circle_circle_intersect(arc_center, arc_radius, circle_center, circle_radius, points);
 	if (count > 0)
 	{
@@ -2401,26 +2401,26 @@ int arc_circle_intersect(float arc_start, glm::vec2 arc_center, float arc_stop,
 	return 0;
 }
 
-int arc_circle_intersect(glm::vec2 arc_start, glm::vec2 arc_center, glm::vec2 arc_stop, bool arc_cw, glm::vec2 circle_center, float circle_radius, glm::vec2 result[2])
+int arc_circle_intersect(rvec2 arc_start, rvec2 arc_center, rvec2 arc_stop, bool arc_cw, rvec2 circle_center, real circle_radius, rvec2 result[2])
 {
-	float radius = geometry::distance(arc_start, arc_center);
+	real radius = geometry::distance(arc_start, arc_center);
 	return arc_circle_intersect(arc_start, arc_center, arc_stop, radius, arc_cw, circle_center, circle_radius, result);
 }
 
-int arc_circle_intersect(glm::vec2 arc_start, glm::vec2 arc_center, glm::vec2 arc_stop, float arc_radius, bool arc_cw, glm::vec2 circle_center, float circle_radius, glm::vec2 result[2])
+int arc_circle_intersect(rvec2 arc_start, rvec2 arc_center, rvec2 arc_stop, real arc_radius, bool arc_cw, rvec2 circle_center, real circle_radius, rvec2 result[2])
 {
-	float start_a = geometry::oriented_angle(arc_start, arc_center);
-	float stop_a  = geometry::oriented_angle(arc_stop, arc_center);
+	real start_a = geometry::oriented_angle(arc_start, arc_center);
+	real stop_a  = geometry::oriented_angle(arc_stop, arc_center);
 	return arc_circle_intersect(start_a, arc_center, stop_a, arc_radius, arc_cw, circle_center, circle_radius, result);
 }
 
-int arc_arc_intersect(float start1, glm::vec2 c1, float stop1, float r1, bool cw1, float start2, glm::vec2 c2, float stop2, float r2, bool cw2, glm::vec2 result[2])
+int arc_arc_intersect(real start1, rvec2 c1, real stop1, real r1, bool cw1, real start2, rvec2 c2, real stop2, real r2, bool cw2, rvec2 result[2])
 {
-	glm::vec2 points[2];
+	rvec2 points[2];
 	int count = circle_circle_intersect(c1, r1, c2, r2, points);
 	if (count > 0)
 	{
-		glm::vec2 points_arc1[2];
+		rvec2 points_arc1[2];
 		int count_arc1 = 0, count_arc2 = 0;
 
 		for (int i = 0; i < count; i++)
@@ -2450,26 +2450,26 @@ int arc_arc_intersect(float start1, glm::vec2 c1, float stop1, float r1, bool cw
 	return 0;
 }
 
-int arc_arc_intersect(glm::vec2 start1, glm::vec2 c1, glm::vec2 stop1, bool cw1, glm::vec2 start2, glm::vec2 c2, glm::vec2 stop2, bool cw2, glm::vec2 result[2])
+int arc_arc_intersect(rvec2 start1, rvec2 c1, rvec2 stop1, bool cw1, rvec2 start2, rvec2 c2, rvec2 stop2, bool cw2, rvec2 result[2])
 {
-	float r1 = geometry::distance(c1, start1);
-	float r2 = geometry::distance(c2, start2);
+	real r1 = geometry::distance(c1, start1);
+	real r2 = geometry::distance(c2, start2);
 
 	return arc_arc_intersect(start1, c1, stop1, r1, cw1, start2, c2, stop2, r2, cw2, result);
 }
 
-int arc_arc_intersect(glm::vec2 start1, glm::vec2 c1, glm::vec2 stop1, float r1, bool cw1, glm::vec2 start2, glm::vec2 c2, glm::vec2 stop2, float r2, bool cw2, glm::vec2 result[2])
+int arc_arc_intersect(rvec2 start1, rvec2 c1, rvec2 stop1, real r1, bool cw1, rvec2 start2, rvec2 c2, rvec2 stop2, real r2, bool cw2, rvec2 result[2])
 {
-	float start1_a = geometry::oriented_angle(start1, c1);
-	float stop1_a  = geometry::oriented_angle(stop1, c1);
-	float start2_a = geometry::oriented_angle(start2, c2);
-	float stop2_a  = geometry::oriented_angle(stop2, c2);
+	real start1_a = geometry::oriented_angle(start1, c1);
+	real stop1_a  = geometry::oriented_angle(stop1, c1);
+	real start2_a = geometry::oriented_angle(start2, c2);
+	real stop2_a  = geometry::oriented_angle(stop2, c2);
 	return arc_arc_intersect(start1_a, c1, stop1_a, r1, cw1, start2_a, c2, stop2_a, r2, cw2, result);
 }
 
 int arc_polyline_intersect(float start, glm::vec2 c, float stop, float r, bool cw, std::vector<glm::vec2> coordinates, std::vector<glm::vec2>& result)
 {
-	glm::vec2 points[2]{ vec2_empty, vec2_empty };
+	rvec2 points[2]{ rvec2_empty, rvec2_empty };
 	for (int i = 0; i < coordinates.size() - 1; i++)
 	{
 		auto count = segment_arc_intersect(coordinates[i], coordinates[i + 1], start, c, stop, r, cw, points);
@@ -2484,7 +2484,7 @@ int arc_polyline_intersect(float start, glm::vec2 c, float stop, float r, bool c
 
 int polyline_polyline_intersect(std::vector<glm::vec2> coord1, std::vector<glm::vec2> coord2, std::vector<glm::vec2>& result)
 {
-	glm::vec2 p = glm::vec2();
+	rvec2 p = rvec2();
 	for (size_t i = 0; i < coord1.size() - 1; i++)
 	{
 		for (size_t j = 0; j < coord2.size() - 1; j++)
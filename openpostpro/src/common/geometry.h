@@ -23,6 +23,18 @@ namespace geometry
 	inline static const glm::vec3 vec3_empty = glm::vec3(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
 	inline static const glm::vec4 vec4_empty = glm::vec4(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
 
+	// scalar used by the curve kernel (rectangle, Segment, Curve, QuadNode and the intersection routines)
+	// double is the default as CAM parts can be meters long and still need a 0.01 mm tolerance
+	// define GEOMETRY_SINGLE_PRECISION to build the kernel with float
+#ifdef GEOMETRY_SINGLE_PRECISION
+	typedef float real;
+#else
+	typedef double real;
+#endif
+	typedef glm::vec<2, real, glm::defaultp> rvec2;
+
+	inline static const rvec2 rvec2_empty = rvec2(vec2_empty);
+
 	inline static const glm::vec2 vec2_max = glm::vec2(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
 	inline static const glm::vec3 vec3_max = glm::vec3(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
 	inline static const glm::vec4 vec4_max = glm::vec4(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
@@ -39,37 +51,37 @@ namespace geometry
 
 	struct rectangle
 	{
-		glm::vec2 top_left;
-		glm::vec2 bottom_right;
-
-		float top() { return top_left.y; }
-		float left() { return top_left.x; }
-		float width() { return bottom_right.x - top_left.x; }
-		float height() { return top_left.y - bottom_right.y; }
-		float bottom() { return bottom_right.y; }
-		float right() { return bottom_right.x; }
-		float x() { return top_left.x; }
-		float y() { return bottom_right.y; }
+		rvec2 top_left;
+		rvec2 bottom_right;
+
+		real top() { return top_left.y; }
+		real left() { return top_left.x; }
+		real width() { return bottom_right.x - top_left.x; }
+		real height() { return top_left.y - bottom_right.y; }
+		real bottom() { return bottom_right.y; }
+		real right() { return bottom_right.x; }
+		real x() { return top_left.x; }
+		real y() { return bottom_right.y; }
 
 		rectangle() 
 		{
-			top_left = geometry::vec2_empty;
-			bottom_right = geometry::vec2_empty;
+			top_left = geometry::rvec2_empty;
+			bottom_right = geometry::rvec2_empty;
 		}
 
-		rectangle(const rectangle& r)
+		rectangle(const rectangle& r) noexcept
 		{
 			top_left = r.top_left;
 			bottom_right = r.bottom_right;
 		}
 
-		rectangle(glm::vec2& top_left, glm::vec2& bottom_right)
+		rectangle(const rvec2& top_left, const rvec2& bottom_right)
 		{
 			this->top_left = top_left;
 			this->bottom_right = bottom_right;
 		}
 
-		rectangle(float left, float top, float right, float bottom)
+		rectangle(real left, real top, real right, real bottom)
 		{
 			top_left.x = left;
 			top_left.y = top;
@@ -77,7 +89,7 @@ namespace geometry
 			bottom_right.y = bottom;
 		}
 
-		rectangle& operator=(const rectangle& r)
+		rectangle& operator=(const rectangle& r) noexcept
 		{
 			top_left = r.top_left;
 			bottom_right = r.bottom_right;
@@ -86,10 +98,10 @@ namespace geometry
 
 		bool empty()
 		{
-			return top_left == geometry::vec2_empty;
+			return top_left == geometry::rvec2_empty;
 		}
 
-		bool contains(glm::vec2& point)
+		bool contains(const rvec2& point)
 		{
 			return (point.x >= top_left.x && point.x <= bottom_right.x && point.y >= bottom_right.y && point.y <= top_left.y);
 		}
@@ -115,17 +127,17 @@ namespace geometry
 			return false;
 		}
 
-		rectangle offset(float o)
+		rectangle offset(real o)
 		{
 			return rectangle(top_left.x - o, top_left.y + o, bottom_right.x + o, bottom_right.y - o);
 		}
 
 		void max()
 		{
-			top_left.x = (std::numeric_limits<float>::max)();
-			top_left.y = -(std::numeric_limits<float>::max)();
-			bottom_right.x = -(std::numeric_limits<float>::max)();
-			bottom_right.y = (std::numeric_limits<float>::max)();
+			top_left.x = (std::numeric_limits<real>::max)();
+			top_left.y = -(std::numeric_limits<real>::max)();
+			bottom_right.x = -(std::numeric_limits<real>::max)();
+			bottom_right.y = (std::numeric_limits<real>::max)();
 		}
 	};
 
@@ -134,7 +146,7 @@ namespace geometry
 	/// </summary>
 	/// <param name="p">Point to test</param>
 	/// <returns>Angle in radiant</returns>
-	float angle(glm::vec2 p);
+	real angle(rvec2 p);
 	
 	/// <summary>
 	/// Return angle in radiant between -pi and pi with horizontal and origin
@@ -142,7 +154,7 @@ namespace geometry
 	/// <param name="p">Point to test</param>
 	/// <param name="center">offset center</param>
 	/// <returns>Angle in radiant</returns>
-	float angle(glm::vec2 p, glm::vec2 origin);
+	real angle(rvec2 p, rvec2 origin);
 
 	/// <summary>
 	/// Return angle in radiant between 0 and 2*pi, [2PI]
@@ -150,7 +162,7 @@ namespace geometry
 	/// </summary>
 	/// <param name="p">Point to test</param>
 	/// <returns>Angle in radiant</returns>
-	float oriented_angle(glm::vec2 p);
+	real oriented_angle(rvec2 p);
 
 	/// <summary>
 	/// Return angle in radiant between 0 and 2*pi, [2PI]
@@ -159,7 +171,7 @@ namespace geometry
 	/// <param name="p"></param>
 	/// <param name="origin"></param>
 	/// <returns></returns>
-	float oriented_angle(glm::vec2 p, glm::vec2 origin);
+	real oriented_angle(rvec2 p, rvec2 origin);
 
 	/// <summary>
 	/// Return angle between 3 points between 0 and 2*pi, [2PI]
@@ -168,35 +180,35 @@ namespace geometry
 	/// <param name="origin"></param>
 	/// <param name="p2"></param>
 	/// <returns></returns>
-	float oriented_angle(glm::vec2 p1, glm::vec2 p2, glm::vec2 origin);
+	real oriented_angle(rvec2 p1, rvec2 p2, rvec2 origin);
 
 	/// <summary>
 	/// Convert radian angle between -PI and PI to an angle between 0 and 2*PI, [2PI]
 	/// </summary>
 	/// <param name="radian"></param>
 	/// <returns></returns>
-	float oriented_angle(float radian);
+	real oriented_angle(real radian);
 
 	/// <summary>
 	/// Return oriented arc angle between 0 and 2*PI, [2PI]
 	/// </summary>
 	/// <param name="radian"></param>
 	/// <returns></returns>
-	float oriented_angle(float a_start, float a_stop, bool cw);
+	real oriented_angle(real a_start, real a_stop, bool cw);
 
 	/// <summary>
 	/// Return oriented arc angle between 0 and 2*PI, [2PI]
 	/// </summary>
 	/// <param name="radian"></param>
 	/// <returns></returns>
-	float oriented_angle(glm::vec2 p1, glm::vec2 p2, bool cw);
+	real oriented_angle(rvec2 p1, rvec2 p2, bool cw);
 
 	/// <summary>
 	/// Return oriented arc angle between 0 and 2*PI
 	/// </summary>
 	/// <param name="radian"></param>
 	/// <returns></returns>
-	float oriented_angle(glm::vec2 p1, glm::vec2 p2, glm::vec2 origin, bool cw);
+	real oriented_angle(rvec2 p1, rvec2 p2, rvec2 origin, bool cw);
 
 	/// <summary>
 	/// Return the distance between 2 points
@@ -204,7 +216,7 @@ namespace geometry
 	/// <param name="p1">first ref_point</param>
 	/// <param name="p2">second ref_point</param>
 	/// <returns>the square distance</returns>
-	float distance(glm::vec2 p1, glm::vec2 p2);
+	real distance(rvec2 p1, rvec2 p2);
 
 	/// <summary>
 	/// Return the square distance between 2 points
@@ -212,7 +224,7 @@ namespace geometry
 	/// <param name="p1">first ref_point</param>
 	/// <param name="p2">second ref_point</param>
 	/// <returns>the square distance</returns>
-	float distance2(glm::vec2 p1, glm::vec2 p2);
+	real distance2(rvec2 p1, rvec2 p2);
 
 	/// <summary>
 	/// Return square orthogonal distance between a ref_point and a line going through p1 and p2
@@ -221,7 +233,7 @@ namespace geometry
 	/// <param name="p2"></param>
 	/// <param name="ref_point"></param>
 	/// <returns></returns>
-	float foretriangle2(glm::vec2 p1, glm::vec2 p2, glm::vec2 point);
+	real foretriangle2(rvec2 p1, rvec2 p2, rvec2 point);
 
 	/// <summary>
 	/// Return orthogonal distance between a ref_point and a line going through p1 and p2
@@ -230,7 +242,7 @@ namespace geometry
 	/// <param name="p2"></param>
 	/// <param name="ref_point"></param>
 	/// <returns></returns>
-	float foretriangle(glm::vec2& p1, glm::vec2& p2, glm::vec2& point);
+	real foretriangle(const rvec2& p1, const rvec2& p2, const rvec2& point);
 
 	/// <summary>
 	/// Test if ref_point inside rectangle
@@ -239,7 +251,7 @@ namespace geometry
 	/// <param name="bottom_right"></param>
 	/// <param name="ref_point"></param>
 	/// <returns></returns>
-	bool rectangle_contains(glm::vec2& top_left, glm::vec2& bottom_right, glm::vec2& point);
+	bool rectangle_contains(const rvec2& top_left, const rvec2& bottom_right, const rvec2& point);
 	
 	/// <summary>
 	/// Test if ref_point inside rectangle
@@ -247,7 +259,7 @@ namespace geometry
 	/// <param name="r"></param>
 	/// <param name="ref_point"></param>
 	/// <returns></returns>
-	bool rectangle_contains(rectangle& r, glm::vec2& point);
+	bool rectangle_contains(rectangle& r, const rvec2& point);
 
 	/// <summary>
 	/// Test if ref_point inside rectangle
@@ -256,7 +268,7 @@ namespace geometry
 	/// <param name="bottom_right"></param>
 	/// <param name="ref_point"></param>
 	/// <returns></returns>
-	bool rectangle_contains(float top, float left, float bottom, float right, glm::vec2& point);
+	bool rectangle_contains(real top, real left, real bottom, real right, const rvec2& point);
 
 	/// <summary>
 	/// Test if rectangle 2 intersect or inside rectangle 1
@@ -266,7 +278,7 @@ namespace geometry
 	/// <param name="top_left2"></param>
 	/// <param name="bottom_right2"></param>
 	/// <returns></returns>
-	bool rectangle_contains(glm::vec2& top_left1, glm::vec2& bottom_right1, glm::vec2& top_left2, glm::vec2& bottom_right2);
+	bool rectangle_contains(const rvec2& top_left1, const rvec2& bottom_right1, const rvec2& top_left2, const rvec2& bottom_right2);
 	
 	/// <summary>
 	/// Test if rectangle 2 intersect or inside rectangle 1
@@ -284,7 +296,7 @@ namespace geometry
 	/// <param name="top_left2"></param>
 	/// <param name="bottom_right2"></param>
 	/// <returns></returns>
-	bool rectangle_intersect(glm::vec2& top_left1, glm::vec2& bottom_right1, glm::vec2& top_left2, glm::vec2& bottom_right2);
+	bool rectangle_intersect(const rvec2& top_left1, const rvec2& bottom_right1, const rvec2& top_left2, const rvec2& bottom_right2);
 
 	/// <summary>
 	/// Return true if the two rectangles intersects
@@ -302,7 +314,7 @@ namespace geometry
 	/// <param name="top_left2"></param>
 	/// <param name="bottom_right2"></param>
 	/// <returns></returns>
-	bool rectangle_outside(glm::vec2& top_left1, glm::vec2& bottom_right1, glm::vec2& top_left2, glm::vec2& bottom_right2);
+	bool rectangle_outside(const rvec2& top_left1, const rvec2& bottom_right1, const rvec2& top_left2, const rvec2& bottom_right2);
 
 	/// <summary>
 	/// Return true if rectangles are strickly outside, no contains and no intersect
@@ -387,7 +399,7 @@ namespace geometry
 	/// <param name="stop"></param>
 	/// <param name="cw"></param>
 	/// <returns></returns>
-	rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw);
+	rectangle arc_bounds(rvec2 start, rvec2 center, rvec2 stop, bool cw);
 	
 	/// <summary>
 	/// Return the bounds of an arc.
@@ -398,7 +410,7 @@ namespace geometry
 	/// <param name="radius"></param>
 	/// <param name="cw"></param>
 	/// <returns></returns>
-	rectangle arc_bounds(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw);
+	rectangle arc_bounds(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw);
 
 	/// <summary>
 	/// Return the center of a circle going through 3 points
@@ -407,7 +419,7 @@ namespace geometry
 	/// <param name="p2"></param>
 	/// <param name="p3"></param>
 	/// <returns></returns>
-	glm::vec2 circle_center(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3);
+	rvec2 circle_center(rvec2 p1, rvec2 p2, rvec2 p3);
 
 	/// <summary>
 	/// Return true if ref_point is part of arc
@@ -418,7 +430,7 @@ namespace geometry
 	/// <param name="cw"></param>
 	/// <param name="ref_point"></param>
 	/// <returns></returns>
-	bool arc_point(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 point, float err = ERR_FLOAT);
+	bool arc_point(rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 point, real err = ERR_FLOAT);
 
 	/// <summary>
 	/// Return true if ref_point is part of arc
@@ -431,7 +443,7 @@ namespace geometry
 	/// <param name="ref_point"></param>
 	/// <param name="err"></param>
 	/// <returns></returns>
-	bool arc_point(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw, glm::vec2 point, float err = ERR_FLOAT);
+	bool arc_point(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw, rvec2 point, real err = ERR_FLOAT);
 
 	/// <summary>
 	/// Return true if ref_point is part of arc, radius is not tested, ref_point is supposed to be on circle
@@ -442,7 +454,7 @@ namespace geometry
 	/// <param name="cw">if true, clockwise</param>
 	/// <param name="ref_point">coordinates to test</param>
 	/// <returns></returns>
-	bool colinear_arc_point(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 point);
+	bool colinear_arc_point(rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 point);
 
 	/// <summary>
 	/// Return true if ref_point is part of arc, radius is not tested, ref_point is supposed to be on circle
@@ -453,7 +465,7 @@ namespace geometry
 	/// <param name="cw">if true, clockwise</param>
 	/// <param name="ref_point">coordinates to test</param>
 	/// <returns></returns>
-	bool colinear_arc_point(float start, glm::vec2 center, float stop, bool cw, glm::vec2 point);
+	bool colinear_arc_point(real start, rvec2 center, real stop, bool cw, rvec2 point);
 
 	/// <summary>
 	/// Return the coordinates of the middle ref_point of arc. Axe [center;middle] is symmetry axe of arc.
@@ -463,7 +475,7 @@ namespace geometry
 	/// <param name="stop"></param>
 	/// <param name="cw"></param>
 	/// <returns></returns>
-	glm::vec2 arc_middle(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw);
+	rvec2 arc_middle(rvec2 start, rvec2 center, rvec2 stop, bool cw);
 	
 	/// <summary>
 	/// Return the coordinates of the middle ref_point of arc. Axe [center;middle] is symmetry axe of arc.
@@ -474,7 +486,7 @@ namespace geometry
 	/// <param name="radius"></param>
 	/// <param name="cw"></param>
 	/// <returns></returns>
-	glm::vec2 arc_middle(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw);
+	rvec2 arc_middle(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw);
 
 	/// <summary>
 	/// Return the thickness of an arc, the distance between the arc middle ref_point and the middle ref_point between start and stop
@@ -484,7 +496,7 @@ namespace geometry
 	/// <param name="stop"></param>
 	/// <param name="cw"></param>
 	/// <returns></returns>
-	float arc_thickness(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw);
+	real arc_thickness(rvec2 start, rvec2 center, rvec2 stop, bool cw);
 	
 	/// <summary>
 	/// Return the thickness of an arc, the distance between the arc middle ref_point and the middle ref_point between start and stop
@@ -495,7 +507,7 @@ namespace geometry
 	/// <param name="radius"></param>
 	/// <param name="cw"></param>
 	/// <returns></returns>
-	float arc_thickness(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw);
+	real arc_thickness(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw);
 
 	/// <summary>
 	/// Return the length of an arc
@@ -505,7 +517,7 @@ namespace geometry
 	/// <param name="stop"></param>
 	/// <param name="cw"></param>
 	/// <returns></returns>
-	float arc_length(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw);
+	real arc_length(rvec2 start, rvec2 center, rvec2 stop, bool cw);
 
 	/// <summary>
 	/// Return the length of an arc
@@ -516,7 +528,7 @@ namespace geometry
 	/// <param name="radius"></param>
 	/// <param name="cw"></param>
 	/// <returns></returns>
-	float arc_length(glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw);
+	real arc_length(rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw);
 
 	/// <summary>
 	/// If test ref_point is before start, return -1, if test is between start ans stop return 0, if after stop return 1
@@ -527,7 +539,7 @@ namespace geometry
 	/// <param name="cw"></param>
 	/// <param name="test"></param>
 	/// <returns></returns>
-	int arc_position(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 test);
+	int arc_position(rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 test);
 
 	/// <summary>
 	/// If test ref_point is before start return true
@@ -538,7 +550,7 @@ namespace geometry
 	/// <param name="cw"></param>
 	/// <param name="test"></param>
 	/// <returns></returns>
-	bool arc_position_left(glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 test);
+	bool arc_position_left(rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 test);
 
 	/// <summary>
 	/// Return coordinates on a circle from angle and radius
@@ -546,7 +558,7 @@ namespace geometry
 	/// <param name="angle">angle in radian</param>
 	/// <param name="radius">radius</param>
 	/// <returns>coordinates</returns>
-	glm::vec2 position(float angle, float radius);
+	rvec2 position(real angle, real radius);
 
 	/// <summary>
 	/// Return coordinates on a circle from angle and radius
@@ -555,7 +567,7 @@ namespace geometry
 	/// <param name="radius">radius</param>
 	/// <param name="origin">position of the center of circle</param>
 	/// <returns></returns>
-	glm::vec2 position(float angle, float radius, glm::vec2 origin);
+	rvec2 position(real angle, real radius, rvec2 origin);
 
 	/// <summary>
 	/// Return coordinates on a circle from angle and radius
@@ -564,7 +576,7 @@ namespace geometry
 	/// <param name="radius">radius to apply</param>
 	/// <param name="origin">position of the center of circle</param>
 	/// <returns></returns>
-	glm::vec2 position(glm::vec2 source, float radius, glm::vec2 origin);
+	rvec2 position(rvec2 source, real radius, rvec2 origin);
 
 	/// <summary>
 	/// convert a float/double to string with a decimal precision number
@@ -677,7 +689,7 @@ namespace geometry
 	/// <param name="p1">first segment ref_point</param>
 	/// <param name="p2">second segment ref_point</param>
 	/// <returns>coordinates of projection</returns>
-	glm::vec2 projection(glm::vec2 p, glm::vec2 p1, glm::vec2 p2);
+	rvec2 projection(rvec2 p, rvec2 p1, rvec2 p2);
 
 	/// <summary>
 	/// return the symmetry ref_point with an axe of symmetry
@@ -702,7 +714,7 @@ namespace geometry
 	/// <param name="p1"></param>
 	/// <param name="p2"></param>
 	/// <returns></returns>
-	glm::vec2 middle(glm::vec2 p1, glm::vec2 p2);
+	rvec2 middle(rvec2 p1, rvec2 p2);
 
 	/// <summary>
 	/// Return true if test ref_point is between p1 and p2.
@@ -711,7 +723,7 @@ namespace geometry
 	/// <param name="p2"></param>
 	/// <param name="test"></param>
 	/// <returns></returns>
-	bool segment_point(glm::vec2 p1, glm::vec2 p2, glm::vec2 test);
+	bool segment_point(rvec2 p1, rvec2 p2, rvec2 test);
 
 	/// <summary>
 	/// Return true if test ref_point is between p1 and p2. test ref_point is supposed to be colinear.
@@ -720,8 +732,8 @@ namespace geometry
 	/// <param name="p2"></param>
 	/// <param name="test"></param>
 	/// <returns></returns>
-	bool colinear_segment_point(glm::vec2 p1, glm::vec2 p2, glm::vec2 test);
-	bool colinear_segment_point(glm::vec2 p1, glm::vec2 p2, glm::vec2 test, float err);
+	bool colinear_segment_point(rvec2 p1, rvec2 p2, rvec2 test);
+	bool colinear_segment_point(rvec2 p1, rvec2 p2, rvec2 test, real err);
 	/// <summary>
 	/// Return true if segments are colinear.
 	/// </summary>
@@ -730,7 +742,7 @@ namespace geometry
 	/// <param name="p3"></param>
 	/// <param name="p4"></param>
 	/// <returns></returns>
-	bool colinear_segments(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4);
+	bool colinear_segments(rvec2 p1, rvec2 p2, rvec2 p3, rvec2 p4);
 
 
 	/// <summary>
@@ -741,7 +753,7 @@ namespace geometry
 	/// <param name="stop"></param>
 	/// <param name="test"></param>
 	/// <returns></returns>
-	int segment_position(glm::vec2 start, glm::vec2 stop, glm::vec2 test);
+	int segment_position(rvec2 start, rvec2 stop, rvec2 test);
 
 	/// <summary>
 	/// If test ref_point is before start return true
@@ -751,7 +763,7 @@ namespace geometry
 	/// <param name="stop"></param>
 	/// <param name="test"></param>
 	/// <returns></returns>
-	bool segment_position_left(glm::vec2 start, glm::vec2 stop, glm::vec2 test);
+	bool segment_position_left(rvec2 start, rvec2 stop, rvec2 test);
 
 	/// <summary>
 	/// Return true if lines itersect. Coordinates are stored in result.
@@ -762,7 +774,7 @@ namespace geometry
 	/// <param name="p4"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	bool line_line_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4, glm::vec2& result);
+	bool line_line_intersect(rvec2 p1, rvec2 p2, rvec2 p3, rvec2 p4, rvec2& result);
 
 	/// <summary>
 	/// Return true if segments itersect. Coordinates are stored in result.
@@ -773,7 +785,7 @@ namespace geometry
 	/// <param name="p4"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	bool segment_segment_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 p3, glm::vec2 p4, glm::vec2& result);
+	bool segment_segment_intersect(rvec2 p1, rvec2 p2, rvec2 p3, rvec2 p4, rvec2& result);
 
 	/// <summary>
 	/// Return true if a segment intersect with a polyline. Coordinates are stored in result.
@@ -795,8 +807,8 @@ namespace geometry
 	/// <param name="result"></param>
 	/// <param name="err"></param>
 	/// <returns></returns>
-	int line_circle_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float radius, glm::vec2 result[2], float err = ERR_FLOAT);
-	int line_circle_intersect2(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float radius, glm::vec2 result[2], float err = ERR_FLOAT);
+	int line_circle_intersect(rvec2 p1, rvec2 p2, rvec2 center, real radius, rvec2 result[2], real err = ERR_FLOAT);
+	int line_circle_intersect2(rvec2 p1, rvec2 p2, rvec2 center, real radius, rvec2 result[2], real err = ERR_FLOAT);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between a segment and a circle. Coordinates are stored in result.
@@ -807,7 +819,7 @@ namespace geometry
 	/// <param name="radius"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int segment_circle_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 center, float radius, glm::vec2 result[2]);
+	int segment_circle_intersect(rvec2 p1, rvec2 p2, rvec2 center, real radius, rvec2 result[2]);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between a circle and a circle. Coordinates are stored in result.
@@ -818,7 +830,7 @@ namespace geometry
 	/// <param name="r2"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int circle_circle_intersect(glm::vec2 c1, float r1, glm::vec2 c2, float r2, glm::vec2 result[2]);
+	int circle_circle_intersect(rvec2 c1, real r1, rvec2 c2, real r2, rvec2 result[2]);
 
 	/// <summary>
 	/// Return the number of intersections between a circle and a polyline. Coordinates are stored in result.
@@ -843,7 +855,7 @@ namespace geometry
 	/// <param name="result"></param>
 	/// <param name="err"></param>
 	/// <returns></returns>
-	int line_arc_intersect(glm::vec2 p1, glm::vec2 p2, float start, glm::vec2 center, float stop, float radius, bool cw, glm::vec2 result[2], float err = ERR_FLOAT);
+	int line_arc_intersect(rvec2 p1, rvec2 p2, real start, rvec2 center, real stop, real radius, bool cw, rvec2 result[2], real err = ERR_FLOAT);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between a line and an arc. Coordinates are stored in result.
@@ -858,7 +870,7 @@ namespace geometry
 	/// <param name="result"></param>
 	/// <param name="err"></param>
 	/// <returns></returns>
-	int line_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw, glm::vec2 result[2], float err = ERR_FLOAT);
+	int line_arc_intersect(rvec2 p1, rvec2 p2, rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw, rvec2 result[2], real err = ERR_FLOAT);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between a line and an arc. Coordinates are stored in result.
@@ -872,7 +884,7 @@ namespace geometry
 	/// <param name="result"></param>
 	/// <param name="err"></param>
 	/// <returns></returns>
-	int line_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 result[2], float err = ERR_FLOAT);
+	int line_arc_intersect(rvec2 p1, rvec2 p2, rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 result[2], real err = ERR_FLOAT);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between a segment and an arc. Coordinates are stored in result.
@@ -886,7 +898,7 @@ namespace geometry
 	/// <param name="cw"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int segment_arc_intersect(glm::vec2 p1, glm::vec2 p2, float start, glm::vec2 center, float stop, float radius, bool cw, glm::vec2 result[2]);
+	int segment_arc_intersect(rvec2 p1, rvec2 p2, real start, rvec2 center, real stop, real radius, bool cw, rvec2 result[2]);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between a segment and an arc. Coordinates are stored in result.
@@ -899,7 +911,7 @@ namespace geometry
 	/// <param name="cw"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int segment_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2 center, glm::vec2 stop, bool cw, glm::vec2 result[2]);
+	int segment_arc_intersect(rvec2 p1, rvec2 p2, rvec2 start, rvec2 center, rvec2 stop, bool cw, rvec2 result[2]);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between a segment and an arc. Coordinates are stored in result.
@@ -913,7 +925,7 @@ namespace geometry
 	/// <param name="cw"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int segment_arc_intersect(glm::vec2 p1, glm::vec2 p2, glm::vec2 start, glm::vec2 center, glm::vec2 stop, float radius, bool cw, glm::vec2 result[2]);
+	int segment_arc_intersect(rvec2 p1, rvec2 p2, rvec2 start, rvec2 center, rvec2 stop, real radius, bool cw, rvec2 result[2]);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between an arc and a circle. Coordinates are stored in result.
@@ -927,7 +939,7 @@ namespace geometry
 	/// <param name="circle_radius"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int arc_circle_intersect(float arc_start, glm::vec2 arc_center, float arc_stop, float arc_radius, bool arc_cw, glm::vec2 circle_center, float circle_radius, glm::vec2 result[2]);
+	int arc_circle_intersect(real arc_start, rvec2 arc_center, real arc_stop, real arc_radius, bool arc_cw, rvec2 circle_center, real circle_radius, rvec2 result[2]);
 	
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between an arc and a circle. Coordinates are stored in result.
@@ -940,7 +952,7 @@ namespace geometry
 	/// <param name="circle_radius"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int arc_circle_intersect(glm::vec2 arc_start, glm::vec2 arc_center, glm::vec2 arc_stop, bool arc_cw, glm::vec2 circle_center, float circle_radius, glm::vec2 result[2]);
+	int arc_circle_intersect(rvec2 arc_start, rvec2 arc_center, rvec2 arc_stop, bool arc_cw, rvec2 circle_center, real circle_radius, rvec2 result[2]);
 	
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between an arc and a circle. Coordinates are stored in result.
@@ -954,7 +966,7 @@ namespace geometry
 	/// <param name="circle_radius"></param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int arc_circle_intersect(glm::vec2 arc_start, glm::vec2 arc_center, glm::vec2 arc_stop, float arc_radius, bool arc_cw, glm::vec2 circle_center, float circle_radius, glm::vec2 result[2]);
+	int arc_circle_intersect(rvec2 arc_start, rvec2 arc_center, rvec2 arc_stop, real arc_radius, bool arc_cw, rvec2 circle_center, real circle_radius, rvec2 result[2]);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between two arcs. Coordinates are stored in result.
@@ -971,7 +983,7 @@ namespace geometry
 	/// <param name="cw2">true if arc is clockwise</param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int arc_arc_intersect(float start1, glm::vec2 c1, float stop1, float r1, bool cw1, float start2, glm::vec2 c2, float stop2, float r2, bool cw2, glm::vec2 result[2]);
+	int arc_arc_intersect(real start1, rvec2 c1, real stop1, real r1, bool cw1, real start2, rvec2 c2, real stop2, real r2, bool cw2, rvec2 result[2]);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between two arcs. Coordinates are stored in result.
@@ -986,7 +998,7 @@ namespace geometry
 	/// <param name="cw2">true if arc is clockwise</param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int arc_arc_intersect(glm::vec2 start1, glm::vec2 c1, glm::vec2 stop1, bool cw1, glm::vec2 start2, glm::vec2 c2, glm::vec2 stop2, bool cw2, glm::vec2 result[2]);
+	int arc_arc_intersect(rvec2 start1, rvec2 c1, rvec2 stop1, bool cw1, rvec2 start2, rvec2 c2, rvec2 stop2, bool cw2, rvec2 result[2]);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between two arcs. Coordinates are stored in result.
@@ -1003,7 +1015,7 @@ namespace geometry
 	/// <param name="cw2">true if arc is clockwise</param>
 	/// <param name="result"></param>
 	/// <returns></returns>
-	int arc_arc_intersect(glm::vec2 start1, glm::vec2 c1, glm::vec2 stop1, float r1, bool cw1, glm::vec2 start2, glm::vec2 c2, glm::vec2 stop2, float r2, bool cw2, glm::vec2 result[2]);
+	int arc_arc_intersect(rvec2 start1, rvec2 c1, rvec2 stop1, real r1, bool cw1, rvec2 start2, rvec2 c2, rvec2 stop2, real r2, bool cw2, rvec2 result[2]);
 
 	/// <summary>
 	/// Return the number of intersections (0, 1  or 2) between an arc and a polyline. Coordinates are stored in result.
@@ -0,0 +1,145 @@
+#include "jobs.h"
+#include <logger.h>
+#include <algorithm>
+#include <exception>
+
+std::vector<std::thread> Jobs::_threads;
+std::map<const void*, Jobs::Slot> Jobs::_slots;
+std::deque<const void*> Jobs::_ready;
+std::mutex Jobs::_mutex;
+std::condition_variable Jobs::_wake;
+std::condition_variable Jobs::_done;
+bool Jobs::_exit = false;
+
+void Jobs::execute(std::function<void()>& job)
+{
+	try
+	{
+		job();
+	}
+	catch (const std::exception& e)
+	{
+		Logger::log(std::string("background job error : ") + e.what());
+	}
+	catch (...)
+	{
+		Logger::log("background job error");
+	}
+}
+
+void Jobs::loop()
+{
+	while (true)
+	{
+		const void* key = nullptr;
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [] { return _exit || !_ready.empty(); });
+			if (_exit)
+				return;
+			key = _ready.front();
+			_ready.pop_front();
+
+			Slot& slot = _slots[key];
+			job = std::move(slot.waiting);
+			slot.waiting = nullptr;
+			slot.running = true;
+		}
+
+		execute(job);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			Slot& slot = _slots[key];
+			slot.running = false;
+			if (slot.waiting)
+				_ready.push_back(key);
+			else
+				_slots.erase(key);
+		}
+		_wake.notify_one();
+		_done.notify_all();
+	}
+}
+
+void Jobs::start(unsigned int count)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	// already started or stopped for good
+	if (_threads.size() > 0 || _exit)
+		return;
+
+	for (unsigned int i = 0; i < std::max(1u, count); i++)
+		_threads.push_back(std::thread(&loop));
+}
+
+void Jobs::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_exit = true;
+	}
+	_wake.notify_all();
+
+	for (auto& t : _threads)
+		t.join();
+	_threads.clear();
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_slots.clear();
+		_ready.clear();
+	}
+	_done.notify_all();
+}
+
+void Jobs::post(const void* key, std::function<void()> job)
+{
+	start();
+
+	bool queued = false;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_exit)
+		{
+			Slot& slot = _slots[key];
+			if (!slot.running && !slot.waiting)
+				_ready.push_back(key);
+			slot.waiting = std::move(job);
+			queued = true;
+		}
+	}
+
+	// no background thread anymore, the job runs now
+	if (queued)
+		_wake.notify_one();
+	else
+		execute(job);
+}
+
+void Jobs::wait(const void* key)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [key] { return _slots.find(key) == _slots.end(); });
+}
+
+void Jobs::cancel(const void* key)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	auto it = _slots.find(key);
+	if (it == _slots.end())
+		return;
+
+	it->second.waiting = nullptr;
+	if (!it->second.running)
+	{
+		_slots.erase(it);
+		_ready.erase(std::remove(_ready.begin(), _ready.end(), key), _ready.end());
+		return;
+	}
+
+	_done.wait(lock, [key] { return _slots.find(key) == _slots.end(); });
+}
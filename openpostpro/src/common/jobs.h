@@ -0,0 +1,76 @@
+#pragma once
+#ifndef _JOBS_H
+#define _JOBS_H
+
+#include <vector>
+#include <map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/************************************************************************
+* Background jobs
+* A job runs on a background thread, its loops still use the worker pool.
+* Jobs are posted with a key, the object they compute : a key has at most
+* one running job and one waiting job. A job posted while another one is
+* waiting replaces it, so a burst of changes only runs the first and the
+* last one. Jobs of different keys run at the same time
+*************************************************************************/
+class Jobs
+{
+private:
+	struct Slot
+	{
+		bool running = false;
+		std::function<void()> waiting;
+	};
+
+	static std::vector<std::thread> _threads;
+	static std::map<const void*, Slot> _slots;	// keys with a running or waiting job
+	static std::deque<const void*> _ready;		// keys with a waiting job and no running one
+	static std::mutex _mutex;
+	static std::condition_variable _wake;
+	static std::condition_variable _done;
+	static bool _exit;
+
+	/// <summary>
+	/// Thread loop
+	/// </summary>
+	static void loop();
+
+	/// <summary>
+	/// Run a job, errors are logged
+	/// </summary>
+	static void execute(std::function<void()>& job);
+
+public:
+	/// <summary>
+	/// Start the background threads, called on first post. Once stopped, jobs run inline
+	/// <param name="count">thread count</param>
+	/// </summary>
+	static void start(unsigned int count = 2);
+
+	/// <summary>
+	/// Stop and join the background threads, waiting jobs are dropped
+	/// </summary>
+	static void stop();
+
+	/// <summary>
+	/// Run job in the background after the running job of key, replacing the job of key waiting for it
+	/// </summary>
+	static void post(const void* key, std::function<void()> job);
+
+	/// <summary>
+	/// Return when key has no running or waiting job
+	/// </summary>
+	static void wait(const void* key);
+
+	/// <summary>
+	/// Drop the waiting job of key and return when its running job is done
+	/// </summary>
+	static void cancel(const void* key);
+};
+
+#endif
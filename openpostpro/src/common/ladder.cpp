@@ -0,0 +1,146 @@
+#include "ladder.h"
+#include <workers.h>
+#include <boolean.h>
+#include <arena.h>
+#include <algorithm>
+
+std::vector<OffsetLadder::Region> OffsetLadder::regions(std::vector<Curve>& curves)
+{
+	std::vector<Region> result;
+
+	if (curves.size() == 0)
+		return result;
+
+	// curves are extracted by couple of levels 1-2, 3-4, 5-6...
+	std::vector<Curve> sorted = curves;
+	Curve::sort_level(sorted);
+
+	int ref = 1;
+	result.push_back(Region());
+	for (Curve& c : sorted)
+	{
+		if (!(c.level() == ref || c.level() == ref + 1) && result.back().curves.size() > 0)
+		{
+			ref += 2;
+			result.push_back(Region());
+		}
+		result.back().curves.push_back(std::move(c));
+	}
+
+	for (Region& r : result)
+		r.level = r.curves.front().level();
+
+	return result;
+}
+
+std::vector<Curve> OffsetLadder::resolve(std::vector<Curve>& curves, int level)
+{
+	std::vector<Curve> result;
+	CurveBoolean b;
+	bool cw = false;
+	bool found = false;
+
+	// outer curves are filled, islands are holes, all at once
+	for (Curve& c : curves)
+	{
+		if (c.level() == level)
+		{
+			if (!found)
+				cw = c.cw();
+			found = true;
+			b.add(c, CurveBoolean::Fill::add);
+		}
+		else
+			b.add(c, CurveBoolean::Fill::subtract);
+	}
+
+	if (!found)
+		return result;
+
+	result = b.compute(cw);
+	for (Curve& c : result)
+		c.level(c.cw() == cw ? level : level + 1);
+
+	return result;
+}
+
+std::vector<Curve> OffsetLadder::merge(std::vector<Curve>& curves)
+{
+	std::vector<Curve> result;
+
+	for (Region& r : regions(curves))
+	{
+		auto resolved = resolve(r.curves, r.level);
+		result.insert(result.end(), std::make_move_iterator(resolved.begin()), std::make_move_iterator(resolved.end()));
+	}
+
+	return result;
+}
+
+std::vector<Curve> OffsetLadder::ring(Region& r, geometry::real distance)
+{
+	std::vector<Curve> curves;
+	bool outer = false;
+
+	// outer curves shrink, islands grow
+	for (Curve& c : r.curves)
+	{
+		auto offsets = c.offset(c.level() == r.level ? -distance : distance);
+		if (c.level() == r.level && offsets.size() > 0)
+			outer = true;
+		curves.insert(curves.end(), std::make_move_iterator(offsets.begin()), std::make_move_iterator(offsets.end()));
+	}
+
+	if (!outer)
+		return std::vector<Curve>();
+
+	return resolve(curves, r.level);
+}
+
+OffsetLadder::OffsetLadder(std::vector<Curve>& curves)
+{
+	_regions = regions(curves);
+}
+
+std::vector<Curve> OffsetLadder::rings(geometry::real step)
+{
+	std::vector<Curve> result;
+
+	if (step <= 0)
+		return result;
+
+	// a loop started from a worker thread runs inline, rings are then computed one by one to stop on the first empty ring
+	size_t batch = Workers::worker() ? 1 : Workers::size() + 1;
+
+	for (Region& r : _regions)
+	{
+		// caches and spatial index of the region are shared by all its rings
+		for (Curve& c : r.curves)
+			c.prepare();
+
+		size_t done = 0;
+		bool eroded = false;
+		while (!eroded)
+		{
+			std::vector<std::vector<Curve>> rings(batch);
+			Workers::run(batch, [&r, &rings, step, done](size_t i) {
+				Arena::Scope arena;
+				rings[i] = ring(r, step * (geometry::real)(done + i + 1));
+				});
+
+			// erosion only shrinks the region, rings after an empty ring are empty too
+			for (auto& curves : rings)
+			{
+				if (curves.size() == 0)
+				{
+					eroded = true;
+					break;
+				}
+				result.insert(result.end(), std::make_move_iterator(curves.begin()), std::make_move_iterator(curves.end()));
+			}
+			done += batch;
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#ifndef LADDER_H
+#define LADDER_H
+
+#include <curve.h>
+#include <vector>
+
+/// <summary>
+/// Parallel ladder of the successive inner offsets of pocket regions.
+/// A region is bounded by outer curves of level n and island curves of level n + 1, several regions can be given at once (levels 1-2, 3-4...).
+/// Ring k is the boundary of the region eroded by k * step, offset from the region itself : the rings do not depend on each other and
+/// a batch of them is computed on the worker pool, the caches and spatial index of the region being prepared once. A ring is not offset
+/// from the previous one, where islands touch the outer curve that ring touches itself and the offset kernel fails on it.
+/// Each ring costs a full offset of the region and a boolean, the ladder is not computed in one pass over the region
+/// (no skeleton of the region), only the wall time is divided by the number of workers.
+/// </summary>
+class OffsetLadder
+{
+private:
+	struct Region
+	{
+		int level = 0;				// level of the outer curves, islands are the other curves
+		std::vector<Curve> curves;
+	};
+
+	std::vector<Region> _regions;
+
+	/// <summary>
+	/// Group curves by region, levels 1-2, 3-4...
+	/// </summary>
+	static std::vector<Region> regions(std::vector<Curve>& curves);
+
+	/// <summary>
+	/// Return the ring of region r at distance, empty if the region is fully eroded
+	/// </summary>
+	static std::vector<Curve> ring(Region& r, geometry::real distance);
+
+public:
+	OffsetLadder(std::vector<Curve>& curves);
+
+	/// <summary>
+	/// Return the rings of each region, region after region and from the outside to the inside, until the region is fully eroded
+	/// </summary>
+	std::vector<Curve> rings(geometry::real step);
+
+	/// <summary>
+	/// Resolve the curves of one region whose outer curves have the given level : the outer curves minus the islands, in one boolean operation.
+	/// Crossing islands are united, outer curves crossed by an island get its boundary,
+	/// the other islands are kept only if they lay inside an outer curve, outer curves inside an island are dropped
+	/// </summary>
+	static std::vector<Curve> resolve(std::vector<Curve>& curves, int level);
+
+	/// <summary>
+	/// Resolve each region of curves, curves of several regions can be given at once
+	/// </summary>
+	static std::vector<Curve> merge(std::vector<Curve>& curves);
+};
+
+#endif
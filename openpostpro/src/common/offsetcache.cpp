@@ -0,0 +1,319 @@
+#include "offsetcache.h"
+#include <stats.h>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+
+std::list<OffsetCache::Entry> OffsetCache::_entries;
+std::unordered_multimap<size_t, std::list<OffsetCache::Entry>::iterator> OffsetCache::_index;
+size_t OffsetCache::_capacity = 0;
+size_t OffsetCache::_bytes = 0;
+unsigned long long OffsetCache::_hits = 0;
+unsigned long long OffsetCache::_misses = 0;
+std::mutex OffsetCache::_mutex;
+
+static const char MAGIC[8] = { 'O', 'P', 'P', 'O', 'F', 'F', 'S', '1' };
+static const size_t LIMIT = 1 << 24;	// larger counts come from a damaged file
+
+static long long quantize(geometry::real value)
+{
+	return std::llround(value / OffsetCache::tolerance);
+}
+
+static long long bits(geometry::real value)
+{
+	double d = value;
+	long long result;
+	std::memcpy(&result, &d, sizeof(result));
+	return result;
+}
+
+static size_t hash(const std::vector<long long>& values)
+{
+	// FNV-1a over the values
+	unsigned long long h = 14695981039346656037ull;
+	for (long long v : values)
+	{
+		h ^= (unsigned long long)v;
+		h *= 1099511628211ull;
+	}
+	return (size_t)h;
+}
+
+/// <summary>
+/// Return a copy of the segments of c moved by delta, nothing else of c is kept
+/// </summary>
+static Curve moved(Curve& c, geometry::rvec2 delta)
+{
+	Curve result;
+	result.reserve(c.size());
+	for (Segment& s : c)
+	{
+		result.add(s.type, s.point + delta, s.center + delta, s.radius, s.cw);
+		result.back().tag = s.tag;
+	}
+	result.level(c.level());
+	result.tag_inside(c.tag_inside());
+	return result;
+}
+
+static size_t bytes(const OffsetCache::Key& key, const std::vector<Curve>& curves)
+{
+	size_t result = sizeof(OffsetCache::Key) + key.values.size() * sizeof(long long);
+	for (const Curve& c : curves)
+		result += sizeof(Curve) + c.size() * sizeof(Segment);
+	return result;
+}
+
+template<typename T> static void put(std::ostream& s, T value)
+{
+	s.write((const char*)&value, sizeof(T));
+}
+
+template<typename T> static T get(std::istream& s)
+{
+	T value = T();
+	s.read((char*)&value, sizeof(T));
+	return value;
+}
+
+void OffsetCache::trim()
+{
+	// least recently used entries are at the back
+	while (_bytes > _capacity && _entries.size() > 0)
+	{
+		auto range = _index.equal_range(_entries.back().key.hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second == std::prev(_entries.end()))
+			{
+				_index.erase(it);
+				break;
+			}
+		}
+		_bytes -= _entries.back().bytes;
+		_entries.pop_back();
+	}
+}
+
+void OffsetCache::capacity(size_t bytes)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_capacity = bytes;
+	trim();
+}
+
+bool OffsetCache::enabled()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _capacity > 0;
+}
+
+OffsetCache::Key OffsetCache::key(Curve& c, geometry::real o, geometry::real max)
+{
+	Key result;
+
+	// the closing point of a closed curve is its first one, any segment can start it
+	bool closed = c.closed();
+	size_t count = closed ? c.size() - 1 : c.size();
+	size_t start = 0;
+	if (closed)
+	{
+		for (size_t i = 1; i < count; i++)
+			if (c[i].point.x < c[start].point.x || (c[i].point.x == c[start].point.x && c[i].point.y < c[start].point.y))
+				start = i;
+	}
+	if (count > 0)
+		result.origin = c[start].point;
+
+	result.values.reserve(3 + count * 6);
+	result.values.push_back(bits(o));
+	result.values.push_back(bits(max));
+	result.values.push_back(closed ? 1 : 0);
+	for (size_t n = 0; n < count; n++)
+	{
+		const Segment& s = c[(start + n) % count];
+		result.values.push_back((long long)s.type * 2 + (s.cw ? 1 : 0));
+		result.values.push_back(quantize(s.point.x - result.origin.x));
+		result.values.push_back(quantize(s.point.y - result.origin.y));
+		if (s.type != SegmentType::Line)
+		{
+			result.values.push_back(quantize(s.center.x - result.origin.x));
+			result.values.push_back(quantize(s.center.y - result.origin.y));
+			result.values.push_back(quantize(s.radius));
+		}
+	}
+	result.hash = hash(result.values);
+
+	return result;
+}
+
+bool OffsetCache::find(const Key& key, std::vector<Curve>& result)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto range = _index.equal_range(key.hash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second->key.values == key.values)
+		{
+			_entries.splice(_entries.begin(), _entries, it->second);
+			result.clear();
+			result.reserve(it->second->curves.size());
+			for (Curve& c : it->second->curves)
+				result.push_back(moved(c, key.origin));
+			_hits++;
+			Stats::add(Stats::offset_hits);
+			return true;
+		}
+	}
+
+	_misses++;
+	Stats::add(Stats::offset_misses);
+	return false;
+}
+
+void OffsetCache::insert(Entry entry)
+{
+	if (entry.bytes > _capacity)
+		return;
+
+	// computed meanwhile by another thread
+	auto range = _index.equal_range(entry.key.hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (it->second->key.values == entry.key.values)
+			return;
+
+	_bytes += entry.bytes;
+	_entries.push_front(std::move(entry));
+	_index.emplace(_entries.front().key.hash, _entries.begin());
+
+	trim();
+}
+
+void OffsetCache::store(const Key& key, std::vector<Curve>& curves)
+{
+	if (!enabled())
+		return;
+
+	Entry entry;
+	entry.key = key;
+	entry.curves.reserve(curves.size());
+	for (Curve& c : curves)
+		entry.curves.push_back(moved(c, -key.origin));
+	entry.bytes = bytes(entry.key, entry.curves);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	insert(std::move(entry));
+}
+
+bool OffsetCache::save(std::string path)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+
+	file.write(MAGIC, sizeof(MAGIC));
+	put<unsigned int>(file, (unsigned int)sizeof(geometry::real));
+	put<unsigned long long>(file, _entries.size());
+	for (Entry& e : _entries)
+	{
+		put<unsigned long long>(file, e.key.values.size());
+		file.write((const char*)e.key.values.data(), e.key.values.size() * sizeof(long long));
+		put<unsigned long long>(file, e.curves.size());
+		for (Curve& c : e.curves)
+		{
+			put<int>(file, c.level());
+			put<int>(file, (int)c.tag_inside());
+			put<unsigned long long>(file, c.size());
+			for (Segment& s : c)
+			{
+				put<int>(file, (int)s.type);
+				put<char>(file, s.cw ? 1 : 0);
+				put<int>(file, s.tag);
+				put<geometry::real>(file, s.point.x);
+				put<geometry::real>(file, s.point.y);
+				put<geometry::real>(file, s.center.x);
+				put<geometry::real>(file, s.center.y);
+				put<geometry::real>(file, s.radius);
+			}
+		}
+	}
+
+	return file.good();
+}
+
+bool OffsetCache::load(std::string path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	char magic[sizeof(MAGIC)] = {};
+	file.read(magic, sizeof(magic));
+	if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || get<unsigned int>(file) != sizeof(geometry::real))
+		return false;
+
+	std::vector<Entry> entries;
+	unsigned long long count = get<unsigned long long>(file);
+	for (unsigned long long n = 0; n < count && file; n++)
+	{
+		Entry e;
+		size_t size = get<unsigned long long>(file);
+		if (!file || size > LIMIT)
+			return false;
+		e.key.values.resize(size);
+		file.read((char*)e.key.values.data(), e.key.values.size() * sizeof(long long));
+		e.key.hash = hash(e.key.values);
+		size = get<unsigned long long>(file);
+		if (!file || size > LIMIT)
+			return false;
+		e.curves.resize(size);
+		for (Curve& c : e.curves)
+		{
+			c.level(get<int>(file));
+			c.tag_inside((Position)get<int>(file));
+			size = get<unsigned long long>(file);
+			if (!file || size > LIMIT)
+				return false;
+			for (size_t i = 0; i < size && file; i++)
+			{
+				SegmentType type = (SegmentType)get<int>(file);
+				bool cw = get<char>(file) != 0;
+				int tag = get<int>(file);
+				geometry::rvec2 point, center;
+				point.x = get<geometry::real>(file);
+				point.y = get<geometry::real>(file);
+				center.x = get<geometry::real>(file);
+				center.y = get<geometry::real>(file);
+				geometry::real radius = get<geometry::real>(file);
+				c.add(type, point, center, radius, cw);
+				c.back().tag = tag;
+			}
+		}
+		if (!file)
+			return false;
+		e.bytes = bytes(e.key, e.curves);
+		entries.push_back(std::move(e));
+	}
+
+	// most recently used last, so they end in front
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+		insert(std::move(*it));
+
+	return true;
+}
+
+std::string OffsetCache::str()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return "offset cache hits: " + std::to_string(_hits) +
+		" misses: " + std::to_string(_misses) +
+		" entries: " + std::to_string(_entries.size()) +
+		" size (KB): " + std::to_string(_bytes / 1024);
+}
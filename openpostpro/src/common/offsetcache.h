@@ -0,0 +1,104 @@
+#pragma once
+#ifndef _OFFSETCACHE_H
+#define _OFFSETCACHE_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <string>
+#include <mutex>
+#include <curve.h>
+
+/************************************************************************
+* Cache of the offset results
+* Curve::offset looks its result up by the shape of the curve and the
+* offset values. The key is quantized to the tolerance and relative to a
+* point of the curve, the lowest one of a closed curve, so a translated copy
+* of a contour or a closed contour starting at another segment finds the
+* same entry. The key is not rotation invariant : a rotated copy would need
+* its result rotated back, off the tolerance the key is quantized to, so it
+* is a separate entry. Results are stored relative to that point and moved
+* back on a hit. Least recently used entries are dropped above the capacity, the
+* cache is disabled until a capacity is set. It can be saved next to the
+* project file
+*************************************************************************/
+class OffsetCache
+{
+public:
+	struct Key
+	{
+		std::vector<long long> values;
+		size_t hash = 0;
+		geometry::rvec2 origin = geometry::rvec2();
+	};
+
+private:
+	struct Entry
+	{
+		Key key;
+		std::vector<Curve> curves;	// relative to the key origin
+		size_t bytes = 0;
+	};
+
+	static std::list<Entry> _entries;		// most recently used first
+	static std::unordered_multimap<size_t, std::list<Entry>::iterator> _index;
+	static size_t _capacity;
+	static size_t _bytes;
+	static unsigned long long _hits;
+	static unsigned long long _misses;
+	static std::mutex _mutex;
+
+	/// <summary>
+	/// Add entry in front, unless already cached. Called locked
+	/// </summary>
+	static void insert(Entry entry);
+
+	/// <summary>
+	/// Drop the least recently used entries above the capacity. Called locked
+	/// </summary>
+	static void trim();
+
+public:
+	/// <summary>
+	/// Quantization step of the key
+	/// </summary>
+	static constexpr geometry::real tolerance = 0.0001;
+
+	/// <summary>
+	/// Set the memory cap in bytes, 0 disables the cache and clears it
+	/// </summary>
+	static void capacity(size_t bytes);
+	static bool enabled();
+
+	/// <summary>
+	/// Build the key of the offset of curve c by o with max reduction
+	/// </summary>
+	static Key key(Curve& c, geometry::real o, geometry::real max);
+
+	/// <summary>
+	/// Return true and the curves of key if cached
+	/// </summary>
+	static bool find(const Key& key, std::vector<Curve>& result);
+
+	/// <summary>
+	/// Cache curves, the result of key
+	/// </summary>
+	static void store(const Key& key, std::vector<Curve>& curves);
+
+	/// <summary>
+	/// Write the entries to a binary file, most recently used first
+	/// </summary>
+	static bool save(std::string path);
+
+	/// <summary>
+	/// Read the entries of a file written by save, up to the capacity. Files of another build are ignored
+	/// </summary>
+	static bool load(std::string path);
+
+	/// <summary>
+	/// Hits, misses and size, for the log
+	/// </summary>
+	static std::string str();
+};
+
+#endif
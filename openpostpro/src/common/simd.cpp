@@ -0,0 +1,424 @@
+#include <simd.h>
+#include <atomic>
+#include <cmath>
+
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__)) && !defined(GEOMETRY_SINGLE_PRECISION)
+#define SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+	using geometry::real;
+
+	std::atomic<int> current(-1);
+
+	inline int bits(int mask)
+	{
+		return (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+	}
+
+	Simd::Level detect()
+	{
+#ifdef SIMD_X86
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] >= 7)
+		{
+			__cpuid(info, 1);
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool avx = (info[2] & (1 << 28)) != 0;
+			__cpuidex(info, 7, 0);
+			bool avx2 = (info[1] & (1 << 5)) != 0;
+			// the system must save the ymm registers
+			if (osxsave && avx && avx2 && (_xgetbv(0) & 6) == 6)
+				return Simd::Level::avx2;
+		}
+#else
+		if (__builtin_cpu_supports("avx2"))
+			return Simd::Level::avx2;
+#endif
+		return Simd::Level::sse2;
+#else
+		return Simd::Level::scalar;
+#endif
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// scalar kernels, also used for the remaining candidates of the blocks
+
+	void hits_scalar(const real q[4], const real* left, const real* bottom, const real* right, const real* top, const int* indices, size_t from, size_t count, uint8_t* result)
+	{
+		for (size_t k = from; k < count; k++)
+		{
+			int j = indices[k];
+			bool contains = (left[j] >= q[0]) & (left[j] <= q[2]) & (top[j] >= q[1]) & (top[j] <= q[3])
+				& (right[j] >= q[0]) & (right[j] <= q[2]) & (bottom[j] >= q[1]) & (bottom[j] <= q[3]);
+			bool intersect = (q[0] < right[j]) & (q[2] > left[j]) & (q[3] > bottom[j]) & (q[1] < top[j]);
+			bool contained = (q[0] >= left[j]) & (q[0] <= right[j]) & (q[3] >= bottom[j]) & (q[3] <= top[j])
+				& (q[2] >= left[j]) & (q[2] <= right[j]) & (q[1] >= bottom[j]) & (q[1] <= top[j]);
+			result[k] = contains | intersect | contained;
+		}
+	}
+
+	void straddle_scalar(geometry::rvec2 a, real ux, real uy, real m, const real* x, const real* y, const int* indices, size_t from, size_t count, uint8_t* result)
+	{
+		for (size_t k = from; k < count; k++)
+		{
+			int j = indices[k];
+			real c1 = ux * (y[j] - a.y) - uy * (x[j] - a.x);
+			real c2 = ux * (y[j + 1] - a.y) - uy * (x[j + 1] - a.x);
+			bool apart = ((c1 > m) & (c2 > m)) | ((c1 < -m) & (c2 < -m));
+			result[k] = !apart;
+		}
+	}
+
+	bool near_scalar(const real* x, const real* y, const real* mx, const real* my, const int* indices, size_t from, size_t count, const real* qx, const real* qy, int points, real d2)
+	{
+		for (size_t k = from; k < count; k++)
+		{
+			int j = indices[k];
+			real sx[3] = { x[j], x[j + 1], mx[j] };
+			real sy[3] = { y[j], y[j + 1], my[j] };
+			bool close = false;
+			for (int q = 0; q < points; q++)
+				for (int e = 0; e < 3; e++)
+				{
+					real dx = sx[e] - qx[q];
+					real dy = sy[e] - qy[q];
+					close |= dx * dx + dy * dy < d2;
+				}
+			if (close)
+				return true;
+		}
+		return false;
+	}
+
+	int crossings_scalar(const real* ax, const real* ay, const real* bx, const real* by, size_t from, size_t count, geometry::rvec2 p)
+	{
+		int flips = 0;
+		for (size_t i = from; i < count; i++)
+		{
+			real x1 = ax[i], y1 = ay[i], x2 = bx[i], y2 = by[i];
+			bool span = (p.y > glm::min(y1, y2)) & (p.y <= glm::max(y1, y2)) & (p.x <= glm::max(x1, x2));
+			// horizontal edges are never in span, the division result is then unused
+			double x_intersection = (p.y - y1) * (x2 - x1) / (y2 - y1) + x1;
+			flips += span & ((x1 == x2) | (p.x <= x_intersection));
+		}
+		return flips;
+	}
+
+#ifdef SIMD_X86
+	//////////////////////////////////////////////////////////////////////
+	// SSE2 kernels, 2 candidates at once
+
+	inline __m128d gather2(const real* a, const int* j)
+	{
+		return _mm_set_pd(a[j[1]], a[j[0]]);
+	}
+
+	size_t hits_sse2(const real q[4], const real* left, const real* bottom, const real* right, const real* top, const int* indices, size_t count, uint8_t* result)
+	{
+		__m128d ql = _mm_set1_pd(q[0]), qb = _mm_set1_pd(q[1]), qr = _mm_set1_pd(q[2]), qt = _mm_set1_pd(q[3]);
+		size_t k = 0;
+		for (; k + 2 <= count; k += 2)
+		{
+			const int* j = indices + k;
+			__m128d l = gather2(left, j), b = gather2(bottom, j), r = gather2(right, j), t = gather2(top, j);
+			__m128d contains = _mm_and_pd(_mm_and_pd(_mm_and_pd(_mm_cmpge_pd(l, ql), _mm_cmple_pd(l, qr)), _mm_and_pd(_mm_cmpge_pd(t, qb), _mm_cmple_pd(t, qt))),
+				_mm_and_pd(_mm_and_pd(_mm_cmpge_pd(r, ql), _mm_cmple_pd(r, qr)), _mm_and_pd(_mm_cmpge_pd(b, qb), _mm_cmple_pd(b, qt))));
+			__m128d intersect = _mm_and_pd(_mm_and_pd(_mm_cmplt_pd(ql, r), _mm_cmpgt_pd(qr, l)), _mm_and_pd(_mm_cmpgt_pd(qt, b), _mm_cmplt_pd(qb, t)));
+			__m128d contained = _mm_and_pd(_mm_and_pd(_mm_and_pd(_mm_cmpge_pd(ql, l), _mm_cmple_pd(ql, r)), _mm_and_pd(_mm_cmpge_pd(qt, b), _mm_cmple_pd(qt, t))),
+				_mm_and_pd(_mm_and_pd(_mm_cmpge_pd(qr, l), _mm_cmple_pd(qr, r)), _mm_and_pd(_mm_cmpge_pd(qb, b), _mm_cmple_pd(qb, t))));
+			int mask = _mm_movemask_pd(_mm_or_pd(_mm_or_pd(contains, intersect), contained));
+			result[k] = mask & 1;
+			result[k + 1] = (mask >> 1) & 1;
+		}
+		return k;
+	}
+
+	size_t straddle_sse2(geometry::rvec2 a, real ux, real uy, real m, const real* x, const real* y, const int* indices, size_t count, uint8_t* result)
+	{
+		__m128d ax = _mm_set1_pd(a.x), ay = _mm_set1_pd(a.y), vx = _mm_set1_pd(ux), vy = _mm_set1_pd(uy);
+		__m128d pm = _mm_set1_pd(m), nm = _mm_set1_pd(-m);
+		size_t k = 0;
+		for (; k + 2 <= count; k += 2)
+		{
+			const int* j = indices + k;
+			__m128d x1 = gather2(x, j), y1 = gather2(y, j), x2 = gather2(x + 1, j), y2 = gather2(y + 1, j);
+			__m128d c1 = _mm_sub_pd(_mm_mul_pd(vx, _mm_sub_pd(y1, ay)), _mm_mul_pd(vy, _mm_sub_pd(x1, ax)));
+			__m128d c2 = _mm_sub_pd(_mm_mul_pd(vx, _mm_sub_pd(y2, ay)), _mm_mul_pd(vy, _mm_sub_pd(x2, ax)));
+			__m128d apart = _mm_or_pd(_mm_and_pd(_mm_cmpgt_pd(c1, pm), _mm_cmpgt_pd(c2, pm)), _mm_and_pd(_mm_cmplt_pd(c1, nm), _mm_cmplt_pd(c2, nm)));
+			int mask = _mm_movemask_pd(apart);
+			result[k] = !(mask & 1);
+			result[k + 1] = !((mask >> 1) & 1);
+		}
+		return k;
+	}
+
+	bool near_sse2(const real* x, const real* y, const real* mx, const real* my, const int* indices, size_t count, const real* qx, const real* qy, int points, real d2, size_t& done)
+	{
+		__m128d limit = _mm_set1_pd(d2);
+		size_t k = 0;
+		for (; k + 2 <= count; k += 2)
+		{
+			const int* j = indices + k;
+			__m128d sx[3] = { gather2(x, j), gather2(x + 1, j), gather2(mx, j) };
+			__m128d sy[3] = { gather2(y, j), gather2(y + 1, j), gather2(my, j) };
+			__m128d close = _mm_setzero_pd();
+			for (int q = 0; q < points; q++)
+			{
+				__m128d vx = _mm_set1_pd(qx[q]), vy = _mm_set1_pd(qy[q]);
+				for (int e = 0; e < 3; e++)
+				{
+					__m128d dx = _mm_sub_pd(sx[e], vx), dy = _mm_sub_pd(sy[e], vy);
+					close = _mm_or_pd(close, _mm_cmplt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), limit));
+				}
+			}
+			if (_mm_movemask_pd(close))
+				return true;
+		}
+		done = k;
+		return false;
+	}
+
+	size_t crossings_sse2(const real* ax, const real* ay, const real* bx, const real* by, size_t count, geometry::rvec2 p, int& flips)
+	{
+		__m128d vx = _mm_set1_pd(p.x), vy = _mm_set1_pd(p.y);
+		size_t i = 0;
+		for (; i + 2 <= count; i += 2)
+		{
+			__m128d x1 = _mm_loadu_pd(ax + i), x2 = _mm_loadu_pd(bx + i), y1 = _mm_loadu_pd(ay + i), y2 = _mm_loadu_pd(by + i);
+			__m128d span = _mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(vy, _mm_min_pd(y1, y2)), _mm_cmple_pd(vy, _mm_max_pd(y1, y2))), _mm_cmple_pd(vx, _mm_max_pd(x1, x2)));
+			__m128d xi = _mm_add_pd(_mm_div_pd(_mm_mul_pd(_mm_sub_pd(vy, y1), _mm_sub_pd(x2, x1)), _mm_sub_pd(y2, y1)), x1);
+			__m128d flip = _mm_and_pd(span, _mm_or_pd(_mm_cmpeq_pd(x1, x2), _mm_cmple_pd(vx, xi)));
+			flips += bits(_mm_movemask_pd(flip));
+		}
+		return i;
+	}
+
+	//////////////////////////////////////////////////////////////////////
+	// AVX2 kernels, 4 candidates at once, the arrays are gathered with the indices
+
+	TARGET_AVX2 inline __m256d gather4(const real* a, __m128i j)
+	{
+		return _mm256_i32gather_pd(a, j, 8);
+	}
+
+	TARGET_AVX2 size_t hits_avx2(const real q[4], const real* left, const real* bottom, const real* right, const real* top, const int* indices, size_t count, uint8_t* result)
+	{
+		__m256d ql = _mm256_set1_pd(q[0]), qb = _mm256_set1_pd(q[1]), qr = _mm256_set1_pd(q[2]), qt = _mm256_set1_pd(q[3]);
+		size_t k = 0;
+		for (; k + 4 <= count; k += 4)
+		{
+			__m128i j = _mm_loadu_si128((const __m128i*)(indices + k));
+			__m256d l = gather4(left, j), b = gather4(bottom, j), r = gather4(right, j), t = gather4(top, j);
+			__m256d contains = _mm256_and_pd(
+				_mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(l, ql, _CMP_GE_OQ), _mm256_cmp_pd(l, qr, _CMP_LE_OQ)), _mm256_and_pd(_mm256_cmp_pd(t, qb, _CMP_GE_OQ), _mm256_cmp_pd(t, qt, _CMP_LE_OQ))),
+				_mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(r, ql, _CMP_GE_OQ), _mm256_cmp_pd(r, qr, _CMP_LE_OQ)), _mm256_and_pd(_mm256_cmp_pd(b, qb, _CMP_GE_OQ), _mm256_cmp_pd(b, qt, _CMP_LE_OQ))));
+			__m256d intersect = _mm256_and_pd(
+				_mm256_and_pd(_mm256_cmp_pd(ql, r, _CMP_LT_OQ), _mm256_cmp_pd(qr, l, _CMP_GT_OQ)),
+				_mm256_and_pd(_mm256_cmp_pd(qt, b, _CMP_GT_OQ), _mm256_cmp_pd(qb, t, _CMP_LT_OQ)));
+			__m256d contained = _mm256_and_pd(
+				_mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(ql, l, _CMP_GE_OQ), _mm256_cmp_pd(ql, r, _CMP_LE_OQ)), _mm256_and_pd(_mm256_cmp_pd(qt, b, _CMP_GE_OQ), _mm256_cmp_pd(qt, t, _CMP_LE_OQ))),
+				_mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(qr, l, _CMP_GE_OQ), _mm256_cmp_pd(qr, r, _CMP_LE_OQ)), _mm256_and_pd(_mm256_cmp_pd(qb, b, _CMP_GE_OQ), _mm256_cmp_pd(qb, t, _CMP_LE_OQ))));
+			int mask = _mm256_movemask_pd(_mm256_or_pd(_mm256_or_pd(contains, intersect), contained));
+			for (int e = 0; e < 4; e++)
+				result[k + e] = (mask >> e) & 1;
+		}
+		return k;
+	}
+
+	TARGET_AVX2 size_t straddle_avx2(geometry::rvec2 a, real ux, real uy, real m, const real* x, const real* y, const int* indices, size_t count, uint8_t* result)
+	{
+		__m256d ax = _mm256_set1_pd(a.x), ay = _mm256_set1_pd(a.y), vx = _mm256_set1_pd(ux), vy = _mm256_set1_pd(uy);
+		__m256d pm = _mm256_set1_pd(m), nm = _mm256_set1_pd(-m);
+		size_t k = 0;
+		for (; k + 4 <= count; k += 4)
+		{
+			__m128i j = _mm_loadu_si128((const __m128i*)(indices + k));
+			__m256d x1 = gather4(x, j), y1 = gather4(y, j), x2 = gather4(x + 1, j), y2 = gather4(y + 1, j);
+			__m256d c1 = _mm256_sub_pd(_mm256_mul_pd(vx, _mm256_sub_pd(y1, ay)), _mm256_mul_pd(vy, _mm256_sub_pd(x1, ax)));
+			__m256d c2 = _mm256_sub_pd(_mm256_mul_pd(vx, _mm256_sub_pd(y2, ay)), _mm256_mul_pd(vy, _mm256_sub_pd(x2, ax)));
+			__m256d apart = _mm256_or_pd(
+				_mm256_and_pd(_mm256_cmp_pd(c1, pm, _CMP_GT_OQ), _mm256_cmp_pd(c2, pm, _CMP_GT_OQ)),
+				_mm256_and_pd(_mm256_cmp_pd(c1, nm, _CMP_LT_OQ), _mm256_cmp_pd(c2, nm, _CMP_LT_OQ)));
+			int mask = _mm256_movemask_pd(apart);
+			for (int e = 0; e < 4; e++)
+				result[k + e] = !((mask >> e) & 1);
+		}
+		return k;
+	}
+
+	TARGET_AVX2 bool near_avx2(const real* x, const real* y, const real* mx, const real* my, const int* indices, size_t count, const real* qx, const real* qy, int points, real d2, size_t& done)
+	{
+		__m256d limit = _mm256_set1_pd(d2);
+		size_t k = 0;
+		for (; k + 4 <= count; k += 4)
+		{
+			__m128i j = _mm_loadu_si128((const __m128i*)(indices + k));
+			__m256d sx[3] = { gather4(x, j), gather4(x + 1, j), gather4(mx, j) };
+			__m256d sy[3] = { gather4(y, j), gather4(y + 1, j), gather4(my, j) };
+			__m256d close = _mm256_setzero_pd();
+			for (int q = 0; q < points; q++)
+			{
+				__m256d vx = _mm256_set1_pd(qx[q]), vy = _mm256_set1_pd(qy[q]);
+				for (int e = 0; e < 3; e++)
+				{
+					__m256d dx = _mm256_sub_pd(sx[e], vx), dy = _mm256_sub_pd(sy[e], vy);
+					close = _mm256_or_pd(close, _mm256_cmp_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), limit, _CMP_LT_OQ));
+				}
+			}
+			if (_mm256_movemask_pd(close))
+				return true;
+		}
+		done = k;
+		return false;
+	}
+
+	TARGET_AVX2 size_t crossings_avx2(const real* ax, const real* ay, const real* bx, const real* by, size_t count, geometry::rvec2 p, int& flips)
+	{
+		__m256d vx = _mm256_set1_pd(p.x), vy = _mm256_set1_pd(p.y);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m256d x1 = _mm256_loadu_pd(ax + i), x2 = _mm256_loadu_pd(bx + i), y1 = _mm256_loadu_pd(ay + i), y2 = _mm256_loadu_pd(by + i);
+			__m256d span = _mm256_and_pd(
+				_mm256_and_pd(_mm256_cmp_pd(vy, _mm256_min_pd(y1, y2), _CMP_GT_OQ), _mm256_cmp_pd(vy, _mm256_max_pd(y1, y2), _CMP_LE_OQ)),
+				_mm256_cmp_pd(vx, _mm256_max_pd(x1, x2), _CMP_LE_OQ));
+			__m256d xi = _mm256_add_pd(_mm256_div_pd(_mm256_mul_pd(_mm256_sub_pd(vy, y1), _mm256_sub_pd(x2, x1)), _mm256_sub_pd(y2, y1)), x1);
+			__m256d flip = _mm256_and_pd(span, _mm256_or_pd(_mm256_cmp_pd(x1, x2, _CMP_EQ_OQ), _mm256_cmp_pd(vx, xi, _CMP_LE_OQ)));
+			flips += bits(_mm256_movemask_pd(flip));
+		}
+		return i;
+	}
+#endif
+}
+
+Simd::Level Simd::supported()
+{
+	static Level value = detect();
+	return value;
+}
+
+Simd::Level Simd::level()
+{
+	int value = current.load(std::memory_order_relaxed);
+	if (value < 0)
+	{
+		value = (int)supported();
+		current.store(value, std::memory_order_relaxed);
+	}
+	return (Level)value;
+}
+
+void Simd::level(Level value)
+{
+	current.store((int)(value < supported() ? value : supported()), std::memory_order_relaxed);
+}
+
+const char* Simd::name(Level value)
+{
+	switch (value)
+	{
+	case Level::avx2:
+		return "avx2";
+	case Level::sse2:
+		return "sse2";
+	default:
+		return "scalar";
+	}
+}
+
+void Simd::hits(const geometry::real box[4], const geometry::real* left, const geometry::real* bottom, const geometry::real* right, const geometry::real* top,
+	const int* indices, size_t count, uint8_t* result)
+{
+	size_t done = 0;
+#ifdef SIMD_X86
+	switch (level())
+	{
+	case Level::avx2:
+		done = hits_avx2(box, left, bottom, right, top, indices, count, result);
+		break;
+	case Level::sse2:
+		done = hits_sse2(box, left, bottom, right, top, indices, count, result);
+		break;
+	default:
+		break;
+	}
+#endif
+	hits_scalar(box, left, bottom, right, top, indices, done, count, result);
+}
+
+void Simd::straddle(geometry::rvec2 a, geometry::rvec2 b, const geometry::real* x, const geometry::real* y,
+	const int* indices, size_t count, geometry::real margin, uint8_t* result)
+{
+	// cross products are compared to the margin times the length of (a, b) to avoid a division
+	real ux = b.x - a.x, uy = b.y - a.y;
+	real m = margin * std::sqrt(ux * ux + uy * uy);
+
+	size_t done = 0;
+#ifdef SIMD_X86
+	switch (level())
+	{
+	case Level::avx2:
+		done = straddle_avx2(a, ux, uy, m, x, y, indices, count, result);
+		break;
+	case Level::sse2:
+		done = straddle_sse2(a, ux, uy, m, x, y, indices, count, result);
+		break;
+	default:
+		break;
+	}
+#endif
+	straddle_scalar(a, ux, uy, m, x, y, indices, done, count, result);
+}
+
+bool Simd::near(const geometry::real* x, const geometry::real* y, const geometry::real* mx, const geometry::real* my,
+	const int* indices, size_t count, const geometry::real* qx, const geometry::real* qy, int points, geometry::real d2)
+{
+	size_t done = 0;
+#ifdef SIMD_X86
+	switch (level())
+	{
+	case Level::avx2:
+		if (near_avx2(x, y, mx, my, indices, count, qx, qy, points, d2, done))
+			return true;
+		break;
+	case Level::sse2:
+		if (near_sse2(x, y, mx, my, indices, count, qx, qy, points, d2, done))
+			return true;
+		break;
+	default:
+		break;
+	}
+#endif
+	return near_scalar(x, y, mx, my, indices, done, count, qx, qy, points, d2);
+}
+
+int Simd::crossings(const geometry::real* ax, const geometry::real* ay, const geometry::real* bx, const geometry::real* by, size_t count, geometry::rvec2 p)
+{
+	size_t done = 0;
+	int flips = 0;
+#ifdef SIMD_X86
+	switch (level())
+	{
+	case Level::avx2:
+		done = crossings_avx2(ax, ay, bx, by, count, p, flips);
+		break;
+	case Level::sse2:
+		done = crossings_sse2(ax, ay, bx, by, count, p, flips);
+		break;
+	default:
+		break;
+	}
+#endif
+	return flips + crossings_scalar(ax, ay, bx, by, done, count, p);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#ifndef _SIMD_H
+#define _SIMD_H
+
+#include <geometry.h>
+#include <cstdint>
+#include <cstddef>
+
+/************************************************************************
+* Batch kernels of the curve arrays view
+* One segment or point is tested against a block of candidates, given by
+* their index in the arrays or stored contiguously, 2 at once with SSE2,
+* 4 at once with AVX2.
+* The instruction set is chosen at run time from the processor, results
+* are the same at every level. Single precision builds use the scalar
+* kernels only
+*************************************************************************/
+class Simd
+{
+public:
+	enum class Level
+	{
+		scalar,
+		sse2,
+		avx2
+	};
+
+	/// <summary>
+	/// Best level supported by the processor
+	/// </summary>
+	static Level supported();
+
+	/// <summary>
+	/// Level used by the kernels
+	/// </summary>
+	static Level level();
+
+	/// <summary>
+	/// Force the level used by the kernels, for benchmarks. It is limited to the supported level
+	/// </summary>
+	static void level(Level value);
+
+	static const char* name(Level value);
+
+	/// <summary>
+	/// result[k] = 1 if the bounds (left, bottom, right, top) of box and of segment indices[k] match,
+	/// same rule as rectangle : one contains the other or they intersect
+	/// </summary>
+	static void hits(const geometry::real box[4], const geometry::real* left, const geometry::real* bottom, const geometry::real* right, const geometry::real* top,
+		const int* indices, size_t count, uint8_t* result);
+
+	/// <summary>
+	/// result[k] = 0 if both ends of line segment indices[k], from (x[j], y[j]) to (x[j + 1], y[j + 1]), are on the same side of the line (a, b)
+	/// and farther than margin from it, they can not cross the segment (a, b) then. result[k] = 1 otherwise
+	/// </summary>
+	static void straddle(geometry::rvec2 a, geometry::rvec2 b, const geometry::real* x, const geometry::real* y,
+		const int* indices, size_t count, geometry::real margin, uint8_t* result);
+
+	/// <summary>
+	/// Return true if the start (x[j], y[j]), stop (x[j + 1], y[j + 1]) or middle (mx[j], my[j]) of one of the segments indices[k]
+	/// is closer than sqrt(d2) to one of the points (qx, qy)
+	/// </summary>
+	static bool near(const geometry::real* x, const geometry::real* y, const geometry::real* mx, const geometry::real* my,
+		const int* indices, size_t count, const geometry::real* qx, const geometry::real* qy, int points, geometry::real d2);
+
+	/// <summary>
+	/// Ray casting of p over the edges from (ax[k], ay[k]) to (bx[k], by[k]) : count of edges crossed by the horizontal ray going right from p.
+	/// p is inside a closed outline when the count is odd
+	/// </summary>
+	static int crossings(const geometry::real* ax, const geometry::real* ay, const geometry::real* bx, const geometry::real* by, size_t count, geometry::rvec2 p);
+};
+
+#endif
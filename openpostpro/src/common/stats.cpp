@@ -0,0 +1,50 @@
+#include "stats.h"
+#include <mutex>
+
+#ifdef GEOMETRY_STATS
+thread_local Stats::Counters Stats::_local;
+
+static std::mutex _total_mutex;
+
+Stats::Scope::Scope(Counters& total) : _total(total), _saved(_local)
+{
+	_local = Counters();
+}
+
+Stats::Scope::~Scope()
+{
+	{
+		std::lock_guard<std::mutex> lock(_total_mutex);
+		_total += _local;
+	}
+	_local = _saved;
+}
+#endif
+
+Stats::Counters& Stats::Counters::operator+=(const Counters& c)
+{
+	for (int i = 0; i < count; i++)
+		value[i] += c.value[i];
+	return *this;
+}
+
+bool Stats::Counters::empty() const
+{
+	for (int i = 0; i < count; i++)
+		if (value[i] != 0)
+			return false;
+	return true;
+}
+
+std::string Stats::Counters::str() const
+{
+	return "intersection tests: " + std::to_string(value[intersection_tests]) +
+		" proximity tests: " + std::to_string(value[proximity_tests]) +
+		" nodes visited: " + std::to_string(value[nodes_visited]) +
+		" candidates: " + std::to_string(value[candidates]) +
+		" offsets rejected: " + std::to_string(value[offset_rejected]) +
+		" allocations: " + std::to_string(value[allocations]) +
+		" copies: " + std::to_string(value[copies]) +
+		" offset cache hits: " + std::to_string(value[offset_hits]) +
+		" misses: " + std::to_string(value[offset_misses]);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef _STATS_H
+#define _STATS_H
+
+#include <string>
+
+/************************************************************************
+* Geometry kernel instrumentation
+* Counters are per thread and compile to nothing unless GEOMETRY_STATS
+* is defined. A Scope collects the work done by the current thread into
+* a Counters total, for example the total of a toolpath computation
+*************************************************************************/
+class Stats
+{
+public:
+	enum Counter
+	{
+		intersection_tests,	// segment / segment intersection computations
+		proximity_tests,	// segment / segment distance checks of too_close
+		nodes_visited,		// spatial index nodes visited by searches
+		candidates,			// segments returned by searches and sweeps
+		offset_rejected,	// offset curves refused as too small or too close
+		allocations,		// heap allocations of the geometry temporaries, see Arena
+		copies,				// curves copied, moves are not counted
+		offset_hits,		// offsets found in the OffsetCache
+		offset_misses,		// offsets computed and stored in the OffsetCache
+		count
+	};
+
+	struct Counters
+	{
+		unsigned long long value[count] = {};
+
+		Counters& operator+=(const Counters& c);
+		bool empty() const;
+		std::string str() const;
+	};
+
+#ifdef GEOMETRY_STATS
+	static constexpr bool enabled = true;
+
+private:
+	static thread_local Counters _local;
+
+public:
+	static void add(Counter c, unsigned long long n = 1) { _local.value[c] += n; }
+
+	/// <summary>
+	/// Count the work of the current thread while in scope and add it to total when leaving.
+	/// Nested scopes only count their own part so totals are never added twice.
+	/// Total can be shared between threads
+	/// </summary>
+	class Scope
+	{
+	private:
+		Counters& _total;
+		Counters _saved;
+
+	public:
+		Scope(Counters& total);
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+#else
+	static constexpr bool enabled = false;
+
+	static void add(Counter, unsigned long long = 1) {}
+
+	class Scope
+	{
+	public:
+		Scope(Counters&) {}
+	};
+#endif
+};
+
+#endif
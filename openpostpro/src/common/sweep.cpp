@@ -0,0 +1,131 @@
+#include "sweep.h"
+#include <curve.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <glm/gtc/constants.hpp>
+
+void SweepLine::add(geometry::real left, geometry::real bottom, geometry::real right, geometry::real top, int id)
+{
+	// small margin, intersection routines accept near contacts
+	geometry::real e = geometry::ERR_FLOAT4;
+	_boxes.push_back(Box{ left - e, bottom - e, right + e, top + e, id });
+}
+
+void SweepLine::add(Segment& s, const geometry::rvec2& dst, int id)
+{
+	if (s.type == SegmentType::Line)
+	{
+		add(glm::min(s.point.x, dst.x), glm::min(s.point.y, dst.y), glm::max(s.point.x, dst.x), glm::max(s.point.y, dst.y), id);
+		return;
+	}
+
+	// arc or circle, taken counter clockwise from start to stop
+	geometry::rvec2 start = s.cw ? dst : s.point;
+	geometry::rvec2 stop = s.cw ? s.point : dst;
+	geometry::real a0 = geometry::oriented_angle(start, s.center);
+	geometry::real a1 = geometry::oriented_angle(stop, s.center);
+	geometry::real sweep = a1 - a0;
+	if (s.type == SegmentType::Circle || start == stop)
+		sweep = glm::two_pi<geometry::real>();
+	else if (sweep <= 0)
+		sweep += glm::two_pi<geometry::real>();
+
+	// split at each multiple of PI, the pieces are x-monotone
+	geometry::real pi = glm::pi<geometry::real>();
+	geometry::real t0 = a0;
+	geometry::rvec2 p0 = start;
+	while (t0 < a0 + sweep)
+	{
+		geometry::real t1 = glm::min(a0 + sweep, (glm::floor(t0 / pi) + 1) * pi);
+		geometry::rvec2 p1 = t1 >= a0 + sweep ? stop : s.center + s.radius * geometry::rvec2(glm::cos(t1), glm::sin(t1));
+
+		geometry::real bottom = glm::min(p0.y, p1.y), top = glm::max(p0.y, p1.y);
+
+		// y extremes : PI/2 on the upper half, 3 PI/2 on the lower half
+		geometry::real half = glm::floor(t0 / pi);
+		geometry::real q = half * pi + glm::half_pi<geometry::real>();
+		if (q > t0 && q < t1)
+		{
+			if (((int)half) % 2 == 0)
+				top = s.center.y + s.radius;
+			else
+				bottom = s.center.y - s.radius;
+		}
+
+		add(glm::min(p0.x, p1.x), bottom, glm::max(p0.x, p1.x), top, id);
+
+		t0 = t1;
+		p0 = p1;
+	}
+}
+
+void SweepLine::pairs(std::pmr::vector<std::pair<int, int>>& result)
+{
+	result.clear();
+	if (_boxes.empty())
+		return;
+
+	std::sort(_boxes.begin(), _boxes.end(), [](const Box& a, const Box& b) { return a.left < b.left; });
+
+	// active pieces are the ones crossing the sweep line, bucketed by height class and ordered by bottom.
+	// A candidate of a bucket has its bottom between box.bottom - the bucket height and box.top, a tall piece
+	// only widens the search of its own bucket.
+	// Pieces behind the sweep line (right < box.left) are skipped, and removed when their bucket grows
+	struct Bucket
+	{
+		geometry::real height = 0;
+		std::pmr::vector<int> active{ Arena::resource() };
+		size_t limit = 64;
+	};
+
+	// the margin of add keeps the heights positive
+	std::pmr::vector<int> classes(_boxes.size(), Arena::resource());
+	int low = std::numeric_limits<int>::max(), high = std::numeric_limits<int>::min();
+	for (size_t b = 0; b < _boxes.size(); b++)
+	{
+		classes[b] = std::ilogb(_boxes[b].top - _boxes[b].bottom);
+		low = glm::min(low, classes[b]);
+		high = glm::max(high, classes[b]);
+	}
+
+	std::vector<Bucket> buckets(high - low + 1);
+	for (size_t b = 0; b < _boxes.size(); b++)
+	{
+		Bucket& bucket = buckets[classes[b] - low];
+		bucket.height = glm::max(bucket.height, _boxes[b].top - _boxes[b].bottom);
+	}
+
+	auto lower = [this](int a, geometry::real y) { return _boxes[a].bottom < y; };
+	auto upper = [this](geometry::real y, int a) { return y < _boxes[a].bottom; };
+
+	for (int b = 0; b < (int)_boxes.size(); b++)
+	{
+		Box& box = _boxes[b];
+
+		for (Bucket& bucket : buckets)
+		{
+			auto& active = bucket.active;
+			if (active.size() >= bucket.limit)
+			{
+				active.erase(std::remove_if(active.begin(), active.end(), [this, &box](int a) { return _boxes[a].right < box.left; }), active.end());
+				bucket.limit = glm::max<size_t>(64, 2 * active.size());
+			}
+
+			for (auto it = std::lower_bound(active.begin(), active.end(), box.bottom - bucket.height, lower); it != active.end(); ++it)
+			{
+				Box& other = _boxes[*it];
+				if (other.bottom > box.top)
+					break;
+				if (other.right >= box.left && other.top >= box.bottom && other.id != box.id)
+					result.push_back(std::make_pair(glm::min(box.id, other.id), glm::max(box.id, other.id)));
+			}
+		}
+
+		auto& active = buckets[classes[b] - low].active;
+		active.insert(std::upper_bound(active.begin(), active.end(), box.bottom, upper), b);
+	}
+
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+}
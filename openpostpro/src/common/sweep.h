@@ -0,0 +1,58 @@
+#pragma once
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <geometry.h>
+#include <arena.h>
+#include <vector>
+#include <utility>
+
+class Segment;
+
+/// <summary>
+/// Broad phase of the intersections : sweep-line over the bounding boxes of the x-monotone pieces of line and arc segments.
+/// This is not a Bentley-Ottmann sweep, there is no event queue of crossings nor order of the pieces along the line, and the
+/// O((n + k) log n) bound is not provided. The callers also want the pieces closer than ERR_FLOAT4 without crossing,
+/// which an order of the pieces along the line does not report.
+/// Arcs are split at their x extremes (0 and PI), so each piece is tightly bounded.
+/// Pieces enter the sweep ordered by left bound and leave it when the line goes past their right bound.
+/// The active pieces are bucketed by height (powers of two), each bucket ordered by bottom bound, so a piece
+/// is only compared with the active pieces of each bucket in its y range widened by the bucket height.
+/// Insertions in a bucket are linear and pieces overlapping in y only are still visited : the worst case is O(n^2),
+/// drawings with pieces spread over the plane stay close to O(n log n + k), k being the count of overlapping pieces.
+/// Exact intersections are left to the caller, on the reported pairs.
+/// </summary>
+class SweepLine
+{
+private:
+	struct Box
+	{
+		geometry::real left;
+		geometry::real bottom;
+		geometry::real right;
+		geometry::real top;
+		int id;
+	};
+
+	std::pmr::vector<Box> _boxes{ Arena::resource() };
+
+	void add(geometry::real left, geometry::real bottom, geometry::real right, geometry::real top, int id);
+
+public:
+	/// <summary>
+	/// Remove all pieces
+	/// </summary>
+	void clear() { _boxes.clear(); }
+
+	/// <summary>
+	/// Add segment s going to dst, the pieces will be reported with id
+	/// </summary>
+	void add(Segment& s, const geometry::rvec2& dst, int id);
+
+	/// <summary>
+	/// Fill result with each pair of ids (smaller first, sorted, no duplicate) having overlapping pieces
+	/// </summary>
+	void pairs(std::pmr::vector<std::pair<int, int>>& result);
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "workers.h"
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <algorithm>
+
+std::vector<std::thread> Workers::_threads;
+std::deque<std::function<void()>> Workers::_tasks;
+std::mutex Workers::_mutex;
+std::condition_variable Workers::_wake;
+bool Workers::_exit = false;
+
+static thread_local bool _worker = false;
+
+void Workers::loop()
+{
+	_worker = true;
+
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wake.wait(lock, [] { return _exit || !_tasks.empty(); });
+			if (_exit && _tasks.empty())
+				return;
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+		task();
+	}
+}
+
+void Workers::start(unsigned int count)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	// already started or stopped for good
+	if (_threads.size() > 0 || _exit)
+		return;
+
+	if (count == 0)
+		count = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+	for (unsigned int i = 0; i < count; i++)
+		_threads.push_back(std::thread(&loop));
+}
+
+void Workers::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_exit = true;
+	}
+	_wake.notify_all();
+
+	for (auto& t : _threads)
+		t.join();
+	_threads.clear();
+}
+
+bool Workers::worker()
+{
+	return _worker;
+}
+
+void Workers::run(size_t count, std::function<void(size_t)> f)
+{
+	if (count == 0)
+		return;
+
+	if (!_worker)
+		start();
+
+	// inline loop : single item, no worker, or called from a worker thread
+	if (count == 1 || _threads.size() == 0 || _worker)
+	{
+		for (size_t i = 0; i < count; i++)
+			f(i);
+		return;
+	}
+
+	// shared loop state, kept alive by the tasks which may start after the loop is done
+	struct Loop
+	{
+		std::function<void(size_t)> f;
+		size_t count = 0;
+		std::atomic<size_t> next = 0;
+		std::atomic<size_t> done = 0;
+		std::exception_ptr error;
+		std::mutex mutex;
+		std::condition_variable finished;
+
+		void drain()
+		{
+			size_t i;
+			while ((i = next++) < count)
+			{
+				try
+				{
+					f(i);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (!error)
+						error = std::current_exception();
+				}
+				if (++done == count)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					finished.notify_all();
+				}
+			}
+		}
+	};
+
+	auto loop = std::make_shared<Loop>();
+	loop->f = f;
+	loop->count = count;
+
+	size_t tasks = std::min(count - 1, _threads.size());
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		for (size_t i = 0; i < tasks; i++)
+			_tasks.push_back([loop] { loop->drain(); });
+	}
+	_wake.notify_all();
+
+	loop->drain();
+
+	std::unique_lock<std::mutex> lock(loop->mutex);
+	loop->finished.wait(lock, [&loop] { return loop->done == loop->count; });
+
+	if (loop->error)
+		std::rethrow_exception(loop->error);
+}
@@ -0,0 +1,70 @@
+#pragma once
+#ifndef _WORKERS_H
+#define _WORKERS_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+/************************************************************************
+* Worker pool for task-parallel loops
+* The calling thread takes part to the loop, a loop started from a worker
+* thread runs inline to avoid waiting on itself
+*************************************************************************/
+class Workers
+{
+private:
+	static std::vector<std::thread> _threads;
+	static std::deque<std::function<void()>> _tasks;
+	static std::mutex _mutex;
+	static std::condition_variable _wake;
+	static bool _exit;
+
+	/// <summary>
+	/// Thread loop
+	/// </summary>
+	static void loop();
+
+public:
+	/// <summary>
+	/// Start the worker threads, called on first run. Once stopped, loops run inline
+	/// <param name="count">thread count, default is hardware concurrency minus the calling thread</param>
+	/// </summary>
+	static void start(unsigned int count = 0);
+
+	/// <summary>
+	/// Stop and join the worker threads
+	/// </summary>
+	static void stop();
+
+	/// <summary>
+	/// Return true if the current thread is a worker thread
+	/// </summary>
+	static bool worker();
+
+	/// <summary>
+	/// Return the number of worker threads, the calling thread not included
+	/// </summary>
+	static size_t size() { return _threads.size(); }
+
+	/// <summary>
+	/// Call f(i) for i in [0, count) on the worker pool and return when every call is done.
+	/// The first exception thrown by f is thrown back to the caller
+	/// </summary>
+	static void run(size_t count, std::function<void(size_t)> f);
+
+	/// <summary>
+	/// Return f(item) for each item, computed on the worker pool. Results are in items order
+	/// </summary>
+	template<class T, class F> static auto map(std::vector<T>& items, F f) -> std::vector<decltype(f(items[0]))>
+	{
+		std::vector<decltype(f(items[0]))> result(items.size());
+		run(items.size(), [&](size_t i) { result[i] = f(items[i]); });
+		return result;
+	}
+};
+
+#endif
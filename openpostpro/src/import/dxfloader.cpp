@@ -124,11 +124,11 @@ std::vector<Shape*> DxfLoader::add_arc(DxfEntity* e, Renderer* r)
 	// p1
 	auto radius = std::get<float>(e->properties("radius"));
 	auto start = std::get<float>(e->properties("start"));
-	glm::vec2 sv = geometry::position(glm::radians(start), radius) + center;
+	glm::vec2 sv = glm::vec2(geometry::position(glm::radians(start), radius)) + center;
 
 	// p2
 	auto end = std::get<float>(e->properties("end"));
-	glm::vec2 ev = geometry::position(glm::radians(end), radius) + center;
+	glm::vec2 ev = glm::vec2(geometry::position(glm::radians(end), radius)) + center;
 
 	a->set(sv, center, ev, false);
 
@@ -0,0 +1,164 @@
+#include "formatter.h"
+#include <charconv>
+#include <cmath>
+#include <algorithm>
+
+static const double PI = 3.14159265358979323846;
+
+Formatter::Formatter(const Description& description) : _description(description)
+{
+	for (int i = 0; i < 4; i++)
+		_modal[i] = std::find(_description.modal.begin(), _description.modal.end(), _description.codes[i]) != _description.modal.end();
+}
+
+void Formatter::number(double value, std::string& output, bool dry) const
+{
+	// a dry run only needs to know the word is not empty
+	if (dry)
+	{
+		output += '0';
+		return;
+	}
+
+	// as '%.6f' % value in python, trailing zeros then trailing dot removed. to_chars rounds as printf, without the locale
+	char text[64];
+	auto result = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, _description.decimals);
+	if (result.ec != std::errc())
+	{
+		output += std::to_string(value);
+		return;
+	}
+	int size = (int)(result.ptr - text);
+	while (size > 0 && text[size - 1] == '0')
+		size--;
+	if (size > 0 && text[size - 1] == '.')
+		size--;
+	output.append(text, size);
+}
+
+void Formatter::line(std::string& text, State& state, std::string* output) const
+{
+	if (text.empty())
+		return;
+
+	if (_description.increment > 0 && (_description.number.empty() || text[0] != _description.number[0]))
+	{
+		state.line += _description.increment;
+		if (output != nullptr)
+		{
+			std::string n = std::to_string(state.line);
+			*output += _description.number;
+			if ((int)n.size() < _description.digits)
+				output->append(_description.digits - n.size(), '0');
+			*output += n;
+			*output += _description.space;
+		}
+	}
+	if (output != nullptr)
+		*output += text;
+
+	auto& end = _description.end;
+	if (text.size() < end.size() || text.compare(text.size() - end.size(), end.size(), end) != 0)
+	{
+		if (output != nullptr)
+			*output += end;
+		state.count++;
+	}
+}
+
+void Formatter::format(const Move* moves, size_t count, State& state, std::string& output) const
+{
+	process(moves, count, state, &output);
+}
+
+void Formatter::advance(const Move* moves, size_t count, State& state) const
+{
+	process(moves, count, state, nullptr);
+}
+
+void Formatter::process(const Move* moves, size_t count, State& state, std::string* output) const
+{
+	static const char names[] = { 'X', 'Y', 'Z', 'I', 'J' };
+	std::string text;
+
+	for (size_t n = 0; n < count; n++)
+	{
+		const Move& m = moves[n];
+		int type = (int)m.type;
+		int mask = (int)m.mask;
+		text.clear();
+
+		if ((MoveType)type == MoveType::Feed)
+		{
+			if (state.feed != m.values[0])
+			{
+				state.feed = m.values[0];
+				text += _description.feed;
+				number(m.values[0], text, output == nullptr);
+				line(text, state, output);
+			}
+			continue;
+		}
+
+		// code, not repeated when modal
+		auto& code = _description.codes[type];
+		if (!_modal[type] || code != state.code)
+		{
+			if (_modal[type])
+				state.reset = true;
+			text += code;
+			if (!code.empty())
+				text += _description.space;
+		}
+		state.code = code;
+
+		// words in the declared order
+		size_t words = text.size();
+		for (char a : _description.axes)
+		{
+			if (a == 'R')
+			{
+				if ((MoveType)type != MoveType::Clockwise && (MoveType)type != MoveType::CounterClockwise)
+					continue;
+
+				double cx = mask & 8 ? m.values[3] : 0, cy = mask & 16 ? m.values[4] : 0;
+				if (_description.relative)
+				{
+					cx += state.x;
+					cy += state.y;
+				}
+				double ex = mask & 1 ? m.values[0] : state.x, ey = mask & 2 ? m.values[1] : state.y;
+				double r = std::hypot(state.x - cx, state.y - cy);
+				double sweep = std::atan2(ey - cy, ex - cx) - std::atan2(state.y - cy, state.x - cx);
+				if ((MoveType)type == MoveType::Clockwise)
+					sweep = -sweep;
+				if (sweep <= 0)
+					sweep += 2 * PI;
+				// arcs over a half turn have a negative radius
+				text += 'R';
+				number(sweep > PI ? -r : r, text, output == nullptr);
+				text += _description.space;
+				continue;
+			}
+
+			for (int k = 0; k < 5; k++)
+			{
+				if (names[k] == a && (mask & (1 << k)))
+				{
+					text += a;
+					number(m.values[k], text, output == nullptr);
+					text += _description.space;
+				}
+			}
+		}
+		// the words are stripped, the code keeps its space
+		while (text.size() > words && text.back() == ' ')
+			text.pop_back();
+
+		if (mask & 1) state.x = m.values[0];
+		if (mask & 2) state.y = m.values[1];
+		if (mask & 4) state.z = m.values[2];
+
+		line(text, state, output);
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+#ifndef _FORMATTER_H
+#define _FORMATTER_H
+
+#include <string>
+#include <vector>
+
+/************************************************************************
+* Native G-code formatter
+* Postpro records the moves of a toolpath pass as fixed size records. A
+* post-processor declaring a formatter description (def formatter(self) in
+* the python Postpro class) has these records formatted here instead of
+* one python call per move : words in the declared order, numbers with the
+* declared decimals and their trailing zeros removed, modal codes
+* suppressed when repeated, line numbers and I J or R arcs. The output is
+* the one of the python formatting of the generic posts, byte for byte
+*************************************************************************/
+
+/// <summary>
+/// Type of a move record
+/// </summary>
+enum class MoveType { Rapid, Linear, Clockwise, CounterClockwise, Feed };
+
+/// <summary>
+/// A move record is 7 doubles, read as is by postcore.py : type, mask of the axes X Y Z I J sent, values of X Y Z I J.
+/// The feed rate of a Feed record is in X
+/// </summary>
+struct Move
+{
+	double type = 0;
+	double mask = 0;
+	double values[5] = { 0, 0, 0, 0, 0 };
+};
+
+class Formatter
+{
+public:
+	/// <summary>
+	/// Declaration of the post, read from the python dictionary returned by formatter()
+	/// </summary>
+	struct Description
+	{
+		std::string space;			// between words, empty in condensed mode
+		int decimals = 6;			// max number of decimals
+		std::string axes = "XYZIJ";	// words output, in this order. Missing axes are tracked, not output. R outputs the arc radius
+		bool relative = true;		// I J relative to the start of the arc
+		std::string codes[4] = { "G0", "G1", "G2", "G3" };	// rapid, linear, clockwise, counter clockwise
+		std::vector<std::string> modal = { "G1", "G2", "G3" };	// codes not repeated
+		std::string feed = "F";
+		std::string number = "N";	// line number word
+		int increment = -1;			// line number increment, -1 without numbering
+		int digits = 5;				// line number zero filled width
+		std::string end = "\n";		// end of line
+	};
+
+	/// <summary>
+	/// Modal state, read from postcore.py before a pass and written back after
+	/// </summary>
+	struct State
+	{
+		double x = 0, y = 0, z = 0;
+		long long line = 0;			// last line number
+		long long count = 0;		// number of lines
+		double feed = 0;
+		std::string code;			// last code
+		bool reset = false;			// true when a modal code changed, the post resets its other modal words
+	};
+
+private:
+	Description _description;
+	bool _modal[4] = { false, false, false, false };
+
+	void number(double value, std::string& output, bool dry) const;
+	void line(std::string& text, State& state, std::string* output) const;
+
+	/// <summary>
+	/// Format the moves to output, or only advance the state when output is null
+	/// </summary>
+	void process(const Move* moves, size_t count, State& state, std::string* output) const;
+
+public:
+	Formatter(const Description& description);
+
+	const Description& description() const { return _description; }
+
+	/// <summary>
+	/// Append the lines of count moves to output, from and to state
+	/// </summary>
+	void format(const Move* moves, size_t count, State& state, std::string& output) const;
+
+	/// <summary>
+	/// Move state over count moves as format does, without the text. The passes of a program can then
+	/// be formatted concurrently, each from its entry state
+	/// </summary>
+	void advance(const Move* moves, size_t count, State& state) const;
+};
+
+#endif
@@ -15,6 +15,8 @@
 #include <logger.h>
 #include <drill.h>
 #include <moveTo.h>
+#include <config.h>
+#include <workers.h>
 
 
 int Postpro::get_line_count()
@@ -172,6 +174,9 @@ Postpro::~Postpro()
 
 bool Postpro::initialize(std::string module_path, std::string lang)
 {
+	// a loaded session is released first, its module is imported again only if its file changed
+	release();
+
 	Script::initialize("postcore", lang);
 
 	if (stringex::end_with(module_path, ".py"))
@@ -186,7 +191,7 @@ bool Postpro::initialize(std::string module_path, std::string lang)
 	// instanciate class Postpro into _py_post_object
 	try
 	{
-		_py_post_module = PyImport_ImportModule(_module.c_str());
+		_py_post_module = import(_module);
 
 		if (_py_post_module != NULL && !PyErr_Occurred())
 		{
@@ -240,25 +245,25 @@ bool Postpro::initialize(std::string module_path, std::string lang)
 				{
 					_properties.push_back((bool)PyObject_IsTrue(p));
 					_properties[i] = ini.get_bool(_module, std::to_string(i), std::get<bool>(_properties[i]));
-					set("set_property", "ii", i, (long)std::get<bool>(_properties[i]));
+					set_property(i, _properties[i]);
 				}
 				else if (PyLong_Check(p))
 				{
 					_properties.push_back((int)PyLong_AsLong(p));
 					_properties[i] = ini.get_int(_module, std::to_string(i), std::get<int>(_properties[i]));
-					set("set_property", "ii", i, std::get<int>(_properties[i]));
+					set_property(i, _properties[i]);
 				}
 				else if (PyFloat_Check(p))
 				{
 					_properties.push_back((float)PyFloat_AsDouble(p));
 					_properties[i] = ini.get_float(_module, std::to_string(i), std::get<float>(_properties[i]));
-					set("set_property", "if", i, std::get<float>(_properties[i]));
+					set_property(i, _properties[i]);
 				}
 				else if (PyUnicode_Check(p))
 				{
 					_properties.push_back(std::string(PyUnicode_AsUTF8(p)));
 					_properties[i] = ini.get_string(_module, std::to_string(i), std::get<std::string>(_properties[i]));
-					set("set_property", "is", i, (std::get<std::string>(_properties[i])).c_str());
+					set_property(i, _properties[i]);
 				}
 				else if (PyList_Check(p))
 				{
@@ -271,7 +276,7 @@ bool Postpro::initialize(std::string module_path, std::string lang)
 
 					values[0] = ini.get_string(_module, std::to_string(i), values[0]);
 					_properties.push_back(values);
-					set("set_property", "is", i, (std::get<std::vector<std::string>>(_properties[i])[0]).c_str());
+					set_property(i, _properties[i]);
 				}
 				Py_DECREF(p);
 			}
@@ -282,6 +287,14 @@ bool Postpro::initialize(std::string module_path, std::string lang)
 		_category = get_string("get_category");
 		_extention = get_string("get_extention");
 		_ijk_relative = get_bool("ijk_relative");
+		_disable_z = get_disable_z();
+		_bulk = PyObject_HasAttrString(_py_core_object, "moves");
+		load_formatter();
+		_parallel = _formatter && config.output_parallel;
+		_recording = false;
+		_moves.clear();
+		_fragments.clear();
+		_pending = 0;
 	}
 	catch (const std::exception& e)
 	{
@@ -295,6 +308,12 @@ bool Postpro::initialize(std::string module_path, std::string lang)
 
 void Postpro::finalize()
 {
+	if (!_save)
+	{
+		release();
+		return;
+	}
+
 	IniFile ini;
 	for (int i = 0; i < _properties.size(); i++)
 	{
@@ -321,6 +340,11 @@ void Postpro::finalize()
 	}
 	ini.write();
 
+	release();
+}
+
+void Postpro::release()
+{
 	if (_py_post_object != NULL ) Py_CLEAR(_py_post_object);
 	if (_py_post_class != NULL) Py_CLEAR(_py_post_class);
 	if (_py_post_module != NULL) Py_CLEAR(_py_post_module);
@@ -328,6 +352,48 @@ void Postpro::finalize()
 	Script::finalize();
 }
 
+void Postpro::reset()
+{
+	// new objects of the loaded classes : the module is not imported and the properties are not read again
+	if (_py_post_object != NULL) Py_CLEAR(_py_post_object);
+	if (_py_core_object != NULL) Py_CLEAR(_py_core_object);
+
+	_py_core_object = PyObject_CallObject(_py_core_class, NULL);
+	_py_post_object = PyObject_CallObject(_py_post_class, NULL);
+	if (_py_core_object == NULL || _py_post_object == NULL)
+		throw std::runtime_error("Reset of post-processor " + _module + " [" + Script::python_error() + "]");
+
+	set_postpro();
+	set("set_language", "s", _lang.c_str());
+	for (int i = 0; i < _properties.size(); i++)
+		set_property(i, _properties[i]);
+
+	_pos = glm::vec3(0, 0, 0);
+	_recording = false;
+	_moves.clear();
+	_fragments.clear();
+	_pending = 0;
+}
+
+bool Postpro::open()
+{
+	if (_py_post_object != NULL && _py_core_object != NULL && !modified())
+	{
+		try
+		{
+			reset();
+			return true;
+		}
+		catch (const std::exception& e)
+		{
+			Logger::error(e.what());
+		}
+	}
+
+	// first run, changed file or failed reset
+	return initialize(_module, _lang);
+}
+
 
 bool Postpro::render_GUI()
 {
@@ -474,115 +540,132 @@ std::string Postpro::rapid(glm::vec3 value)
 	return linear(value, true);
 }
 
-std::string Postpro::linear(glm::vec3 value, bool rapid)
+bool Postpro::move(MoveType type, glm::vec3 value, glm::vec2 center, Move& m)
 {
-	std::vector<std::string> a_axes;
-	std::vector<float> a_values;
+	static_assert(sizeof(Move) == 7 * sizeof(double), "move records are read as doubles by postcore.py");
+
+	bool circular = type == MoveType::Clockwise || type == MoveType::CounterClockwise;
+	int mask = 0;
 
+	m.type = (double)type;
 	if (value.x != _pos.x)
 	{
-		a_axes.push_back("X");
-		a_values.push_back(value.x);
+		mask |= 1;
+		m.values[0] = value.x;
 	}
 	if (value.y != _pos.y)
 	{
-		a_axes.push_back("Y");
-		a_values.push_back(value.y);
+		mask |= 2;
+		m.values[1] = value.y;
 	}
-	if (value.z != _pos.z && get_disable_z() == false)
+	// arcs keep their Z when it is disabled
+	if (value.z != _pos.z && (circular || !_disable_z))
 	{
-		a_axes.push_back("Z");
-		a_values.push_back(value.z);
+		mask |= 4;
+		m.values[2] = value.z;
 	}
-	
-	std::string answer;
 
-	if (a_axes.size() > 0)
+	if (circular)
 	{
-		PyObject* axes = PyTuple_New(a_axes.size());
-		PyObject* values = PyTuple_New(a_axes.size());
-		for (int i = 0; i < a_axes.size(); i++)
+		float i = center.x, j = center.y;
+		if (_ijk_relative)
 		{
-			PyTuple_SetItem(axes, i, PyUnicode_FromString(a_axes[i].c_str()));
-			PyTuple_SetItem(values, i, PyFloat_FromDouble(a_values[i]));
+			i = center.x - _pos.x;
+			j = center.y - _pos.y;
 		}
-		PyObject* result = PyObject_CallMethod(_py_core_object, (rapid ? "rapid" : "linear"), "OO", axes, values);
-
-		Py_DECREF(axes);
-		Py_DECREF(values);
-
-		if (result != NULL)
+		if (!_ijk_relative || _ijk_relative && i != 0)
 		{
-			if (PyUnicode_Check(result))
-				answer = PyUnicode_AsUTF8(result);
-			Py_DecRef(result);
+			mask |= 8;
+			m.values[3] = i;
 		}
-		else
+		if (!_ijk_relative || _ijk_relative && j != 0)
 		{
-			auto message = std::string("Method ") + (rapid ? "rapid" : "linear") + " is missing from Postpro";
-			throw std::runtime_error(message);
+			mask |= 16;
+			m.values[4] = j;
 		}
-
-		_pos = value;
 	}
 
-	return answer;
+	m.mask = mask;
+	if (mask == 0)
+		return false;
+
+	_pos = value;
+	return true;
 }
 
-std::string Postpro::circular(glm::vec3 value, glm::vec2 center, bool cw)
+std::string Postpro::send(const Move& m)
 {
-	std::vector<std::string> a_axes;
-	std::vector<float> a_values;
-
-	if (value.x != _pos.x)
-	{
-		a_axes.push_back("X");
-		a_values.push_back(value.x);
-	}
-	if (value.y != _pos.y)
-	{
-		a_axes.push_back("Y");
-		a_values.push_back(value.y);
-	}
-	if (value.z != _pos.z)
+	if (_recording)
 	{
-		a_axes.push_back("Z");
-		a_values.push_back(value.z);
+		_moves.push_back(m);
+		return std::string();
 	}
-	
-	float i = center.x, j = center.y;
-	if (_ijk_relative)
+	return call(m);
+}
+
+std::string Postpro::call(const Move& m)
+{
+	static const char* names[] = { "X", "Y", "Z", "I", "J" };
+	static const char* methods[] = { "rapid", "linear", "clockwise", "counter_clockwise" };
+
+	if ((MoveType)m.type == MoveType::Feed)
+		return get_string("feed", "f", (float)m.values[0]);
+
+	int mask = (int)m.mask;
+	std::vector<int> indices;
+	for (int i = 0; i < 5; i++)
+		if (mask & (1 << i))
+			indices.push_back(i);
+
+	PyObject* axes = PyTuple_New(indices.size());
+	PyObject* values = PyTuple_New(indices.size());
+	for (int i = 0; i < indices.size(); i++)
 	{
-		i = center.x - _pos.x;
-		j = center.y - _pos.y;
+		PyTuple_SetItem(axes, i, PyUnicode_FromString(names[indices[i]]));
+		PyTuple_SetItem(values, i, PyFloat_FromDouble(m.values[indices[i]]));
 	}
-	if (!_ijk_relative || _ijk_relative && i != 0)
+	const char* method = methods[(int)m.type];
+	PyObject* result = PyObject_CallMethod(_py_core_object, method, "OO", axes, values);
+
+	Py_DECREF(axes);
+	Py_DECREF(values);
+
+	std::string answer;
+	if (result != NULL)
 	{
-		a_axes.push_back("I");
-		a_values.push_back(i);
+		if (PyUnicode_Check(result))
+			answer = PyUnicode_AsUTF8(result);
+		Py_DecRef(result);
 	}
-	if (!_ijk_relative || _ijk_relative && j != 0)
+	else
 	{
-		a_axes.push_back("J");
-		a_values.push_back(j);
+		auto message = std::string("Method ") + method + " is missing from Postpro";
+		throw std::runtime_error(message);
 	}
 
+	return answer;
+}
 
+void Postpro::flush(std::string& output)
+{
 	std::string answer;
 
-	if (a_axes.size() > 0)
+	if (_moves.size() == 0)
+		return;
+
+	if (_formatter)
 	{
-		PyObject* axes = PyTuple_New(a_axes.size());
-		PyObject* values = PyTuple_New(a_axes.size());
-		for (int i = 0; i < a_axes.size(); i++)
-		{
-			PyTuple_SetItem(axes, i, PyUnicode_FromString(a_axes[i].c_str()));
-			PyTuple_SetItem(values, i, PyFloat_FromDouble(a_values[i]));
-		}
-		PyObject* result = PyObject_CallMethod(_py_core_object, (cw ? "clockwise" : "counter_clockwise"), "OO", axes, values);
+		format(output);
+		return;
+	}
 
-		Py_DECREF(axes);
-		Py_DECREF(values);
+	if (_bulk)
+	{
+		// the records are lent to postcore.py for the call only, without copy
+		PyObject* data = PyMemoryView_FromMemory((char*)_moves.data(), _moves.size() * sizeof(Move), PyBUF_READ);
+		PyObject* result = PyObject_CallMethod(_py_core_object, "moves", "O", data);
+		Py_DECREF(data);
+		_moves.clear();
 
 		if (result != NULL)
 		{
@@ -592,18 +675,185 @@ std::string Postpro::circular(glm::vec3 value, glm::vec2 center, bool cw)
 		}
 		else
 		{
-			auto message = std::string("Method ") + (cw ? "clockwise" : "counter_clockwise") + " is missing from Postpro";
+			auto message = error("moves");
 			throw std::runtime_error(message);
 		}
+	}
+	else
+	{
+		for (const Move& m : _moves)
+			answer += call(m);
+		_moves.clear();
+	}
 
-		_pos = value;
+	output += answer;
+}
+
+void Postpro::load_formatter()
+{
+	_formatter.reset();
+
+	PyObject* d = get("get_formatter");
+	if (d == NULL)
+	{
+		auto message = error("get_formatter");
+		throw std::runtime_error(message);
 	}
-	return answer;
+
+	// old posts have no formatter
+	if (_native && PyDict_Check(d))
+	{
+		Formatter::Description description;
+		description.relative = _ijk_relative;
+
+		auto text = [d](const char* key, std::string& value) {
+			PyObject* v = PyDict_GetItemString(d, key);
+			if (v != NULL && PyUnicode_Check(v))
+				value = PyUnicode_AsUTF8(v);
+		};
+		auto integer = [d](const char* key, int& value) {
+			PyObject* v = PyDict_GetItemString(d, key);
+			if (v != NULL && PyLong_Check(v))
+				value = (int)PyLong_AsLong(v);
+		};
+		auto texts = [d](const char* key) {
+			std::vector<std::string> values;
+			PyObject* v = PyDict_GetItemString(d, key);
+			if (v != NULL && PySequence_Check(v) && !PyUnicode_Check(v))
+			{
+				for (Py_ssize_t i = 0; i < PySequence_Size(v); i++)
+				{
+					PyObject* item = PySequence_GetItem(v, i);
+					if (item != NULL && PyUnicode_Check(item))
+						values.push_back(PyUnicode_AsUTF8(item));
+					Py_XDECREF(item);
+				}
+			}
+			return values;
+		};
+
+		text("space", description.space);
+		integer("decimals", description.decimals);
+		text("axes", description.axes);
+		text("feed", description.feed);
+		text("number", description.number);
+		integer("increment", description.increment);
+		integer("digits", description.digits);
+		text("end", description.end);
+
+		auto codes = texts("codes");
+		if (codes.size() == 4)
+			std::copy(codes.begin(), codes.end(), description.codes);
+		if (PyDict_GetItemString(d, "modal") != NULL)
+			description.modal = texts("modal");
+
+		_formatter.emplace(description);
+	}
+
+	Py_DECREF(d);
+}
+
+void Postpro::format(std::string& output)
+{
+	Formatter::State state;
+
+	PyObject* s = get("get_format_state");
+	if (s == NULL || !PyTuple_Check(s) || PyTuple_Size(s) != 7)
+	{
+		Py_XDECREF(s);
+		auto message = error("get_format_state");
+		throw std::runtime_error(message);
+	}
+	state.x = PyFloat_AsDouble(PyTuple_GetItem(s, 0));
+	state.y = PyFloat_AsDouble(PyTuple_GetItem(s, 1));
+	state.z = PyFloat_AsDouble(PyTuple_GetItem(s, 2));
+	state.line = PyLong_AsLongLong(PyTuple_GetItem(s, 3));
+	state.count = PyLong_AsLongLong(PyTuple_GetItem(s, 4));
+	state.feed = PyFloat_AsDouble(PyTuple_GetItem(s, 5));
+	if (PyUnicode_Check(PyTuple_GetItem(s, 6)))
+		state.code = PyUnicode_AsUTF8(PyTuple_GetItem(s, 6));
+	Py_DECREF(s);
+
+	if (_parallel)
+	{
+		// the pass is formatted later from its entry state, the post goes on from its exit state
+		Fragment f;
+		f.text = std::move(output);
+		f.state = state;
+		f.moves = std::move(_moves);
+		_formatter->advance(f.moves.data(), f.moves.size(), state);
+		_pending += f.moves.size();
+		_fragments.push_back(std::move(f));
+		output.clear();
+		_moves.clear();
+	}
+	else
+	{
+		_formatter->format(_moves.data(), _moves.size(), state, output);
+		_moves.clear();
+	}
+
+	set("set_format_state", "dddLLdsi", state.x, state.y, state.z, state.line, state.count, state.feed, state.code.c_str(), (int)state.reset);
+}
+
+void Postpro::write(file::Writer& writer, std::string& output)
+{
+	if (_fragments.empty())
+		writer.write(output);
+	else
+	{
+		Fragment f;
+		f.text = std::move(output);
+		_fragments.push_back(std::move(f));
+	}
+	output.clear();
+
+	if (_pending > PENDING)
+		drain(writer);
+}
+
+void Postpro::drain(file::Writer& writer)
+{
+	std::vector<std::string> passes(_fragments.size());
+	Workers::run(_fragments.size(), [this, &passes](size_t i) {
+		Fragment& f = _fragments[i];
+		if (f.moves.size() > 0)
+			_formatter->format(f.moves.data(), f.moves.size(), f.state, passes[i]);
+	});
+
+	for (size_t i = 0; i < _fragments.size(); i++)
+	{
+		writer.write(_fragments[i].text);
+		writer.write(passes[i]);
+	}
+	_fragments.clear();
+	_pending = 0;
+}
+
+std::string Postpro::linear(glm::vec3 value, bool rapid)
+{
+	Move m;
+	if (!move(rapid ? MoveType::Rapid : MoveType::Linear, value, glm::vec2(), m))
+		return std::string();
+
+	return send(m);
+}
+
+std::string Postpro::circular(glm::vec3 value, glm::vec2 center, bool cw)
+{
+	Move m;
+	if (!move(cw ? MoveType::Clockwise : MoveType::CounterClockwise, value, center, m))
+		return std::string();
+
+	return send(m);
 }
 
 std::string Postpro::feed(float value)
 {
-	return get_string("feed", "f", value);
+	Move m;
+	m.type = (double)MoveType::Feed;
+	m.values[0] = value;
+	return send(m);
 }
 
 std::string Postpro::drilling(glm::vec3 value, float retract, int pause)
@@ -844,11 +1094,135 @@ std::string Postpro::line(std::string value)
 	return result;
 }
 
+void Postpro::toolpath(Group* g, Toolpath* t, glm::vec2 offset, bool first, file::Writer& writer)
+{
+	std::string output = "";
+
+	for (Curve& c : t->coordinates())
+	{
+		_pos = get_current_position();
+
+		// the tool is left to safe z
+		output += rapid('Z', g->safe());
+
+		// we rapid move to first coordinates
+		output += rapid(glm::vec3(c[0].point.x + offset.x, c[0].point.y + offset.y, g->safe()));
+
+
+		if (t->type() == GraphicType::CamDrill) // special case drilling
+		{
+			Drill* d = (Drill*)t;
+			switch (d->mode())
+			{
+			case DrillMode::Drilling:
+				output += drilling(glm::vec3(d->point().x + offset.x, d->point().y + offset.y, g->depth()), d->retract(), d->pause());
+				break;
+			case DrillMode::Pecking:
+				output += pecking(glm::vec3(d->point().x + offset.x, d->point().y + offset.y, g->depth()), d->retract(), d->delta());
+				break;
+			case DrillMode::Tapping:
+				output += tapping(glm::vec3(d->point().x + offset.x, d->point().y + offset.y, g->depth()), d->retract());
+				break;
+			case DrillMode::Boring:
+				output += boring(glm::vec3(d->point().x + offset.x, d->point().y + offset.y, g->depth()), d->retract(), d->pause());
+				break;
+			}
+		}
+		else if (t->type() == GraphicType::CamMoveTo) // special case move to
+		{
+			MoveTo* d = (MoveTo*)t;
+			output += rapid(glm::vec3(d->point().x + offset.x, d->point().y + offset.y, g->safe()));
+			if (d->pause() > 0)
+				output += pause(d->pause());
+		}
+		else
+		{
+			// dense polylines from splines and texts are sent as lines and arcs, once for all the instances
+			if (first)
+				c.simplify(geometry::ERR_FLOAT2);
+
+			// moves are sent by pass
+			_recording = true;
+
+			// we plung
+			if (_disable_z == false)
+			{
+				float z = std::max(g->origin() - g->pass(), g->depth());
+				bool first_z = true;
+
+				while (z >= g->depth())
+				{
+					// go down to Z working position
+					output += feed(g->plung_feed());
+					output += linear(glm::vec3(c[0].point.x + offset.x, c[0].point.y + offset.y, z));
+					output += feed(g->feed());
+
+					// if first pass, call start_single_path
+					if (first_z)
+					{
+						flush(output);
+						output += start_single_path();
+						first_z = false;
+					}
+
+					auto from = c.front();
+					auto next = c.begin() + 1;
+
+					while (next != c.end())
+					{
+						if (from.type == SegmentType::Line)
+							output += linear(glm::vec3(glm::vec2((*next).point) + offset, z));
+						else
+							output += circular(glm::vec3(glm::vec2((*next).point) + offset, z), glm::vec2(from.center) + offset, from.cw);
+						from = (*next);
+						next = std::next(next);
+					}
+					flush(output);
+
+					if (z == g->depth())
+						break;
+					else
+						z = std::max(z - g->pass(), g->depth());
+				}
+			}
+			else
+			{
+				output += start_single_path();
+
+				auto from = c.front();
+				auto next = c.begin() + 1;
+				while (next != c.end())
+				{
+					if (from.type == SegmentType::Line)
+						output += linear(glm::vec3(glm::vec2((*next).point) + offset, 0));
+					else
+						output += circular(glm::vec3(glm::vec2((*next).point) + offset, 0), glm::vec2(from.center) + offset, from.cw);
+					from = (*next);
+					next = std::next(next);
+				}
+				flush(output);
+			}
+
+			_recording = false;
+			output += stop_single_path();
+		}
+
+		output += stop_toolpath();
+
+		// written by curve, large toolpaths are not kept in memory
+		write(writer, output);
+	}
+}
+
 std::string Postpro::run(Document* doc, std::string path, std::string version)
 {
 	auto t = std::chrono::high_resolution_clock::now();
 
-	initialize(_module, _lang);
+	if (!open())
+	{
+		Logger::error("Loading post-processor " + _module + " -> " + _error);
+		return std::string();
+	}
 
 	// ensure existence of path
 	Directory::create(path);
@@ -856,6 +1230,14 @@ std::string Postpro::run(Document* doc, std::string path, std::string version)
 	std::string output_path = environment::combine_path(path, std::filesystem::path(doc->path()).stem().string() + "." + extention());
 	std::string output = "";
 
+	// the program is streamed to the file, output holds the text since the last write
+	file::Writer writer(output_path, (size_t)std::max(1, config.output_buffer_size) * 1024, config.output_thread);
+	if (!writer.is_open())
+	{
+		Logger::error(std::string("Writing file (") + output_path + ")");
+		return std::string();
+	}
+
 
 	output += start_loop();
 
@@ -882,110 +1264,20 @@ std::string Postpro::run(Document* doc, std::string path, std::string version)
 			output += start_tool_radius_compensation(g->tool_radius_compensation());
 			output += start_tool_length_compensation(g->tool_length_compensation());
 
-			// we loop into toolpaths
-			for (Toolpath* t : g->toolpaths())
+			// we loop into the instances of the group, then into toolpaths : toolpaths are computed once and moved to each instance
+			auto instances = g->instances();
+			for (size_t i = 0; i < instances.size(); i++)
 			{
-				output += comment("TOOLPATH [" + t->name() + "]");
-				output += start_toolpath();
-				for (auto c : t->coordinates())
-				{
-					_pos = get_current_position();
-
-					// the tool is left to safe z
-					output += rapid('Z', g->safe());
-
-					// we rapid move to first coordinates
-					output += rapid(glm::vec3(c[0].point.x, c[0].point.y, g->safe()));
+				if (instances.size() > 1)
+					output += comment("INSTANCE [" + std::to_string(i + 1) + "/" + std::to_string(instances.size()) + "]");
 
-
-					if (t->type() == GraphicType::CamDrill) // special case drilling
-					{
-						Drill* d = (Drill*)t;
-						switch (d->mode())
-						{
-						case DrillMode::Drilling:
-							output += drilling(glm::vec3(d->point().x, d->point().y, g->depth()), d->retract(), d->pause());
-							break;
-						case DrillMode::Pecking:
-							output += pecking(glm::vec3(d->point().x, d->point().y, g->depth()), d->retract(), d->delta());
-							break;
-						case DrillMode::Tapping:
-							output += tapping(glm::vec3(d->point().x, d->point().y, g->depth()), d->retract());
-							break;
-						case DrillMode::Boring:
-							output += boring(glm::vec3(d->point().x, d->point().y, g->depth()), d->retract(), d->pause());
-							break;
-						}
-					}
-					else if (t->type() == GraphicType::CamMoveTo) // special case move to
-					{
-						MoveTo* d = (MoveTo*)t;
-						output += rapid(glm::vec3(d->point().x, d->point().y, g->safe()));
-						if (d->pause() > 0)
-							output += pause(d->pause());
-					}
-					else
-					{
-						// we plung
-						if (get_disable_z() == false)
-						{
-							float z = std::max(g->origin() - g->pass(), g->depth());
-							bool first_z = true;
-
-							while (z >= g->depth())
-							{
-								// go down to Z working position
-								output += feed(g->plung_feed());
-								output += linear(glm::vec3(c[0].point.x, c[0].point.y, z));
-								output += feed(g->feed());
-
-								// if first pass, call start_single_path
-								if (first_z)
-								{
-									output += start_single_path();
-									first_z = false;
-								}
-
-								auto from = c.front();
-								auto next = c.begin() + 1;
-
-								while (next != c.end())
-								{
-									if (from.type == SegmentType::Line)
-										output += linear(glm::vec3((*next).point, z));
-									else
-										output += circular(glm::vec3((*next).point, z), from.center, from.cw);
-									from = (*next);
-									next = std::next(next);
-								}
-
-								if (z == g->depth())
-									break;
-								else
-									z = std::max(z - g->pass(), g->depth());
-							}
-						}
-						else
-						{
-							output += start_single_path();
-
-							auto from = c.front();
-							auto next = c.begin() + 1;
-							while (next != c.end())
-							{
-								if (from.type == SegmentType::Line)
-									output += linear(glm::vec3((*next).point, 0));
-								else
-									output += circular(glm::vec3((*next).point, 0), from.center, from.cw);
-								from = (*next);
-								next = std::next(next);
-							}
-						}
-
-						output += stop_single_path();
-					}
-
-					output += stop_toolpath();
+				for (Toolpath* t : g->toolpaths())
+				{
+					output += comment("TOOLPATH [" + t->name() + "]");
+					output += start_toolpath();
+					t->wait();
+					write(writer, output);
+					toolpath(g, t, instances[i], i == 0, writer);
 				}
 			}
 
@@ -1006,16 +1298,16 @@ std::string Postpro::run(Document* doc, std::string path, std::string version)
 	auto line_count = get_line_count();
 
 	try {
-		file::write_all_text(output_path, output);
+		write(writer, output);
+		drain(writer);
+		writer.close();
 	}
 	catch (const std::runtime_error& e)
 	{
 		Logger::error(std::string("Writing file (") + output_path + ") [" + e.what() + "]");
 	}
 
-
-	finalize();
-
+	// the session stays loaded for the next run
 	doc->output(output_path);
 
 	Logger::log("Output time (ms): " + std::to_string(std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(std::chrono::high_resolution_clock::now() - t).count()));
@@ -5,8 +5,11 @@
 #include <string>
 #include <vector>
 #include <variant>
+#include <optional>
 #include <document.h>
 #include <script.h>
+#include <formatter.h>
+#include <file.h>
 
 
 // The Postpro python object uses a postcore.py intermediate file
@@ -26,12 +29,35 @@ private:
 	bool _ijk_relative = true;
 
 	glm::vec3 _pos = glm::vec3(0,0,0);
+	bool _disable_z = false;
+
+	// moves of a toolpath pass are recorded, then formatted natively when the post declares a formatter,
+	// sent to postcore.py at once when it has the moves method, one call per move otherwise
+	std::vector<Move> _moves;
+	bool _recording = false;
+	bool _bulk = false;
+	bool _native = true;
+	std::optional<Formatter> _formatter;
+
+	// with a formatter, the passes can be formatted on the worker pool : each pass is kept with the text
+	// before it and its entry state, the post goes on from the exit state given by Formatter::advance
+	struct Fragment
+	{
+		std::string text;
+		std::vector<Move> moves;
+		Formatter::State state;
+	};
+	std::vector<Fragment> _fragments;
+	size_t _pending = 0;				// moves kept in the fragments
+	bool _parallel = false;
+	static constexpr size_t PENDING = 1 << 18;
 
 	int _property_count=0;
 	std::vector<std::variant<bool, int, float, std::string, std::vector<std::string>>> _properties;
 	std::vector<std::variant<bool, int, float, std::string, std::vector<std::string>>> _properties_config;
 	std::vector<std::string> _property_names;
 	bool _first_call = true;
+	bool _save = true;					// finalize writes the properties to the INI file
 
 	// postpro python class
 	PyObject* _py_post_module = nullptr;
@@ -54,6 +80,63 @@ private:
 
 	bool get_disable_z();
 
+	/// <summary>
+	/// Release the python objects, without saving the properties
+	/// </summary>
+	void release();
+
+	/// <summary>
+	/// Reset the per run state of a loaded session : new Postcore and Postpro python objects with the loaded properties
+	/// </summary>
+	void reset();
+
+	/// <summary>
+	/// Start a run : reset the loaded session, or load it when there is none or its file changed
+	/// </summary>
+	/// <returns>True if no errors</returns>
+	bool open();
+
+	/// <summary>
+	/// Add the axes of the move to value to m, the ones which change only. Return false when nothing moves
+	/// </summary>
+	bool move(MoveType type, glm::vec3 value, glm::vec2 center, Move& m);
+
+	/// <summary>
+	/// Output of move m, recorded when recording, a call to postcore.py otherwise
+	/// </summary>
+	std::string send(const Move& m);
+
+	/// <summary>
+	/// Single call to postcore.py for a move
+	/// </summary>
+	std::string call(const Move& m);
+
+	/// <summary>
+	/// Append the output of the recorded moves to output, sent at once
+	/// </summary>
+	void flush(std::string& output);
+
+	/// <summary>
+	/// Formatter of the post from the dictionary returned by its formatter method, none without
+	/// </summary>
+	void load_formatter();
+
+	/// <summary>
+	/// Native output of the recorded moves, the modal state is read from postcore.py and written back.
+	/// In parallel mode, output and the moves are kept in a fragment and output is cleared
+	/// </summary>
+	void format(std::string& output);
+
+	/// <summary>
+	/// Write output to writer after the pending fragments, then clear it. Fragments are drained above PENDING moves
+	/// </summary>
+	void write(file::Writer& writer, std::string& output);
+
+	/// <summary>
+	/// Format the pending passes on the worker pool and write the fragments in order
+	/// </summary>
+	void drain(file::Writer& writer);
+
 	std::string start_loop();
 	std::string stop_loop();
 	std::string start_program();
@@ -69,6 +152,11 @@ private:
 	std::string start_single_path();
 	std::string stop_single_path();
 
+	/// <summary>
+	/// Write the output of the curves of toolpath t of group g, moved by offset. First is true for the first instance
+	/// </summary>
+	void toolpath(Group* g, Toolpath* t, glm::vec2 offset, bool first, file::Writer& writer);
+
 	// postpro calling
 	
 	//std::string get_string(std::string method, const char* format = NULL, ...);
@@ -91,10 +179,20 @@ public:
 	bool initialize(std::string module_path, std::string lang) override;
 
 	/// <summary>
-	/// Release memory
+	/// Save the properties and release memory. Runs keep the post loaded until it is called
 	/// </summary>
 	void finalize() override;
 
+	/// <summary>
+	/// Write the properties on finalize or not, the batch processes only read them
+	/// </summary>
+	void save(bool value) { _save = value; }
+
+	/// <summary>
+	/// Format the moves natively when the post declares a formatter, or always in postcore.py. Set before initialize
+	/// </summary>
+	void native(bool value) { _native = value; }
+
 	/// <summary>
 	/// Render the config dialog box
 	/// </summary>
@@ -64,6 +64,44 @@ std::string Script::error(std::string method)
 	return std::string("Method \"" + method + "\" [" + Script::python_error() + "]");
 }
 
+PyObject* Script::import(std::string name)
+{
+	PyObject* module = PyImport_ImportModule(name.c_str());
+
+	if (module != NULL && !_path.empty() && std::filesystem::exists(_path))
+	{
+		auto time = std::filesystem::last_write_time(_path);
+		if (_time != std::filesystem::file_time_type() && time != _time)
+		{
+			PyObject* reloaded = PyImport_ReloadModule(module);
+			Py_DECREF(module);
+			module = reloaded;
+		}
+		_time = time;
+	}
+
+	return module;
+}
+
+void Script::set_property(int i, const std::variant<bool, int, float, std::string, std::vector<std::string>>& value)
+{
+	if (std::holds_alternative<bool>(value))
+		set("set_property", "ii", i, (long)std::get<bool>(value));
+	else if (std::holds_alternative<int>(value))
+		set("set_property", "ii", i, std::get<int>(value));
+	else if (std::holds_alternative<float>(value))
+		set("set_property", "if", i, std::get<float>(value));
+	else if (std::holds_alternative<std::string>(value))
+		set("set_property", "is", i, (std::get<std::string>(value)).c_str());
+	else if (std::holds_alternative<std::vector<std::string>>(value))
+		set("set_property", "is", i, (std::get<std::vector<std::string>>(value)[0]).c_str());
+}
+
+bool Script::modified()
+{
+	return !_path.empty() && std::filesystem::exists(_path) && std::filesystem::last_write_time(_path) != _time;
+}
+
 
 void Script::add_module_path(std::string path)
 {
@@ -3,6 +3,8 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <variant>
+#include <filesystem>
 
 #ifdef _DEBUG
 #       define _NEEDS_REDEFINED_DEBUG
@@ -69,6 +71,9 @@ protected:
 	PyObject* _py_core_class = nullptr;
 	PyObject* _py_core_object = nullptr;
 
+	// last write time of the file at _path when its module was loaded
+	std::filesystem::file_time_type _time;
+
 protected:
 	/// <summary>
 	/// Return an error text including method name from _py_core_object object and CPython error desc
@@ -76,6 +81,18 @@ protected:
 	/// <returns></returns>
 	std::string error(std::string method);
 
+	/// <summary>
+	/// Import the module of the file at _path. Python keeps it in sys.modules, it is reloaded only when the file changed since the last import
+	/// </summary>
+	/// <param name="name">Module name</param>
+	/// <returns>New reference to the module, NULL on error</returns>
+	PyObject* import(std::string name);
+
+	/// <summary>
+	/// Send property i, typed as returned by get_property, to set_property of _py_core_object
+	/// </summary>
+	void set_property(int i, const std::variant<bool, int, float, std::string, std::vector<std::string>>& value);
+
 public:
 	////////////////////
 	// Static methods //
@@ -131,6 +148,11 @@ public:
 	/// </summary>
 	virtual void finalize();
 
+	/// <summary>
+	/// Return true when the file at _path changed since its module was loaded
+	/// </summary>
+	bool modified();
+
 	/// <summary>
 	/// Return the module math
 	/// </summary>
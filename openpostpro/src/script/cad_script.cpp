@@ -32,6 +32,9 @@ CadScript::~CadScript()
 
 bool CadScript::initialize(std::string module_path, std::string lang)
 {
+	// a loaded session is released first, its module is imported again only if its file changed
+	release();
+
 	Script::initialize("cadcore", lang);
 	
 	if (!module_path.empty())
@@ -58,7 +61,7 @@ bool CadScript::initialize(std::string module_path, std::string lang)
 	// instanciate class Postpro into _py_post_object
 	try
 	{
-		_py_script_module = PyImport_ImportModule(_module.c_str());
+		_py_script_module = import(_module);
 
 		if (_py_script_module != NULL && !PyErr_Occurred())
 		{
@@ -111,25 +114,25 @@ bool CadScript::initialize(std::string module_path, std::string lang)
 				{
 					_properties.push_back((bool)PyObject_IsTrue(p));
 					_properties[i] = ini.get_bool(_module, std::to_string(i), std::get<bool>(_properties[i]));
-					set("set_property", "ii", i, (long)std::get<bool>(_properties[i]));
+					set_property(i, _properties[i]);
 				}
 				else if (PyLong_Check(p))
 				{
 					_properties.push_back((int)PyLong_AsLong(p));
 					_properties[i] = ini.get_int(_module, std::to_string(i), std::get<int>(_properties[i]));
-					set("set_property", "ii", i, std::get<int>(_properties[i]));
+					set_property(i, _properties[i]);
 				}
 				else if (PyFloat_Check(p))
 				{
 					_properties.push_back((float)PyFloat_AsDouble(p));
 					_properties[i] = ini.get_float(_module, std::to_string(i), std::get<float>(_properties[i]));
-					set("set_property", "if", i, std::get<float>(_properties[i]));
+					set_property(i, _properties[i]);
 				}
 				else if (PyUnicode_Check(p))
 				{
 					_properties.push_back(std::string(PyUnicode_AsUTF8(p)));
 					_properties[i] = ini.get_string(_module, std::to_string(i), std::get<std::string>(_properties[i]));
-					set("set_property", "is", i, (std::get<std::string>(_properties[i])).c_str());
+					set_property(i, _properties[i]);
 				}
 				else if (PyList_Check(p))
 				{
@@ -142,7 +145,7 @@ bool CadScript::initialize(std::string module_path, std::string lang)
 
 					values[0] = ini.get_string(_module, std::to_string(i), values[0]);
 					_properties.push_back(values);
-					set("set_property", "is", i, (std::get<std::vector<std::string>>(_properties[i])[0]).c_str());
+					set_property(i, _properties[i]);
 				}
 				Py_DECREF(p);
 			}
@@ -189,6 +192,11 @@ void CadScript::finalize()
 	}
 	ini.write();
 
+	release();
+}
+
+void CadScript::release()
+{
 	if (_py_script_object != NULL) Py_CLEAR(_py_script_object);
 	if (_py_script_class != NULL) Py_CLEAR(_py_script_class);
 	if (_py_script_module != NULL) Py_CLEAR(_py_script_module);
@@ -196,12 +204,52 @@ void CadScript::finalize()
 	Script::finalize();
 }
 
-std::string CadScript::run(glm::vec2 mouse_pos)
+void CadScript::reset()
+{
+	// new objects of the loaded classes : the module is not imported and the properties are not read again
+	if (_py_script_object != NULL) Py_CLEAR(_py_script_object);
+	if (_py_core_object != NULL) Py_CLEAR(_py_core_object);
+
+	_py_core_object = PyObject_CallObject(_py_core_class, NULL);
+	_py_script_object = PyObject_CallObject(_py_script_class, NULL);
+	if (_py_core_object == NULL || _py_script_object == NULL)
+		throw std::runtime_error("Reset of script " + _module + " [" + Script::python_error() + "]");
+
+	set_cadscript();
+	set("set_language", "s", _lang.c_str());
+	for (int i = 0; i < _properties.size(); i++)
+		set_property(i, _properties[i]);
+}
+
+bool CadScript::open()
 {
-	initialize();
+	if (_py_script_object != NULL && _py_core_object != NULL && !modified())
+	{
+		try
+		{
+			reset();
+			return true;
+		}
+		catch (const std::exception& e)
+		{
+			Logger::error(e.what());
+		}
+	}
+
+	// first run, changed file or failed reset
+	return initialize();
+}
 
+std::string CadScript::run(glm::vec2 mouse_pos)
+{
 	std::string result;
 
+	if (!open())
+	{
+		Logger::error("Running script " + module() + " -> " + _error);
+		return result;
+	}
+
 	try
 	{
 		set("set_mouse", "ff", mouse_pos.x, mouse_pos.y);
@@ -212,7 +260,6 @@ std::string CadScript::run(glm::vec2 mouse_pos)
 		Logger::error("Running script " + module() + " -> " + std::string(e.what()));
 	}
 
-	finalize();
-
+	// the session stays loaded for the next run
 	return result;
 }
\ No newline at end of file
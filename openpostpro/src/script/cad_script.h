@@ -24,6 +24,22 @@ private:
 private:
 	void set_cadscript();
 
+	/// <summary>
+	/// Release the python objects, without saving the properties
+	/// </summary>
+	void release();
+
+	/// <summary>
+	/// Reset the per run state of a loaded session : new Cadcore and Cadscript python objects with the loaded properties
+	/// </summary>
+	void reset();
+
+	/// <summary>
+	/// Start a run : reset the loaded session, or load it when there is none or its file changed
+	/// </summary>
+	/// <returns>True if no errors</returns>
+	bool open();
+
 public:
 	std::string category() { return _category; }
 	std::string description() { return _description; }
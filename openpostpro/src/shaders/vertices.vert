@@ -9,10 +9,17 @@ layout(location = 1) in float in_aa;
 uniform mat4 projection;
 uniform mat4 modelview;
 
+// Instances are laid on a grid of instance_columns columns, instance_step apart
+uniform int instance_columns;
+uniform vec2 instance_step;
+
 out float f_aa;
 
 void main(){
+    int columns = max(instance_columns, 1);
+    vec2 vertex = in_vertex + vec2(gl_InstanceID % columns, gl_InstanceID / columns) * instance_step;
+
     // Output position of the vertex, in clip space : projection * position
-    gl_Position = projection * modelview * vec4(in_vertex.x, -in_vertex.y,0,1);
+    gl_Position = projection * modelview * vec4(vertex.x, -vertex.y,0,1);
 	f_aa = in_aa;
 }
\ No newline at end of file
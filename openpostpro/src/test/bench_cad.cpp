@@ -0,0 +1,898 @@
+#include "bench_cad.h"
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <optional>
+#include <glm/gtc/constants.hpp>
+#include <curve.h>
+#include <logger.h>
+#include <workers.h>
+#include <stats.h>
+#include <ladder.h>
+#include <boolean.h>
+#include <simd.h>
+#include <arena.h>
+#include <jobs.h>
+#include <offsetcache.h>
+#include <renderer_null.h>
+#include <follow.h>
+#include <pocket.h>
+#include <offset.h>
+#include <formatter.h>
+#include <filesystem>
+#include <atomic>
+
+static double elapsed_ms(std::chrono::high_resolution_clock::time_point t)
+{
+	return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(std::chrono::high_resolution_clock::now() - t).count();
+}
+
+/// <summary>
+/// Return a closed rectangular part of size w x h, located at x, y, with a comb of small notches on the top edge
+/// </summary>
+static Curve part(geometry::real x, geometry::real y, geometry::real w, geometry::real h, int notches, geometry::real notch)
+{
+	Curve c;
+	c.add(geometry::rvec2(x, y));
+	c.add(geometry::rvec2(x + w, y));
+	c.add(geometry::rvec2(x + w, y + h));
+	geometry::real step = w / (notches + 1);
+	for (int i = notches; i > 0; i--)
+	{
+		geometry::real nx = x + step * i;
+		c.add(geometry::rvec2(nx + notch, y + h));
+		c.add(geometry::rvec2(nx + notch, y + h - notch));
+		c.add(geometry::rvec2(nx - notch, y + h - notch));
+		c.add(geometry::rvec2(nx - notch, y + h));
+	}
+	c.add(geometry::rvec2(x, y + h));
+	c.close();
+	return c;
+}
+
+/// <summary>
+/// Return the number of self intersections of curve c, adjacent segments excluded
+/// </summary>
+static int self_intersections(Curve& c)
+{
+	int count = 0;
+	geometry::rvec2 result;
+	for (size_t i = 0; i + 1 < c.size(); i++)
+		for (size_t j = i + 2; j + 1 < c.size(); j++)
+		{
+			if (i == 0 && j == c.size() - 2)
+				continue;
+			if (c[i].type != SegmentType::Line || c[j].type != SegmentType::Line)
+				continue;
+			if (geometry::segment_segment_intersect(c[i].point, c[i + 1].point, c[j].point, c[j + 1].point, result))
+				count++;
+		}
+	return count;
+}
+
+void run_bench_precision()
+{
+#ifdef GEOMETRY_SINGLE_PRECISION
+	Logger::log("bench precision : float kernel");
+#else
+	Logger::log("bench precision : double kernel");
+#endif
+
+	// throughput, small parts
+	{
+		auto t = std::chrono::high_resolution_clock::now();
+		size_t count = 0;
+		for (int i = 0; i < 200; i++)
+		{
+			Curve c = part(0, 0, 200, 100, 20, 1);
+			for (auto& o : c.offset(-0.5f * (i % 10 + 1)))
+				count += o.size();
+		}
+		Logger::log("offset x200 (ms): " + std::to_string(elapsed_ms(t)) + " segments: " + std::to_string(count));
+
+		t = std::chrono::high_resolution_clock::now();
+		count = 0;
+		for (int i = 0; i < 200; i++)
+		{
+			Curve a = part(0, 0, 200, 100, 20, 1);
+			Curve b = part(50, 50, 200, 100, 20, 1);
+			for (auto& u : a.boolean_union(b))
+				count += u.size();
+			for (auto& s : a.boolean_substract(b))
+				count += s.size();
+		}
+		Logger::log("union/substract x200 (ms): " + std::to_string(elapsed_ms(t)) + " segments: " + std::to_string(count));
+	}
+
+	// robustness, 3 m part with 0.01 mm features located far from origin
+	for (geometry::real tolerance : { geometry::real(0.1), geometry::real(0.01) })
+	{
+		geometry::real w = 3000, h = 2000, d = 1;
+		Curve c = part(10000, 10000, w, h, 50, tolerance);
+		auto t = std::chrono::high_resolution_clock::now();
+		auto offsets = c.offset(-d);
+		double ms = elapsed_ms(t);
+
+		// reference area of the inside offset of the notched rectangle
+		geometry::real notches = 50 * (2 * tolerance + 2 * d) * tolerance;
+		geometry::real expected = (w - 2 * d) * (h - 2 * d) - notches;
+		int closed = 0, crossings = 0;
+		geometry::real area = 0;
+		for (auto& o : offsets)
+		{
+			closed += o.closed() ? 1 : 0;
+			crossings += self_intersections(o);
+			area += glm::abs(o.area());
+		}
+		Logger::log("tolerance " + std::to_string(tolerance) + " : " + std::to_string(ms) + " ms, curves " + std::to_string(offsets.size()) +
+			", closed " + std::to_string(closed) + ", self intersections " + std::to_string(crossings) +
+			", area error " + std::to_string(glm::abs(area - expected) / expected));
+	}
+}
+
+/// <summary>
+/// Return a closed star shaped curve of n line segments, with a noisy radius
+/// </summary>
+static Curve star(int n, geometry::real radius)
+{
+	Curve c;
+	for (int i = 0; i < n; i++)
+	{
+		geometry::real a = glm::two_pi<geometry::real>() * i / n;
+		geometry::real r = radius * (1 + geometry::real(0.05) * glm::sin(a * 97) + geometry::real(0.01) * ((i * 7919) % 13) / 13);
+		c.add(geometry::rvec2(r * glm::cos(a), r * glm::sin(a)));
+	}
+	c.close();
+	return c;
+}
+
+void run_bench_search()
+{
+	const int n = 100000;
+	Curve a = star(n, 1000);
+	Curve b = star(n, 1010);
+	a.reset_bounds();
+	b.reset_bounds();
+
+	// first search builds the index
+	auto t = std::chrono::high_resolution_clock::now();
+	std::vector<int> candidates;
+	a.search(a[0].bounds, std::back_inserter(candidates));
+	Logger::log("search index build, " + std::to_string(a.size()) + " segments (ms): " + std::to_string(elapsed_ms(t)));
+
+	// one search per segment, visitor and output iterator
+	t = std::chrono::high_resolution_clock::now();
+	size_t found = 0;
+	for (auto& s : a)
+		a.visit(s.bounds, [&found](int) { found++; return true; });
+	Logger::log("search visitor x" + std::to_string(a.size()) + " (ms): " + std::to_string(elapsed_ms(t)) + " candidates: " + std::to_string(found));
+
+	t = std::chrono::high_resolution_clock::now();
+	found = 0;
+	for (auto& s : a)
+	{
+		candidates.clear();
+		a.search(s.bounds, std::back_inserter(candidates));
+		found += candidates.size();
+	}
+	Logger::log("search output iterator x" + std::to_string(a.size()) + " (ms): " + std::to_string(elapsed_ms(t)) + " candidates: " + std::to_string(found));
+
+	// check against a linear scan on a sample
+	size_t missing = 0;
+	for (size_t i = 0; i < a.size(); i += 997)
+	{
+		candidates.clear();
+		a.search(a[i].bounds, std::back_inserter(candidates));
+		for (size_t j = 0; j < a.size(); j++)
+		{
+			geometry::rectangle& r = a[j].bounds;
+			if ((r.contains(a[i].bounds) || r.intersect(a[i].bounds) || a[i].bounds.contains(r)) && std::find(candidates.begin(), candidates.end(), (int)j) == candidates.end())
+				missing++;
+		}
+	}
+	if (missing > 0)
+		Logger::error("search missed " + std::to_string(missing) + " segments");
+
+	// algorithms using the index
+	t = std::chrono::high_resolution_clock::now();
+	bool crossing = a.curve_intersect(b);
+	Logger::log("curve_intersect (ms): " + std::to_string(elapsed_ms(t)) + " result: " + std::to_string(crossing));
+
+	t = std::chrono::high_resolution_clock::now();
+	auto parts = a.split_at_intersections();
+	Logger::log("split_at_intersections (ms): " + std::to_string(elapsed_ms(t)) + " curves: " + std::to_string(parts.size()));
+}
+
+/// <summary>
+/// Return a closed looping curve of n segments (epitrochoid), with arcs every fourth segment
+/// </summary>
+static Curve loops(int n, int lobes)
+{
+	Curve c;
+	geometry::rvec2 previous;
+	for (int i = 0; i < n; i++)
+	{
+		geometry::real a = glm::two_pi<geometry::real>() * i / n;
+		geometry::rvec2 p = geometry::real(100) * geometry::rvec2(glm::cos(a), glm::sin(a)) + geometry::real(60) * geometry::rvec2(glm::cos(a * lobes), glm::sin(a * lobes));
+		if (i % 4 == 3)
+		{
+			// small arc bulging on the left of [previous, p]
+			geometry::rvec2 m = (previous + p) / geometry::real(2);
+			geometry::rvec2 normal = geometry::rvec2(previous.y - p.y, p.x - previous.x);
+			geometry::rvec2 center = m - normal;
+			c.back().type = SegmentType::Arc;
+			c.back().center = center;
+			c.back().radius = glm::distance(center, previous);
+			c.back().cw = false;
+		}
+		c.add(p);
+		previous = p;
+	}
+	c.close();
+	c.reset_bounds();
+	return c;
+}
+
+void run_bench_split()
+{
+	for (int n : { 1000, 10000, 100000 })
+	{
+		Curve c = loops(n, 23);
+
+		auto t = std::chrono::high_resolution_clock::now();
+		auto indexed = c.split_at_intersections(false);
+		double indexed_ms = elapsed_ms(t);
+		size_t indexed_segments = 0;
+		for (auto& r : indexed)
+			indexed_segments += r.size();
+
+		t = std::chrono::high_resolution_clock::now();
+		auto swept = c.split_at_intersections(true);
+		double swept_ms = elapsed_ms(t);
+		size_t swept_segments = 0;
+		for (auto& r : swept)
+			swept_segments += r.size();
+
+		Logger::log("split " + std::to_string(n) + " segments, index (ms): " + std::to_string(indexed_ms) + " sweep (ms): " + std::to_string(swept_ms) +
+			", curves " + std::to_string(indexed.size()) + "/" + std::to_string(swept.size()) +
+			", segments " + std::to_string(indexed_segments) + "/" + std::to_string(swept_segments));
+		if (indexed.size() != swept.size() || indexed_segments != swept_segments)
+			Logger::error("split results differ");
+	}
+}
+
+void run_bench_parallel()
+{
+	std::vector<Curve> nest;
+	for (int i = 0; i < 400; i++)
+		nest.push_back(part(geometry::real(i % 20) * 220, geometry::real(i / 20) * 120, 200, 100, 20, 1));
+
+	Stats::Counters stats;
+	auto t = std::chrono::high_resolution_clock::now();
+	std::vector<std::vector<Curve>> sequential;
+	{
+		Stats::Scope scope(stats);
+		for (Curve& c : nest)
+			sequential.push_back(c.offset(-3));
+	}
+	double sequential_ms = elapsed_ms(t);
+
+	t = std::chrono::high_resolution_clock::now();
+	auto parallel = Workers::map(nest, [](Curve& c) { return c.offset(-3); });
+	double parallel_ms = elapsed_ms(t);
+
+	size_t differences = 0;
+	for (size_t i = 0; i < nest.size(); i++)
+	{
+		if (sequential[i].size() != parallel[i].size())
+			differences++;
+		else
+			for (size_t j = 0; j < sequential[i].size(); j++)
+				if (sequential[i][j].size() != parallel[i][j].size())
+					differences++;
+	}
+
+	Logger::log("offset 400 parts, sequential (ms): " + std::to_string(sequential_ms) + " workers (ms): " + std::to_string(parallel_ms) +
+		" threads: " + std::to_string(Workers::size() + 1));
+	if (differences > 0)
+		Logger::error("parallel offset differs on " + std::to_string(differences) + " parts");
+	if (Stats::enabled)
+		Logger::log("offset 400 parts " + stats.str());
+}
+
+/// <summary>
+/// Return a closed square island of size w located at x, y
+/// </summary>
+static Curve island(geometry::real x, geometry::real y, geometry::real w)
+{
+	Curve c;
+	c.add(geometry::rvec2(x, y));
+	c.add(geometry::rvec2(x + w, y));
+	c.add(geometry::rvec2(x + w, y + w));
+	c.add(geometry::rvec2(x, y + w));
+	c.close();
+	return c;
+}
+
+void run_bench_ladder()
+{
+	std::vector<Curve> curves;
+	curves.push_back(part(0, 0, 200, 100, 20, 1));
+	curves.push_back(island(20, 20, 30));
+	curves.push_back(island(90, 35, 30));
+	curves.push_back(island(160, 30, 20));
+	for (int i = 0; i < curves.size(); i++)
+		curves[i].tag(i);
+
+	// same preparation as a pocket : levels, alternate directions, offset by the radius
+	TreeCurve tree(curves);
+	tree.nest();
+	tree.cw_alter(true);
+
+	for (geometry::real step : { 5.0, 1.0, 0.5 })
+	{
+		std::vector<Curve> region;
+		for (TreeCurve* t : tree.children)
+		{
+			bool cw = t->curve->cw();
+			for (Curve& c : t->curves())
+			{
+				auto offsets = c.offset(c.cw() == cw ? -step : step);
+				region.insert(region.end(), offsets.begin(), offsets.end());
+			}
+		}
+		region = OffsetLadder::merge(region);
+
+		auto t = std::chrono::high_resolution_clock::now();
+		std::vector<Curve> ring;
+		for (Curve& c : region)
+		{
+			auto offsets = c.offset(c.level() == region.front().level() ? -step : step);
+			ring.insert(ring.end(), offsets.begin(), offsets.end());
+		}
+		ring = OffsetLadder::merge(ring);
+		double ring_ms = elapsed_ms(t);
+
+		t = std::chrono::high_resolution_clock::now();
+		OffsetLadder ladder(region);
+		auto rings = ladder.rings(step);
+		double ladder_ms = elapsed_ms(t);
+
+		size_t segments = 0;
+		for (Curve& c : rings)
+			segments += c.size();
+
+		Logger::log("ladder step " + std::to_string(step) + " : one ring (ms): " + std::to_string(ring_ms) + " all rings (ms): " + std::to_string(ladder_ms) +
+			", curves " + std::to_string(rings.size()) + ", segments " + std::to_string(segments) + ", threads: " + std::to_string(Workers::size() + 1));
+	}
+}
+
+/// <summary>
+/// Return a closed circle of radius r centered on x, y, made of two half arcs
+/// </summary>
+static Curve disc(geometry::real x, geometry::real y, geometry::real r)
+{
+	Curve c;
+	c.add(SegmentType::Arc, geometry::rvec2(x + r, y), geometry::rvec2(x, y), r, false);
+	c.add(SegmentType::Arc, geometry::rvec2(x - r, y), geometry::rvec2(x, y), r, false);
+	c.close();
+	return c;
+}
+
+void run_bench_boolean()
+{
+	for (int n : { 10, 50, 200 })
+	{
+		// a chain of overlapping squares and discs, united in a single curve
+		std::vector<Curve> curves;
+		for (int i = 0; i < n; i++)
+			curves.push_back(i % 2 ? disc(i * 7.0 + 5, 5 + (i % 3), 5) : island(i * 7.0, (geometry::real)(i % 3), 10));
+
+		auto t = std::chrono::high_resolution_clock::now();
+		std::vector<Curve> pairwise;
+		Curve merged = curves[0];
+		for (int i = 1; i < n; i++)
+		{
+			Curve c = curves[i];
+			auto united = merged.boolean_union(c);
+			if (united.size() == 0)
+				break;
+			merged = united[0];
+			merged.close();
+		}
+		pairwise.push_back(merged);
+		double pairwise_ms = elapsed_ms(t);
+
+		t = std::chrono::high_resolution_clock::now();
+		auto nary = CurveBoolean::unite(curves, false);
+		double nary_ms = elapsed_ms(t);
+
+		size_t segments = 0;
+		for (Curve& c : nary)
+			segments += c.size();
+
+		Logger::log("boolean union of " + std::to_string(n) + " curves : pairwise (ms): " + std::to_string(pairwise_ms) + " n-ary (ms): " + std::to_string(nary_ms) +
+			", pairwise segments " + std::to_string(merged.size()) + ", n-ary curves " + std::to_string(nary.size()) + ", segments " + std::to_string(segments));
+	}
+}
+
+void run_bench_kernels()
+{
+	const int n = 100000;
+	Curve looping = loops(n, 23);
+	Curve a = star(n, 1000);
+
+	// two regular polygons 10 apart, too_close has to test every candidate
+	Curve inner, outer;
+	for (int i = 0; i < n; i++)
+	{
+		geometry::real angle = glm::two_pi<geometry::real>() * i / n;
+		inner.add(geometry::real(1000) * geometry::rvec2(glm::cos(angle), glm::sin(angle)));
+		outer.add(geometry::real(1010) * geometry::rvec2(glm::cos(angle), glm::sin(angle)));
+	}
+	inner.close();
+	outer.close();
+	const geometry::real o = geometry::real(10.1);
+
+	std::vector<geometry::rvec2> queries;
+	for (int i = 0; i < 32; i++)
+		for (int j = 0; j < 32; j++)
+			queries.push_back(geometry::rvec2(-1100 + i * 71.0, -1100 + j * 71.0));
+
+	// arrays views are built by a first call, the slab index of inside by a second one
+	looping.split_at_intersections();
+	inner.too_close(outer, o);
+	a.inside(queries[0]);
+	a.inside(queries[0]);
+
+	Simd::Level supported = Simd::supported();
+	size_t reference_curves = 0, reference_inside = 0;
+	bool reference_close = false;
+	for (int l = (int)Simd::Level::scalar; l <= (int)supported; l++)
+	{
+		Simd::Level level = (Simd::Level)l;
+		Simd::level(level);
+
+		auto t = std::chrono::high_resolution_clock::now();
+		auto parts = looping.split_at_intersections();
+		double split_ms = elapsed_ms(t);
+
+		t = std::chrono::high_resolution_clock::now();
+		bool close = inner.too_close(outer, o);
+		double close_ms = elapsed_ms(t);
+
+		t = std::chrono::high_resolution_clock::now();
+		size_t inside = 0;
+		for (auto& p : queries)
+			inside += a.inside(p);
+		double inside_ms = elapsed_ms(t);
+
+		// segments per second
+		auto rate = [](double segments, double ms) { return std::to_string((long long)(segments / ms * 1000)); };
+		Logger::log(std::string("kernels ") + Simd::name(level) + " : split " + rate(n, split_ms) + " segments/s, too_close " + rate(n, close_ms) +
+			" segments/s, inside " + rate((double)n * queries.size(), inside_ms) + " segments/s");
+
+		if (level == Simd::Level::scalar)
+		{
+			reference_curves = parts.size();
+			reference_close = close;
+			reference_inside = inside;
+		}
+		else if (parts.size() != reference_curves || close != reference_close || inside != reference_inside)
+			Logger::error(std::string("kernels ") + Simd::name(level) + " results differ from scalar");
+	}
+
+	Simd::level(supported);
+}
+
+/// <summary>
+/// Return the hierarchy of tree t as text, each curve is written with its tag then its children between brackets
+/// </summary>
+static std::string hierarchy(TreeCurve* t)
+{
+	std::string text;
+	for (TreeCurve* c : t->children)
+		text += std::to_string(c->curve->tag()) + (c->children.size() > 0 ? "(" + hierarchy(c) + ")" : "") + " ";
+	return text;
+}
+
+void run_bench_tree()
+{
+	// a sheet outline around a grid of parts, each part with 4 holes and an island in the first hole
+	const int grid = 40;
+	std::vector<Curve> curves;
+	curves.push_back(star(20000, 1000));
+	for (int i = 0; i < grid; i++)
+		for (int j = 0; j < grid; j++)
+		{
+			geometry::real x = -600 + i * 30.0, y = -600 + j * 30.0;
+			Curve c;
+			for (int k = 0; k < 32; k++)
+			{
+				geometry::real a = glm::two_pi<geometry::real>() * k / 32;
+				c.add(geometry::rvec2(x + 12 * glm::cos(a), y + 12 * glm::sin(a)));
+			}
+			c.close();
+			curves.push_back(c);
+			curves.push_back(island(x - 7, y - 7, 4));
+			curves.push_back(island(x - 6, y - 6, 2));
+			curves.push_back(island(x + 3, y - 7, 4));
+			curves.push_back(island(x - 7, y + 3, 4));
+			curves.push_back(island(x + 3, y + 3, 4));
+		}
+	for (int i = 0; i < curves.size(); i++)
+		curves[i].tag(i);
+
+	// pairwise sort against the spatial index
+	auto t = std::chrono::high_resolution_clock::now();
+	TreeCurve sorted(curves);
+	sorted.sort();
+	double sort_ms = elapsed_ms(t);
+
+	t = std::chrono::high_resolution_clock::now();
+	TreeCurve tree(curves);
+	tree.nest();
+	double nest_ms = elapsed_ms(t);
+
+	bool nested = tree.children.size() == 1 && tree.children[0]->children.size() == grid * grid;
+	for (size_t i = 0; nested && i < tree.children[0]->children.size(); i++)
+		nested = tree.children[0]->children[i]->children.size() == 4;
+	if (!nested)
+		Logger::error("tree nesting is wrong");
+	if (hierarchy(&tree) != hierarchy(&sorted))
+		Logger::error("tree nest and sort hierarchies differ");
+
+	// many points against the sheet, the first query builds the outline and the second one the slab index
+	Curve& sheet = curves[0];
+	sheet.inside(geometry::rvec2());
+	t = std::chrono::high_resolution_clock::now();
+	size_t inside = 0;
+	for (int i = 0; i < 1000; i++)
+		for (int j = 0; j < 1000; j++)
+			inside += sheet.inside(geometry::rvec2(-1100 + i * 2.2, -1100 + j * 2.2));
+	double inside_ms = elapsed_ms(t);
+
+	Logger::log("tree of " + std::to_string(curves.size()) + " curves, sort (ms): " + std::to_string(sort_ms) + " nest (ms): " + std::to_string(nest_ms) + ", inside x1000000 on " + std::to_string(sheet.size()) +
+		" segments (ms): " + std::to_string(inside_ms) + ", inside " + std::to_string(inside));
+}
+
+void run_bench_simplify()
+{
+	// dense polylines like the ones of splines, ellipses and texts
+	const int n = 100000;
+	std::vector<Curve> curves(3);
+	for (int i = 0; i <= n; i++)
+	{
+		geometry::real a = glm::two_pi<geometry::real>() * i / n;
+		curves[0].add(geometry::rvec2(100 * glm::cos(a), 60 * glm::sin(a)));
+		curves[1].add(geometry::rvec2(a * 50, 20 * glm::sin(3 * a)));
+		geometry::real r = 50 + 10 * glm::cos(5 * a);
+		curves[2].add(geometry::rvec2(r * glm::cos(a), r * glm::sin(a)));
+	}
+
+	for (Curve& c : curves)
+	{
+		Curve reduced = c;
+		auto t = std::chrono::high_resolution_clock::now();
+		reduced.reduce(0.25);
+		double reduce_ms = elapsed_ms(t);
+
+		Curve simplified = c;
+		t = std::chrono::high_resolution_clock::now();
+		simplified.simplify(geometry::ERR_FLOAT2);
+		double simplify_ms = elapsed_ms(t);
+
+		size_t arcs = 0;
+		for (Segment& s : simplified)
+			arcs += s.type == SegmentType::Arc;
+
+		Logger::log("simplify " + std::to_string(c.size()) + " segments : reduce (ms): " + std::to_string(reduce_ms) + " segments " + std::to_string(reduced.size()) +
+			", simplify (ms): " + std::to_string(simplify_ms) + " segments " + std::to_string(simplified.size()) + " arcs " + std::to_string(arcs));
+	}
+}
+
+void run_bench_arena()
+{
+	std::vector<Curve> nest;
+	for (int i = 0; i < 100; i++)
+		nest.push_back(part(geometry::real(i % 10) * 220, geometry::real(i / 10) * 120, 200, 100, 20, 1));
+
+	// same work as a pocket on each part : a few rings, heap first then arena
+	for (bool arena : { false, true })
+	{
+		Stats::Counters stats;
+		size_t curves = 0;
+		auto t = std::chrono::high_resolution_clock::now();
+		{
+			Stats::Scope scope(stats);
+			for (Curve& c : nest)
+			{
+				std::optional<Arena::Scope> memory;
+				if (arena)
+					memory.emplace();
+				for (geometry::real o : { -3.0, -6.0, -9.0, -12.0 })
+					curves += c.offset(o).size();
+			}
+		}
+		double ms = elapsed_ms(t);
+
+		Logger::log(std::string("offset 100 parts x4, ") + (arena ? "arena" : "heap") + " (ms): " + std::to_string(ms) + ", curves " + std::to_string(curves) +
+			(Stats::enabled ? ", allocations " + std::to_string(stats.value[Stats::allocations]) : ""));
+	}
+}
+
+void run_bench_copies()
+{
+	std::vector<Curve> curves;
+	for (int i = 0; i < 16; i++)
+	{
+		geometry::real x = geometry::real(i % 4) * 220, y = geometry::real(i / 4) * 120;
+		curves.push_back(part(x, y, 200, 100, 20, 1));
+		curves.push_back(island(x + 20, y + 20, 30));
+		curves.push_back(island(x + 90, y + 35, 30));
+		curves.push_back(island(x + 160, y + 30, 20));
+	}
+
+	TreeCurve tree(curves);
+	tree.nest();
+	tree.cw_alter(true);
+
+	// like Pocket::process, one part per task
+	Stats::Counters stats;
+	auto t = std::chrono::high_resolution_clock::now();
+	auto pockets = Workers::map(tree.children, [&stats](TreeCurve* c) {
+		Stats::Scope scope(stats);
+		Arena::Scope arena;
+		return Pocket::pocket(c, 1, 0.5);
+		});
+	double ms = elapsed_ms(t);
+
+	size_t count = 0;
+	for (auto& p : pockets)
+		count += p.size();
+
+	std::string line = "pocket " + std::to_string(pockets.size()) + " parts (ms): " + std::to_string(ms) + ", curves " + std::to_string(count);
+	if (Stats::enabled)
+		line += ", per pocket copies " + std::to_string(stats.value[Stats::copies] / pockets.size()) +
+			" allocations " + std::to_string(stats.value[Stats::allocations] / pockets.size());
+	Logger::log(line);
+}
+
+void run_bench_jobs()
+{
+	std::vector<Curve> parts;
+	for (int i = 0; i < 10; i++)
+		parts.push_back(part(geometry::real(i) * 220, 0, 200, 100, 20, 1));
+
+	// parts are shared by the jobs
+	for (Curve& c : parts)
+		c.prepare();
+
+	// 30 toolpaths, a slider dragged over 20 frames changes the radius of all of them every frame
+	const int toolpaths = 30, frames = 20;
+
+	auto t = std::chrono::high_resolution_clock::now();
+	size_t curves = 0;
+	for (int f = 0; f < frames; f++)
+		for (int k = 0; k < toolpaths; k++)
+			for (Curve& c : parts)
+				curves += c.offset(-1 - f * 0.1).size();
+	double sync_ms = elapsed_ms(t);
+
+	// same changes posted as background jobs, like Toolpath::compute then publish : a job gives up once a newer radius is waiting
+	struct Job
+	{
+		std::atomic<int> generation = 0;
+		std::atomic<int> done = 0;
+		std::atomic<int> published = -1;
+	};
+	std::vector<Job> jobs(toolpaths);
+	std::atomic<size_t> runs = 0;
+
+	t = std::chrono::high_resolution_clock::now();
+	for (int f = 0; f < frames; f++)
+	{
+		for (Job& j : jobs)
+		{
+			int g = ++j.generation;
+			Jobs::post(&j, [&j, &parts, &runs, g, f] {
+				runs++;
+				for (Curve& c : parts)
+				{
+					if (j.generation != g)
+						return;
+					c.offset(-1 - f * 0.1);
+				}
+				j.published = g;
+				});
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(16));
+	}
+	for (Job& j : jobs)
+		Jobs::wait(&j);
+	double jobs_ms = elapsed_ms(t);
+
+	int current = 0;
+	for (Job& j : jobs)
+		current += j.published == j.generation ? 1 : 0;
+
+	Logger::log("radius drag " + std::to_string(toolpaths) + " toolpaths x " + std::to_string(frames) + " frames, synchronous (ms): " + std::to_string(sync_ms) +
+		", jobs (ms, 16 ms frames): " + std::to_string(jobs_ms) + ", jobs run " + std::to_string(runs) + "/" + std::to_string(toolpaths * frames) +
+		", current results " + std::to_string(current) + "/" + std::to_string(toolpaths));
+}
+
+/// <summary>
+/// Return closed curve c starting at its segment k
+/// </summary>
+static Curve restarted(Curve& c, size_t k)
+{
+	Curve result;
+	size_t count = c.size() - 1;
+	for (size_t n = 0; n < count; n++)
+		result.add(c[(k + n) % count]);
+	result.close();
+	return result;
+}
+
+void run_bench_cache()
+{
+	// a nest of the same part, translated and starting at another corner
+	// (the offset of this part is lost when it starts at the bottom of a notch)
+	std::vector<Curve> nest;
+	for (int i = 0; i < 40; i++)
+	{
+		Curve c = part(geometry::real(i % 8) * 220, geometry::real(i / 8) * 120, 200, 100, 20, 1);
+		nest.push_back(restarted(c, (size_t)i * 4 % (c.size() - 1)));
+	}
+	const geometry::real radii[] = { -1, -2, -3 };
+
+	auto run = [&nest, &radii](geometry::real& area) {
+		auto t = std::chrono::high_resolution_clock::now();
+		area = 0;
+		for (Curve& c : nest)
+			for (geometry::real r : radii)
+				for (Curve& o : c.offset(r))
+					area += o.area();
+		return elapsed_ms(t);
+	};
+
+	geometry::real uncached_area, first_area, second_area, loaded_area;
+	OffsetCache::capacity(0);
+	double uncached_ms = run(uncached_area);
+
+	OffsetCache::capacity(64 * 1024 * 1024);
+	double first_ms = run(first_area);
+	double second_ms = run(second_area);
+	Logger::log(OffsetCache::str());
+
+	// reopening the project
+	std::string path = (std::filesystem::temp_directory_path() / "bench.offsets").string();
+	OffsetCache::save(path);
+	OffsetCache::capacity(0);
+	OffsetCache::capacity(64 * 1024 * 1024);
+	OffsetCache::load(path);
+	double loaded_ms = run(loaded_area);
+	std::filesystem::remove(path);
+	Logger::log(OffsetCache::str());
+	OffsetCache::capacity(0);
+
+	Logger::log("offset " + std::to_string(nest.size()) + " parts x 3 radii, uncached (ms): " + std::to_string(uncached_ms) +
+		", first pass (ms): " + std::to_string(first_ms) + ", second pass (ms): " + std::to_string(second_ms) + ", after load (ms): " + std::to_string(loaded_ms) +
+		", area " + std::to_string(uncached_area) + " / " + std::to_string(first_area) + " / " + std::to_string(second_area) + " / " + std::to_string(loaded_area));
+}
+
+void run_bench_render()
+{
+	// toolpaths of a nest, outside offsets of parts and follows of discs, without graphic device
+	NullRenderer renderer;
+	std::vector<Toolpath*> toolpaths;
+	for (int i = 0; i < 100; i++)
+	{
+		geometry::real x = geometry::real(i % 10) * 220, y = geometry::real(i / 10) * 120;
+
+		Offset* o = new Offset(&renderer);
+		o->interior(false);
+		o->radius(3);
+		o->add(part(x, y, 200, 100, 10, 2));
+		toolpaths.push_back(o);
+
+		Follow* f = new Follow(&renderer);
+		f->add(disc(x + 100, y + 50, 30));
+		toolpaths.push_back(f);
+	}
+
+	// the scale of the camera sets the tessellation of the arcs, as a zoom does
+	for (float scale : { 1.0f, 10.0f, 100.0f })
+	{
+		renderer.scale(scale);
+
+		auto t = std::chrono::high_resolution_clock::now();
+		for (Toolpath* tp : toolpaths)
+			tp->compute();
+		Toolpath::process(toolpaths);
+		for (Toolpath* tp : toolpaths)
+			tp->wait();
+		double compute_ms = elapsed_ms(t);
+
+		// offsets are published by wait, the draw generates the render data of the others
+		renderer.reset_counters();
+		t = std::chrono::high_resolution_clock::now();
+		for (Toolpath* tp : toolpaths)
+			tp->draw();
+		double tessellation_ms = elapsed_ms(t);
+
+		auto c = renderer.counters();
+		Logger::log("render " + std::to_string(toolpaths.size()) + " toolpaths, scale " + std::to_string(scale) +
+			", compute (ms): " + std::to_string(compute_ms) + ", tessellation (ms): " + std::to_string(tessellation_ms) +
+			", vertices: " + std::to_string(c.vertices) + ", uploaded (KB): " + std::to_string(c.bytes / 1024) + ", draws: " + std::to_string(c.draws));
+	}
+
+	for (Toolpath* tp : toolpaths)
+		delete tp;
+	Logger::log(renderer.str());
+}
+
+
+void run_bench_formatter()
+{
+	// an engraving pass : lines and arcs around a circle with feed changes
+	std::vector<Move> moves;
+	for (int i = 0; i < 200000; i++)
+	{
+		Move m;
+		double a = i * 0.001;
+		m.type = (double)(i % 100 == 0 ? MoveType::Feed : i % 3 == 0 ? MoveType::CounterClockwise : MoveType::Linear);
+		if ((MoveType)(int)m.type == MoveType::Feed)
+		{
+			m.values[0] = 1000 + (i / 100) % 2 * 500;
+			moves.push_back(m);
+			continue;
+		}
+		m.mask = (MoveType)(int)m.type == MoveType::Linear ? 3 : 27;
+		m.values[0] = 100 + 50 * std::cos(a);
+		m.values[1] = 100 + 50 * std::sin(a);
+		m.values[3] = -0.05 * std::cos(a);
+		m.values[4] = -0.05 * std::sin(a);
+		moves.push_back(m);
+	}
+
+	for (bool condensed : { true, false })
+	{
+		Formatter::Description d;
+		d.space = condensed ? "" : " ";
+		d.increment = condensed ? -1 : 5;
+		if (condensed)
+			d.modal = { "G0", "G1", "G2", "G3" };
+		Formatter formatter(d);
+
+		Formatter::State state;
+		std::string output;
+		auto t = std::chrono::high_resolution_clock::now();
+		formatter.format(moves.data(), moves.size(), state, output);
+		double ms = elapsed_ms(t);
+
+		Logger::log(std::string("formatter ") + (condensed ? "condensed" : "spaced, numbered") + ", " + std::to_string(moves.size()) + " moves (ms): " + std::to_string(ms) +
+			", lines: " + std::to_string(state.count) + ", size (KB): " + std::to_string(output.size() / 1024));
+	}
+}
+
+void run_benches()
+{
+	run_bench_precision();
+	run_bench_search();
+	run_bench_split();
+	run_bench_parallel();
+	run_bench_ladder();
+	run_bench_boolean();
+	run_bench_kernels();
+	run_bench_tree();
+	run_bench_simplify();
+	run_bench_arena();
+	run_bench_copies();
+	run_bench_jobs();
+	run_bench_cache();
+	run_bench_render();
+	run_bench_formatter();
+}
\ No newline at end of file
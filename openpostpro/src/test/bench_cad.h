@@ -0,0 +1,88 @@
+#pragma once
+
+/************************************************************************
+* Benchmarks of the curve kernels, the pocket pipeline, the background
+* jobs, the rendering and the post-processor output. They are run by
+* openpostpro --bench after the checks, results are written to the log
+* file
+*************************************************************************/
+
+/// <summary>
+/// Run all the benchmarks
+/// </summary>
+void run_benches();
+
+/// <summary>
+/// Curve kernel benchmarks
+/// </summary>
+void run_bench_precision();
+
+/// <summary>
+/// Segment spatial index benchmark on 100k segment curves
+/// </summary>
+void run_bench_search();
+
+/// <summary>
+/// Self intersection benchmark, sweep-line against spatial index, on growing curves
+/// </summary>
+void run_bench_split();
+
+/// <summary>
+/// Offset of a 400 parts nest, sequential against worker pool
+/// </summary>
+void run_bench_parallel();
+
+/// <summary>
+/// Pocket rings of a part with islands, offset ladder against a single ring
+/// </summary>
+void run_bench_ladder();
+
+/// <summary>
+/// Union of a chain of overlapping squares and discs, pairwise Weiler merges against the n-ary boolean
+/// </summary>
+void run_bench_boolean();
+
+/// <summary>
+/// Batch kernels of the curve arrays view at each instruction set level, in segments per second
+/// </summary>
+void run_bench_kernels();
+
+/// <summary>
+/// Part and hole tree of a sheet with a grid of parts, pairwise sort against nest, and inside queries with the slab index
+/// </summary>
+void run_bench_tree();
+
+/// <summary>
+/// Dense polylines, linear reduce against line and arc fitting simplify
+/// </summary>
+void run_bench_simplify();
+
+/// <summary>
+/// Offsets of a nest with the geometry temporaries on the heap then in the arena
+/// </summary>
+void run_bench_arena();
+
+/// <summary>
+/// Pockets of a nest on the worker pool, with the curve copies and heap allocations per pocket
+/// </summary>
+void run_bench_copies();
+
+/// <summary>
+/// Parameter changes of many toolpaths over several frames, computed at once then as coalesced background jobs
+/// </summary>
+void run_bench_jobs();
+
+/// <summary>
+/// Offsets of a nest of the same part, without the offset cache, with it, then after saving and loading it
+/// </summary>
+void run_bench_cache();
+
+/// <summary>
+/// Toolpaths of a nest computed and drawn with the null renderer at several camera scales, tessellation time and vertices uploaded
+/// </summary>
+void run_bench_render();
+
+/// <summary>
+/// Moves of a 200k segments engraving formatted by the native G-code formatter, condensed then spaced with line numbers
+/// </summary>
+void run_bench_formatter();
\ No newline at end of file
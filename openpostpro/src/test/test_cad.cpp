@@ -9,6 +9,21 @@
 #include <ellipse.h>
 #include <font.h>
 #include <text.h>
+#include "bench_cad.h"
+#include <curve.h>
+#include <boolean.h>
+#include <ladder.h>
+#include <simd.h>
+#include <logger.h>
+#include <lang.h>
+#include <strings.h>
+#include <postpro.h>
+#include <renderer_null.h>
+#include <follow.h>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <cstdlib>
 
 void run_test(Document* document)
 {
@@ -73,4 +88,343 @@ void run_test(Document* document)
 	//text->ref_point(glm::vec2(100.0f, 100.0f));
 	//text->set("Thomas G", "verdana", false, true, 100.0f);
 	//document->layers()[0]->shapes().push_back(text);
+}
+
+static bool report(std::string name, bool ok, std::string detail)
+{
+	std::string line = "check " + name + " : " + (ok ? "ok" : "FAILED") + (detail.empty() ? "" : ", " + detail);
+	if (ok)
+	{
+		std::cout << line << std::endl;
+		Logger::log(line);
+	}
+	else
+	{
+		std::cerr << line << std::endl;
+		Logger::error(line);
+	}
+	return ok;
+}
+
+static double area(std::vector<Curve>& curves)
+{
+	double result = 0;
+	for (Curve& c : curves)
+		result += glm::abs((double)c.area());
+	return result;
+}
+
+static bool equal(double value, double expected)
+{
+	return glm::abs(value - expected) <= 1e-4 * glm::max(1.0, glm::abs(expected));
+}
+
+/// <summary>
+/// Return a closed square of size w located at x, y, counter clockwise or clockwise
+/// </summary>
+static Curve square(geometry::real x, geometry::real y, geometry::real w, bool cw = false)
+{
+	Curve c;
+	c.add(geometry::rvec2(x, y));
+	c.add(cw ? geometry::rvec2(x, y + w) : geometry::rvec2(x + w, y));
+	c.add(geometry::rvec2(x + w, y + w));
+	c.add(cw ? geometry::rvec2(x + w, y) : geometry::rvec2(x, y + w));
+	c.close();
+	return c;
+}
+
+/// <summary>
+/// Return a closed circle of radius r centered on x, y, made of two half arcs
+/// </summary>
+static Curve disc(geometry::real x, geometry::real y, geometry::real r)
+{
+	Curve c;
+	c.add(SegmentType::Arc, geometry::rvec2(x + r, y), geometry::rvec2(x, y), r, false);
+	c.add(SegmentType::Arc, geometry::rvec2(x - r, y), geometry::rvec2(x, y), r, false);
+	c.close();
+	return c;
+}
+
+/// <summary>
+/// Return a closed regular polygon of n segments
+/// </summary>
+static Curve polygon(int n, geometry::real radius)
+{
+	Curve c;
+	for (int i = 0; i < n; i++)
+	{
+		geometry::real a = glm::two_pi<geometry::real>() * i / n;
+		c.add(radius * geometry::rvec2(glm::cos(a), glm::sin(a)));
+	}
+	c.close();
+	return c;
+}
+
+static bool check_kernels()
+{
+	// a looping curve for the self intersections, a star for inside, two polygons 10 apart for too_close
+	const int n = 20000;
+	Curve looping, star;
+	for (int i = 0; i < n; i++)
+	{
+		geometry::real a = glm::two_pi<geometry::real>() * i / n;
+		looping.add(geometry::real(100) * geometry::rvec2(glm::cos(a), glm::sin(a)) + geometry::real(60) * geometry::rvec2(glm::cos(a * 23), glm::sin(a * 23)));
+		star.add(geometry::real(1000) * (1 + geometry::real(0.05) * glm::sin(a * 97)) * geometry::rvec2(glm::cos(a), glm::sin(a)));
+	}
+	looping.close();
+	star.close();
+	Curve inner = polygon(n, 1000), outer = polygon(n, 1010);
+
+	std::vector<geometry::rvec2> queries;
+	for (int i = 0; i < 32; i++)
+		for (int j = 0; j < 32; j++)
+			queries.push_back(geometry::rvec2(-1100 + i * 71.0, -1100 + j * 71.0));
+
+	// each level gives the results of the scalar kernels
+	bool ok = true;
+	Simd::Level supported = Simd::supported();
+	size_t reference_parts = 0, reference_inside = 0;
+	double reference_area = 0;
+	for (int l = (int)Simd::Level::scalar; l <= (int)supported; l++)
+	{
+		Simd::Level level = (Simd::Level)l;
+		Simd::level(level);
+
+		auto parts = looping.split_at_intersections();
+		double parts_area = area(parts);
+		bool close = inner.too_close(outer, geometry::real(11));
+		bool apart = !inner.too_close(outer, geometry::real(9.9));
+		size_t inside = 0;
+		for (auto& p : queries)
+			inside += star.inside(p);
+
+		if (level == Simd::Level::scalar)
+		{
+			reference_parts = parts.size();
+			reference_area = parts_area;
+			reference_inside = inside;
+		}
+		bool same = parts.size() == reference_parts && equal(parts_area, reference_area) && inside == reference_inside && close && apart;
+		ok &= report(std::string("kernels ") + Simd::name(level), same && parts.size() > 1, std::to_string(parts.size()) + " parts, " + std::to_string(inside) + " points inside");
+	}
+	Simd::level(supported);
+
+	return ok;
+}
+
+static bool check_boolean()
+{
+	bool ok = true;
+
+	std::vector<Curve> overlapping{ square(0, 0, 10), square(5, 0, 10) };
+	auto united = CurveBoolean::unite(overlapping, false);
+	ok &= report("boolean overlapping", united.size() == 1 && equal(area(united), 150), std::to_string(united.size()) + " curves, area " + std::to_string(area(united)));
+
+	std::vector<Curve> disjoint{ square(0, 0, 10), square(20, 0, 10) };
+	united = CurveBoolean::unite(disjoint, false);
+	ok &= report("boolean disjoint", united.size() == 2 && equal(area(united), 200), std::to_string(united.size()) + " curves, area " + std::to_string(area(united)));
+
+	// the direction of a curve kept whole is reversed when the result needs it
+	std::vector<Curve> clockwise{ square(0, 0, 10, true) };
+	united = CurveBoolean::unite(clockwise, false);
+	ok &= report("boolean clockwise", united.size() == 1 && united[0].size() == 5 && equal(area(united), 100), std::to_string(united.size()) + " curves, area " + std::to_string(area(united)));
+
+	// an island drawn in the direction of its outer curve
+	CurveBoolean b;
+	Curve outer = square(0, 0, 10), island = square(3, 3, 4);
+	b.add(outer, CurveBoolean::Fill::add);
+	b.add(island, CurveBoolean::Fill::subtract);
+	auto holed = b.compute(false);
+	ok &= report("boolean island", holed.size() == 2 && equal(area(holed), 116), std::to_string(holed.size()) + " curves, area " + std::to_string(area(holed)));
+
+	// a chain of squares and discs, the n-ary union against pairwise merges
+	std::vector<Curve> chain;
+	for (int i = 0; i < 50; i++)
+		chain.push_back(i % 2 ? disc(i * geometry::real(7) + 5, geometry::real(5 + i % 3), 5) : square(i * geometry::real(7), geometry::real(i % 3), 10));
+	Curve merged = chain[0];
+	for (size_t i = 1; i < chain.size(); i++)
+	{
+		Curve c = chain[i];
+		auto pair = merged.boolean_union(c);
+		if (pair.size() == 0)
+			break;
+		merged = pair[0];
+		merged.close();
+	}
+	united = CurveBoolean::unite(chain, false);
+	double pairwise = glm::abs((double)merged.area());
+	ok &= report("boolean chain", united.size() == 1 && equal(area(united), pairwise), "n-ary area " + std::to_string(area(united)) + ", pairwise area " + std::to_string(pairwise));
+
+	return ok;
+}
+
+/// <summary>
+/// Return the curves of a pocket region as the cad module prepares them : levels, outer curves in their drawn direction
+/// and alternate directions inside
+/// </summary>
+static std::vector<Curve> region(std::vector<Curve> curves)
+{
+	for (int i = 0; i < curves.size(); i++)
+		curves[i].tag(i);
+	TreeCurve tree(curves);
+	tree.nest();
+	tree.cw_alter();
+	return tree.curves();
+}
+
+static bool check_ladder()
+{
+	bool ok = true;
+
+	// ring k of a square is a square eroded by k steps, the pocket keeps the drawn direction of the outer curve
+	std::vector<Curve> rings;
+	for (bool cw : { false, true })
+	{
+		auto block = region({ square(0, 0, 100, cw) });
+		rings = OffsetLadder(block).rings(5);
+		bool squares = rings.size() == 9;
+		for (size_t k = 0; squares && k < rings.size(); k++)
+			squares = equal(glm::abs((double)rings[k].area()), glm::pow(100.0 - 10 * (k + 1), 2));
+		ok &= report(std::string("ladder square ") + (cw ? "clockwise" : "counter clockwise"), squares, std::to_string(rings.size()) + " rings");
+	}
+
+	auto holed = region({ square(0, 0, 100, true), square(40, 40, 20) });
+	auto merged = OffsetLadder::merge(holed);
+	ok &= report("ladder merge clockwise", merged.size() == 2 && equal(area(merged), 10400), std::to_string(merged.size()) + " curves, area " + std::to_string(area(merged)));
+
+	// rings of a part with islands against the erosion of the region by k steps, islands touch the outer ring at some steps
+	auto part = region({ square(0, 0, 200), square(20, 20, 30), square(90, 35, 30), square(160, 30, 20) });
+	for (geometry::real step : { 5.0, 3.0, 2.0, 0.7 })
+	{
+		rings = OffsetLadder(part).rings(step);
+
+		std::vector<Curve> eroded;
+		for (int k = 1;; k++)
+		{
+			std::vector<Curve> ring;
+			for (Curve& c : part)
+			{
+				auto offsets = c.offset(c.level() == part.front().level() ? -k * step : k * step);
+				ring.insert(ring.end(), offsets.begin(), offsets.end());
+			}
+			ring = OffsetLadder::merge(ring);
+			if (ring.size() == 0)
+				break;
+			eroded.insert(eroded.end(), ring.begin(), ring.end());
+		}
+
+		ok &= report("ladder islands step " + stringex::to_string(step), rings.size() == eroded.size() && equal(area(rings), area(eroded)),
+			std::to_string(rings.size()) + " rings, " + std::to_string(eroded.size()) + " eroded");
+	}
+
+	return ok;
+}
+
+/// <summary>
+/// Return the bytes of a program without the line of the date comment
+/// </summary>
+static std::string program(std::string path)
+{
+	std::ifstream input(path, std::ios::binary);
+	std::string text((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+	auto date = text.find("Date : ");
+	if (date != std::string::npos)
+	{
+		auto start = text.rfind('\n', date);
+		start = start == std::string::npos ? 0 : start + 1;
+		auto end = text.find('\n', date);
+		text.erase(start, end == std::string::npos ? std::string::npos : end + 1 - start);
+	}
+	return text;
+}
+
+static bool check_formatter()
+{
+	std::string module = environment::combine_path(environment::combine_path(environment::application_path(), "postpro"), "generic_mill.py");
+	if (!std::filesystem::exists(module))
+		return report("formatter", false, module + " not found");
+
+	Script::initialize_python();
+	Script::add_module_path(environment::combine_path(environment::application_data_path(), "postpro"));
+	Script::add_module_path(environment::combine_path(environment::application_path(), "postpro"));
+	Script::add_module_path(environment::combine_path(environment::application_data_path(), "script"));
+
+	// a group of follows of lines and arcs
+	NullRenderer renderer;
+	Document* doc = new Document();
+	doc->render(&renderer);
+	doc->path(environment::combine_path(std::filesystem::temp_directory_path().string(), "check_formatter.opp"));
+	Group* g = doc->group("check");
+	for (int i = 0; i < 20; i++)
+	{
+		geometry::real x = geometry::real(i / 2) * geometry::real(30.123457);
+		Follow* f = new Follow(&renderer);
+		f->add(i % 2 ? disc(x + 10, 40, geometry::real(9.87654)) : square(x, 0, geometry::real(20.5)));
+		f->cw(i % 4 < 2);
+		f->compute();
+		g->add(f);
+	}
+
+	// the same program with the native formatter and formatted by postcore.py
+	std::string outputs[2];
+	bool ok = true;
+	for (int i = 0; i < 2 && ok; i++)
+	{
+		auto folder = environment::combine_path(std::filesystem::temp_directory_path().string(), i == 0 ? "check_native" : "check_python");
+		Postpro* p = new Postpro();
+		p->save(false);
+		p->native(i == 0);
+		ok = p->initialize(module, Lang::getName());
+		if (ok)
+		{
+			p->run(doc, folder, "check");
+			outputs[i] = environment::combine_path(folder, "check_formatter." + p->extention());
+		}
+		else
+			report("formatter", false, p->error());
+		delete p;
+	}
+	delete doc;
+
+	Script::finalize_python();
+
+	if (!ok)
+		return false;
+
+	// both arc directions are output, the moves are not left out
+	auto native = program(outputs[0]), python = program(outputs[1]);
+	bool moves = native.find("G2") != std::string::npos && native.find("G3") != std::string::npos;
+	return report("formatter", moves && native == python, std::to_string(native.size()) + " bytes native, " + std::to_string(python.size()) + " bytes python");
+}
+
+bool test_requested(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++)
+		if (std::string(argv[i]) == "--check" || std::string(argv[i]) == "--bench")
+			return true;
+	return false;
+}
+
+int run_tests(int argc, char* argv[])
+{
+	// the exe is linked for the windows subsystem
+	environment::attach_console();
+
+	bool ok = true;
+	ok &= check_kernels();
+	ok &= check_boolean();
+	ok &= check_ladder();
+	ok &= check_formatter();
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--bench")
+		{
+			std::cout << "benchmarks, results in " << Logger::path() << std::endl;
+			run_benches();
+		}
+	}
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file
@@ -1,4 +1,15 @@
 #pragma once
 #include <document.h>
 
-void run_test(Document* document);
\ No newline at end of file
+void run_test(Document* document);
+
+/// <summary>
+/// Return true if the command line asks for the checks, --check, or for the checks then the benchmarks, --bench
+/// </summary>
+bool test_requested(int argc, char* argv[]);
+
+/// <summary>
+/// Run the checks, printed to the console and to the log file, then the benchmarks with --bench.
+/// Return the exit code of the process, failure if a check fails
+/// </summary>
+int run_tests(int argc, char* argv[]);
\ No newline at end of file
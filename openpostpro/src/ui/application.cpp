@@ -18,6 +18,7 @@
 #include <strings.h>
 #include <history.h>
 #include <script.h>
+#include <offsetcache.h>
 
 
 #include "mod_log.h"
@@ -708,6 +709,10 @@ void Application::render_menu()
 						save_file(path);
 					}
 				}
+				// toolpaths of the shapes modified since the last frame are rebuilt first
+				((ModCad*)module("MOD_CAD"))->rebuild();
+				// a mapped output cannot be written again
+				((ModOutput*)module("MOD_OUTPUT"))->release();
 				_current_postpro->run(_document, config.output_path, std::to_string(_version));
 				auto m = module("MOD_OUTPUT");
 				m->show(true);
@@ -920,6 +925,10 @@ void Application::load_file(std::string path)
 
 				_document->path(path);
 
+				// offsets of the last session, before the toolpaths are computed
+				if (config.offset_cache_file && OffsetCache::load(path + ".offsets"))
+					Logger::log(OffsetCache::str());
+
 				// document affectation
 				for (Module* m : _modules)
 					m->document(_document);
@@ -961,6 +970,8 @@ void Application::save_file(std::string path)
 			_document->path(path);
 			auto data = _document->write(_version);
 			file::write_all_text(path, data);
+			if (config.offset_cache_file && OffsetCache::save(path + ".offsets"))
+				Logger::log(OffsetCache::str());
 
 			title(_application_title + " - " + _document->path());
 
@@ -12,8 +12,11 @@
 class Application :
 	public Window
 {
+public:
+	static constexpr float VERSION = 0.1f;
+
 private:
-	float _version = 0.1f;
+	float _version = VERSION;
 
 	int _xpos = 0;
 	int _ypos = 0;
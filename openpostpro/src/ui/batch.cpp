@@ -0,0 +1,391 @@
+#include "batch.h"
+#include "renderer_null.h"
+#include "config.h"
+#include <document.h>
+#include <../import/dxfloader.h>
+#include <postpro.h>
+#include <inifile.h>
+#include <environment.h>
+#include <file.h>
+#include <lang.h>
+#include <logger.h>
+#include <strings.h>
+#include <cad.h>
+#include <follow.h>
+#include <offset.h>
+#include <pocket.h>
+#include <offsetcache.h>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+#include <map>
+
+static double elapsed(std::chrono::high_resolution_clock::time_point t)
+{
+	return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(std::chrono::high_resolution_clock::now() - t).count();
+}
+
+static void usage()
+{
+	std::cout << "usage: openpostpro --batch [--template job.ini] [--post module] [--output dir] [--processes N] files..." << std::endl;
+}
+
+static void print(std::string line)
+{
+	std::cout << line << std::endl;
+	Logger::log(line);
+}
+
+static void print_error(std::string line)
+{
+	std::cerr << line << std::endl;
+	Logger::error(line);
+}
+
+bool Batch::requested(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++)
+		if (std::string(argv[i]) == "--batch")
+			return true;
+	return false;
+}
+
+bool Batch::parse(int argc, char* argv[], Options& options)
+{
+	options.exe = argv[0];
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool value = i + 1 < argc;
+
+		if (arg == "--batch")
+			continue;
+		else if (arg == "--template" && value)
+			options.job = argv[++i];
+		else if (arg == "--post" && value)
+			options.post = argv[++i];
+		else if (arg == "--output" && value)
+			options.output = argv[++i];
+		else if (arg == "--processes" && value)
+			options.processes = std::max(1, std::atoi(argv[++i]));
+		else if (stringex::start_with(arg, "--"))
+			return false;
+		else
+			options.files.push_back(arg);
+	}
+
+	return options.files.size() > 0;
+}
+
+bool Batch::check(Options& options)
+{
+	// outputs are named after the file stem in the output folder, case is ignored as on windows
+	std::map<std::string, std::string> stems;
+	for (auto& path : options.files)
+	{
+		auto stem = stringex::to_lower(std::filesystem::path(path).stem().string());
+		auto it = stems.find(stem);
+		if (it != stems.end())
+		{
+			print_error("Same output name for " + it->second + " and " + path);
+			return false;
+		}
+		stems[stem] = path;
+	}
+	return true;
+}
+
+Postpro* Batch::postpro(std::string module)
+{
+	// the data folder holds the modules copied and edited by the application, the exe folder the shipped ones
+	std::vector<std::string> folders = {
+		environment::combine_path(environment::application_data_path(), "postpro"),
+		environment::combine_path(environment::application_path(), "postpro")
+	};
+
+	for (auto& folder : folders)
+	{
+		auto path = environment::combine_path(folder, module + ".py");
+		if (std::filesystem::exists(path))
+		{
+			// the post stays loaded for the runs, its properties are not written back : processes would write the INI file at the same time
+			Postpro* p = new Postpro();
+			p->save(false);
+			if (p->initialize(path, Lang::getName()))
+				return p;
+			print_error("Loading post-processor " + path + " -> " + p->error());
+			delete p;
+			return nullptr;
+		}
+	}
+
+	print_error("Post-processor not found: " + module);
+	return nullptr;
+}
+
+bool Batch::apply(Document* doc, IniFile& job, std::string section, Renderer* r)
+{
+	std::string operation = job.get_string(section, "Operation");
+	if (operation.empty())
+		return false;
+
+	Group* g = doc->group(job.get_string(section, "Name", section));
+	g->tool_radius(job.get_float(section, "Radius", g->tool_radius()));
+	g->depth(job.get_float(section, "Depth", g->depth()));
+	g->pass(job.get_float(section, "Pass", g->pass()));
+	g->feed(job.get_float(section, "Feed", g->feed()));
+	g->plung_feed(job.get_float(section, "PlungFeed", g->plung_feed()));
+	g->safe(job.get_float(section, "Safe", g->safe()));
+	g->spindle_speed(job.get_float(section, "SpindleSpeed", g->spindle_speed()));
+	g->tool_number(job.get_int(section, "Tool", g->tool_number()));
+	g->cw(job.get_bool(section, "Cw", g->cw()));
+
+	// shapes of the layer, of every layer without filter
+	std::string filter = job.get_string(section, "Layer");
+	std::vector<Shape*> candidates;
+	for (Layer* l : doc->layers())
+		if (filter.empty() || l->name() == filter)
+			for (Shape* s : l->shapes())
+				candidates.push_back(s);
+
+	if (candidates.size() == 0)
+		return true;
+
+	std::vector<Graphic*> chained;
+	TreeCurve* tree = cad::tree(doc, candidates, chained);
+	if (tree->size() == 0)
+	{
+		delete tree;
+		return true;
+	}
+
+	// toolpaths are built as the CAD module does for the selection
+	std::vector<Toolpath*> toolpaths;
+	bool cw = g->cw();
+	if (operation == "pocket" || operation == "pocket_zigzag")
+	{
+		Pocket* p = new Pocket(r);
+		p->mode(operation == "pocket" ? PocketMode::Offset : PocketMode::Zigzag);
+		p->radius(g->tool_radius());
+		p->cw(cw);
+		p->tree(tree);
+		p->compute();
+		g->add(p);
+	}
+	else if (operation == "offset_outside" || operation == "offset_inside")
+	{
+		bool interior = operation == "offset_inside";
+		for (auto& c : tree->curves())
+		{
+			Offset* o = new Offset(r);
+			o->reference(c.reference());
+			o->interior(c.level() % 2 == 0 ? !interior : interior);
+			o->radius(g->tool_radius());
+			o->cw(c.level() % 2 == 0 ? !cw : cw);
+			o->add(c);
+			o->compute();
+			g->add(o);
+			toolpaths.push_back(o);
+		}
+		delete tree;
+	}
+	else if (operation == "follow")
+	{
+		for (auto& c : tree->curves())
+		{
+			Follow* f = new Follow(r);
+			f->add(c);
+			f->reference(c.reference());
+			f->cw(c.level() % 2 == 0 ? !cw : cw);
+			f->compute();
+			g->add(f);
+		}
+		delete tree;
+	}
+	else
+	{
+		print_error("Unknown operation [" + section + "] " + operation);
+		delete tree;
+	}
+
+	Toolpath::process(toolpaths);
+
+	return true;
+}
+
+bool Batch::run_file(Options& options, std::string path, Postpro* p, Renderer* r, std::string version)
+{
+	auto t = std::chrono::high_resolution_clock::now();
+
+	if (!std::filesystem::exists(path))
+	{
+		print_error(path + " : not found");
+		return false;
+	}
+
+	Document* doc = new Document();
+	doc->render(r);
+
+	try
+	{
+		// load
+		if (stringex::to_lower(std::filesystem::path(path).extension().string()) == ".dxf")
+		{
+			DxfLoader::read(path, doc);
+			doc->check();
+		}
+		else
+		{
+			if (config.offset_cache_file)
+				OffsetCache::load(path + ".offsets");
+			doc->read(file::read_all_text(path));
+		}
+		doc->path(path);
+		double load = elapsed(t);
+
+		// toolpaths of the template, GROUP1, GROUP2... until a section is missing
+		t = std::chrono::high_resolution_clock::now();
+		if (!options.job.empty())
+		{
+			IniFile job(options.job);
+			for (int i = 1; apply(doc, job, "GROUP" + std::to_string(i), r); i++);
+		}
+		size_t count = 0;
+		for (Group* g : doc->groups())
+		{
+			for (Toolpath* tp : g->toolpaths())
+			{
+				tp->wait();
+				count++;
+			}
+		}
+		double compute = elapsed(t);
+
+		// output
+		t = std::chrono::high_resolution_clock::now();
+		p->run(doc, options.output, version);
+		double post = elapsed(t);
+
+		std::ostringstream line;
+		line << std::fixed << std::setprecision(1) << path << " : load " << load << " ms, toolpaths (" << count << ") " << compute << " ms, post " << post << " ms -> " << doc->output();
+		print(line.str());
+	}
+	catch (const std::exception& e)
+	{
+		print_error(path + " : ERROR " + e.what());
+		delete doc;
+		return false;
+	}
+
+	delete doc;
+	return true;
+}
+
+int Batch::run_processes(Options& options)
+{
+	std::atomic<size_t> next = 0;
+	std::mutex mutex;
+	std::vector<int> status(options.files.size(), 0);
+	std::vector<double> times(options.files.size(), 0);
+
+	std::string common = " --batch --processes 1";
+	if (!options.job.empty())
+		common += " --template \"" + options.job + "\"";
+	if (!options.post.empty())
+		common += " --post \"" + options.post + "\"";
+	if (!options.output.empty())
+		common += " --output \"" + options.output + "\"";
+
+	// a child process per file, document ids are global to a process
+	auto worker = [&]()
+	{
+		for (size_t i = next++; i < options.files.size(); i = next++)
+		{
+			auto t = std::chrono::high_resolution_clock::now();
+			std::string command = "\"" + options.exe + "\"" + common + " \"" + options.files[i] + "\"";
+#ifdef _WIN32
+			// cmd.exe strips the outer quotes
+			command = "\"" + command + "\"";
+#endif
+			status[i] = std::system(command.c_str());
+			times[i] = elapsed(t);
+		}
+	};
+
+	auto t = std::chrono::high_resolution_clock::now();
+	std::vector<std::thread> threads;
+	for (int i = 0; i < std::min((int)options.files.size(), options.processes); i++)
+		threads.emplace_back(worker);
+	for (auto& thread : threads)
+		thread.join();
+
+	int failed = 0;
+	print("---");
+	for (size_t i = 0; i < options.files.size(); i++)
+	{
+		std::ostringstream line;
+		line << std::fixed << std::setprecision(1) << options.files[i] << " : " << (status[i] == 0 ? "ok" : "FAILED") << " " << times[i] << " ms";
+		print(line.str());
+		if (status[i] != 0)
+			failed++;
+	}
+	std::ostringstream summary;
+	summary << std::fixed << std::setprecision(1) << options.files.size() << " files, " << failed << " failed, " << elapsed(t) << " ms";
+	print(summary.str());
+
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int Batch::run(int argc, char* argv[], std::string version)
+{
+	// the exe is linked for the windows subsystem
+	environment::attach_console();
+
+	Options options;
+	if (!parse(argc, argv, options))
+	{
+		usage();
+		return EXIT_FAILURE;
+	}
+
+	if (!check(options))
+		return EXIT_FAILURE;
+
+	if (options.processes > 1 && options.files.size() > 1)
+		return run_processes(options);
+
+	config.read();
+	if (options.post.empty())
+		options.post = config.postpro;
+	if (options.output.empty())
+		options.output = config.output_path;
+
+	Script::initialize_python();
+	Script::add_module_path(environment::combine_path(environment::application_data_path(), "postpro"));
+	Script::add_module_path(environment::combine_path(environment::application_path(), "postpro"));
+	Script::add_module_path(environment::combine_path(environment::application_data_path(), "script"));
+
+	int failed = 0;
+	Postpro* p = postpro(options.post);
+	if (p == nullptr)
+		failed = (int)options.files.size();
+	else
+	{
+		NullRenderer renderer;
+		for (auto& path : options.files)
+			if (!run_file(options, path, p, &renderer, version))
+				failed++;
+		delete p;
+	}
+
+	Script::finalize_python();
+
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
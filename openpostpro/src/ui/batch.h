@@ -0,0 +1,80 @@
+#pragma once
+#ifndef _BATCH_H
+#define _BATCH_H
+
+#include <string>
+#include <vector>
+
+class Document;
+class Renderer;
+class IniFile;
+class Postpro;
+
+/************************************************************************
+* Headless batch mode
+* openpostpro --batch [--template job.ini] [--post module] [--output dir]
+*             [--processes N] files...
+* Each file, .opp or .dxf, is loaded without display, the groups of the
+* template are applied to its layers, the toolpaths are computed and the
+* post-processor writes the output. Document ids are global to a process,
+* so several files are run by child processes, N at a time, each one
+* printing the timings of its phases. Lines go to the console the batch
+* is started from and to the log file
+*************************************************************************/
+class Batch
+{
+private:
+	struct Options
+	{
+		std::string exe;
+		std::string job;		// template
+		std::string post;		// post-processor module, default is the one of the config
+		std::string output;		// output directory, default is the one of the config
+		int processes = 1;
+		std::vector<std::string> files;
+	};
+
+	/// <summary>
+	/// Read the command line, return false on unknown or incomplete options
+	/// </summary>
+	static bool parse(int argc, char* argv[], Options& options);
+
+	/// <summary>
+	/// Return false when two files would write the same output
+	/// </summary>
+	static bool check(Options& options);
+
+	/// <summary>
+	/// Find and load the post-processor module
+	/// </summary>
+	static Postpro* postpro(std::string module);
+
+	/// <summary>
+	/// Add the group of the template section to the document, with its toolpaths computed from the shapes of its layer.
+	/// Return false when the section does not exist
+	/// </summary>
+	static bool apply(Document* doc, IniFile& job, std::string section, Renderer* r);
+
+	/// <summary>
+	/// Load, compute and output one file in this process
+	/// </summary>
+	static bool run_file(Options& options, std::string path, Postpro* p, Renderer* r, std::string version);
+
+	/// <summary>
+	/// Run each file in a child process, options.processes at a time
+	/// </summary>
+	static int run_processes(Options& options);
+
+public:
+	/// <summary>
+	/// Return true if the command line asks for the batch mode
+	/// </summary>
+	static bool requested(int argc, char* argv[]);
+
+	/// <summary>
+	/// Run the batch, return the exit code of the process
+	/// </summary>
+	static int run(int argc, char* argv[], std::string version);
+};
+
+#endif
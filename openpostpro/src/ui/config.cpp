@@ -2,6 +2,7 @@
 #include <lang.h>
 #include <geometry.h>
 #include <environment.h>
+#include <offsetcache.h>
 
 Config config;
 
@@ -26,6 +27,13 @@ void Config::read()
 	display_output = _ini.get_bool(_section, "DisplayOutput", false);
 
 	python_path = _ini.get_string(_section, "PythonPath", "");
+	offset_cache_size = _ini.get_int(_section, "OffsetCacheSize", 64);
+	offset_cache_file = _ini.get_bool(_section, "OffsetCacheFile", false);
+	output_buffer_size = _ini.get_int(_section, "OutputBufferSize", 1024);
+	output_thread = _ini.get_bool(_section, "OutputThread", true);
+	output_editor_size = _ini.get_int(_section, "OutputEditorSize", 8);
+	output_parallel = _ini.get_bool(_section, "OutputParallel", true);
+	OffsetCache::capacity((size_t)std::max(0, offset_cache_size) * 1024 * 1024);
 
 	anchorFillColor = geometry::from_string(_ini.get_string("COLOR", "AnchorFill", "(1.0;1.0;1.0;0.5)"));
 	anchorLineColor = geometry::from_string(_ini.get_string("COLOR", "AnchorLine", "(0.0;1.0;0.0;0.5)"));			//glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
@@ -61,6 +69,12 @@ void Config::write()
 	_ini.set(_section, "DisplayLog", display_log);
 	_ini.set(_section, "DisplayOutput", display_output);
 	_ini.set(_section, "PythonPath", python_path);
+	_ini.set(_section, "OffsetCacheSize", offset_cache_size);
+	_ini.set(_section, "OffsetCacheFile", offset_cache_file);
+	_ini.set(_section, "OutputBufferSize", output_buffer_size);
+	_ini.set(_section, "OutputThread", output_thread);
+	_ini.set(_section, "OutputEditorSize", output_editor_size);
+	_ini.set(_section, "OutputParallel", output_parallel);
 
 	_ini.set("COLOR", "AnchorFill", geometry::to_string(anchorFillColor));
 	_ini.set("COLOR", "AnchorLine", geometry::to_string(anchorLineColor));
@@ -150,6 +164,36 @@ MessageBoxResult Config::drawUI()
 			{
 				_ini_temp.set("GENERAL", "PythonPath", std::string(input));
 			}
+			int i = _ini_temp.get_int("GENERAL", "OffsetCacheSize");
+			if (ImGui::InputInt(Lang::l("OFFSET_CACHE_SIZE"), &i))
+			{
+				_ini_temp.set("GENERAL", "OffsetCacheSize", std::max(0, i));
+			}
+			b = _ini_temp.get_bool("GENERAL", "OffsetCacheFile");
+			if (ImGui::Checkbox(Lang::l("OFFSET_CACHE_FILE"), &b))
+			{
+				_ini_temp.set("GENERAL", "OffsetCacheFile", b);
+			}
+			i = _ini_temp.get_int("GENERAL", "OutputBufferSize");
+			if (ImGui::InputInt(Lang::l("OUTPUT_BUFFER_SIZE"), &i))
+			{
+				_ini_temp.set("GENERAL", "OutputBufferSize", std::max(4, i));
+			}
+			b = _ini_temp.get_bool("GENERAL", "OutputThread");
+			if (ImGui::Checkbox(Lang::l("OUTPUT_THREAD"), &b))
+			{
+				_ini_temp.set("GENERAL", "OutputThread", b);
+			}
+			i = _ini_temp.get_int("GENERAL", "OutputEditorSize");
+			if (ImGui::InputInt(Lang::l("OUTPUT_EDITOR_SIZE"), &i))
+			{
+				_ini_temp.set("GENERAL", "OutputEditorSize", std::max(1, i));
+			}
+			b = _ini_temp.get_bool("GENERAL", "OutputParallel");
+			if (ImGui::Checkbox(Lang::l("OUTPUT_PARALLEL"), &b))
+			{
+				_ini_temp.set("GENERAL", "OutputParallel", b);
+			}
 			ImGui::EndTabItem();
 		}
 		ImGui::EndTabBar();
@@ -45,6 +45,13 @@ public:
 
 	std::string python_path = "";
 
+	int offset_cache_size = 64;			// MB, 0 disables the offset cache
+	bool offset_cache_file = false;		// save the offset cache next to the project file
+	int output_buffer_size = 1024;		// KB, the post-processor output is written by chunks of this size
+	bool output_thread = true;			// write the chunks on a background thread
+	int output_editor_size = 8;			// MB, larger outputs are mapped and shown read only
+	bool output_parallel = true;		// format the passes on the worker pool when the post has a native formatter
+
 	Config();
 
 
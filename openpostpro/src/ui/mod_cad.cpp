@@ -23,6 +23,7 @@
 #include <offset.h>
 #include <drill.h>
 #include <pocket.h>
+#include <dependencies.h>
 #include<chrono>
 
 ModCad::ModCad(Window* window) : Module(window)
@@ -273,6 +274,7 @@ void ModCad::document_loaded()
 				TreeCurve* tree = cad_tree();
 				t->tree(cad_tree());
 				t->compute();
+				Dependencies::depend(t, dependencies());
 				delete tree;
 			}
 		}
@@ -855,6 +857,7 @@ void ModCad::render_frame()
 	// draw document
 	if (_document) 
 	{
+		rebuild();
 		_document->draw();
 		_document->anchors();
 
@@ -1712,6 +1715,7 @@ void ModCad::render_menu()
 					Toolpath* t = (Toolpath*)(Shape*)_document->selected()[0];
 					std::vector<Shape*> splines;
 					History::begin_undo_record();
+					t->wait();
 					for (Curve& c : t->coordinates())
 					{
 						Spline* s = new Spline(_render);
@@ -2116,8 +2120,8 @@ void ModCad::paste()
 				g->id(id);
 				if (g->shape())
 				{
-					x = glm::min(x, ((Shape*)g)->topLeft().x);
-					y = glm::max(y, ((Shape*)g)->topLeft().y);
+					x = glm::min(x, (float)((Shape*)g)->topLeft().x);
+					y = glm::max(y, (float)((Shape*)g)->topLeft().y);
 				}
 
 				graphics.push_back(g);
@@ -2579,7 +2583,7 @@ void ModCad::cut_at_intersections()
 				{
 					if (b->type() == GraphicType::Line)
 					{
-						glm::vec2 p = glm::vec2();
+						geometry::rvec2 p = geometry::rvec2();
 						if (geometry::segment_segment_intersect(((Line*)a)->p1(), ((Line*)a)->p2(), ((Line*)b)->p1(), ((Line*)b)->p2(), p))
 						{
 							list_points[i].push_back(p);
@@ -2588,7 +2592,7 @@ void ModCad::cut_at_intersections()
 					}
 					else if (b->type() == GraphicType::Circle)
 					{
-						glm::vec2 p[2] = { glm::vec2(),glm::vec2() };
+						geometry::rvec2 p[2] = { geometry::rvec2(), geometry::rvec2() };
 						int count = geometry::segment_circle_intersect(((Line*)a)->p1(), ((Line*)a)->p2(), ((Circle*)b)->center(), ((Circle*)b)->radius(), p);
 						if (count > 0)
 						{
@@ -2602,7 +2606,7 @@ void ModCad::cut_at_intersections()
 					else if (b->type() == GraphicType::Arc)
 					{
 						Arc* s = (Arc*)b;
-						glm::vec2 p[2] = { glm::vec2(),glm::vec2() };
+						geometry::rvec2 p[2] = { geometry::rvec2(), geometry::rvec2() };
 						bool reversed = false;
 						if (reversed = s->cw())
 							s->reverse();
@@ -2638,7 +2642,7 @@ void ModCad::cut_at_intersections()
 					{
 						Circle* c1 = (Circle*)a;
 						Circle* c2 = (Circle*)b;
-						glm::vec2 p[2] = { glm::vec2(),glm::vec2() };
+						geometry::rvec2 p[2] = { geometry::rvec2(), geometry::rvec2() };
 						int count = geometry::circle_circle_intersect(c1->center(), c1->radius(), c2->center(), c2->radius(), p);
 						if (count > 0)
 						{
@@ -2656,7 +2660,7 @@ void ModCad::cut_at_intersections()
 						bool reversed = false;
 						if (reversed = s->cw())
 							s->reverse();
-						glm::vec2 p[2] = { glm::vec2(),glm::vec2() };
+						geometry::rvec2 p[2] = { geometry::rvec2(), geometry::rvec2() };
 						int count = geometry::arc_circle_intersect(s->start_angle(), s->center(), s->stop_angle(), s->radius(), s->cw(), c->center(), c->radius(), p);
 						if (count > 0)
 						{
@@ -2695,7 +2699,7 @@ void ModCad::cut_at_intersections()
 						bool reversed2 = false;
 						if (reversed2 = c2->cw())
 							c2->reverse();
-						glm::vec2 p[2] = { glm::vec2(),glm::vec2() };
+						geometry::rvec2 p[2] = { geometry::rvec2(), geometry::rvec2() };
 						int count = geometry::arc_arc_intersect(c1->start_angle(),c1->center(),  c1->stop_angle(), c1->radius(), c1->cw(), c2->start_angle(), c2->center(), c2->stop_angle(), c2->radius(), c2->cw(), p);
 						if (count > 0)
 						{
@@ -2836,68 +2840,7 @@ void ModCad::set_reference_to_text()
 
 std::vector<Shape*> ModCad::look_for_siblings(Shape* s)
 {
-	std::vector<Shape*> result;
-	result.push_back(s);
-
-	if (s->type() == GraphicType::Line || s->type() == GraphicType::Arc || s->type() == GraphicType::Polyline)
-	{
-		std::vector<Shape*> shapes;
-		for (Shape* shape : _document->layer(s->parent())->shapes())
-			if (shape != s && (shape->type() == GraphicType::Line || shape->type() == GraphicType::Arc || shape->type() == GraphicType::Polyline))
-				shapes.push_back(shape);
-
-		if (shapes.size() > 0)
-		{
-			glm::vec2 left = s->first(), right = s->last();
-
-			std::vector<Shape*>::iterator it = shapes.begin();
-			while(it != shapes.end())
-			{
-				if ((*it)->last() == right)
-					(*it)->reverse();
-				else if (geometry::distance((*it)->last(), right) < geometry::ERR_FLOAT6)
-				{
-					if ((*it)->type() == GraphicType::Line)
-						((Line*)(*it))->p2(right);
-					(*it)->reverse();
-				}
-
-				if ((*it)->first() == left)
-					(*it)->reverse();
-				else if (geometry::distance((*it)->first(), left) < geometry::ERR_FLOAT6)
-				{
-					if ((*it)->type() == GraphicType::Line)
-						((Line*)(*it))->p1(left);
-					(*it)->reverse();
-				}
-
-				if ((*it)->first() == right)
-				{
-					right = (*it)->last();
-					result.push_back((*it));
-					shapes.erase(it);
-					it = shapes.begin();
-				}
-				else if ((*it)->last() == left)
-				{
-					left = (*it)->first();
-					result.insert(result.begin(), (*it));
-					shapes.erase(it);
-					it = shapes.begin();
-				}
-				else if (geometry::distance((*it)->first(), left) < geometry::ERR_FLOAT6)
-				{
-					if ((*it)->type() == GraphicType::Line)
-						((Line*)(*it))->p1(left);
-					(*it)->reverse();
-				}
-				else
-					it++;
-			}
-		}
-	}
-
-	return result;
+	return cad::siblings(_document, s);
 }
 
 void ModCad::connect_shapes()
@@ -3036,8 +2979,6 @@ void ModCad::info(std::vector<Shape*> shapes)
 TreeCurve* ModCad::cad_tree()
 {
 	std::vector<Shape*> candidates;
-	std::vector<Shape*> splines;
-	std::vector<Curve> curves;
 	std::vector<Graphic*> selection;
 
 	for (Graphic* g : _document->selected())
@@ -3046,64 +2987,68 @@ TreeCurve* ModCad::cad_tree()
 			candidates.push_back((Shape*)g);
 	}
 
-	int tag = 0;
+	TreeCurve* tree = cad::tree(_document, candidates, selection);
 
-	while (candidates.size() > 0)
-	{
-		auto shapes = look_for_siblings(candidates[0]);
+	_document->unselect_all();
+	_document->select(selection);
 
-		// stores shapes which are part of tree
-		for (Shape* s : shapes)
-			if (std::find(selection.begin(), selection.end(), s) == selection.end())
-				selection.push_back(s);
+	return tree;
+}
+
+std::vector<unsigned int> ModCad::dependencies(int tag)
+{
+	std::vector<unsigned int> result;
+	for (Graphic* g : _document->selected())
+		if (g->shape() && (tag == -1 || ((Shape*)g)->tag() == tag))
+			result.push_back(g->id());
+	return result;
+}
 
-		if (shapes[0]->type() == GraphicType::Text)
+void ModCad::rebuild()
+{
+	if (!Dependencies::dirty())
+		return;
+
+	// cad_tree works on the selection, the selection of the user is restored at the end
+	std::vector<Graphic*> selection(_document->selected());
+	size_t count = 0, skipped = 0;
+
+	for (Group* g : _document->groups())
+	{
+		for (Toolpath* t : g->toolpaths())
 		{
-			shapes[0]->tag(tag);
-			auto coordinates = ((Text*)shapes[0])->coordinates();
-			if (coordinates.size() > 2)
+			if (!Dependencies::dirty(t))
 			{
-				for (std::vector<glm::vec2> points : coordinates)
-				{
-					Curve c = cad::to_curve(points);
-					c.close();
-					c.tag(tag);
-					c.reference(shapes.front()->id());
-					if (c.size() > 1)
-						curves.push_back(c);
-				}
+				skipped++;
+				continue;
 			}
-		}
-		else
-		{
-			Curve c = cad::to_curve(shapes);
-			c.tag(tag);
-			c.reference(shapes.front()->id());
-			if (c.size() >= 2)
+			count++;
+
+			// only chain based toolpaths are built from their shapes, the others are computed again
+			if (t->type() == GraphicType::CamPocket || t->type() == GraphicType::CamOffset || t->type() == GraphicType::CamFollow)
 			{
-				curves.push_back(c);
+				auto ids = Dependencies::shapes(t);
+				select(std::vector<int>(ids.begin(), ids.end()));
+
+				TreeCurve* tree = cad_tree();
+				if (t->type() == GraphicType::CamPocket)
+					t->tree(tree);
+				else
+				{
+					t->original(tree->curves());
+					delete tree;
+				}
 			}
-		}
 
-		for (Shape* s : shapes)
-		{
-			s->tag(tag);
-			auto it = std::find(candidates.begin(), candidates.end(), s);
-			if (it != candidates.end())
-				candidates.erase(it);
+			t->compute();
+			Dependencies::depend(t, dependencies());
 		}
-
-		tag++;
 	}
 
-	TreeCurve* tree = new TreeCurve(curves);
-	tree->sort();
-	tree->cw_alter();
-
 	_document->unselect_all();
 	_document->select(selection);
 
-	return tree;
+	Dependencies::rebuilt(count, skipped);
 }
 
 void ModCad::store_operation()
@@ -3572,6 +3517,7 @@ void ModCad::cam_follow()
 					bool cw = _document->current_group()->cw();
 					f->cw(c.level() % 2 == 0 ? !cw : cw);
 					f->compute();
+					Dependencies::depend(f, dependencies(c.tag()));
 					_document->current_group()->add(f);
 					_document->unselect_all();
 					_document->select(f);
@@ -3612,6 +3558,7 @@ void ModCad::cam_offset(bool interior)
 				//_tab_flags = ImGuiTabItemFlags_SetSelected;
 	
 				auto curves = tree->curves();
+				std::vector<Toolpath*> toolpaths;
 				for (auto& c : curves)
 				{
 					Offset* o = new Offset(_render);
@@ -3624,11 +3571,16 @@ void ModCad::cam_offset(bool interior)
 					o->cw(c.level() % 2 == 0 ? !cw : cw);
 					o->add(c);
 					o->compute();
+					Dependencies::depend(o, dependencies(c.tag()));
 					_document->current_group()->add(o);
 					_document->unselect_all();
 					_document->select(o);
 					_tab_flags = ImGuiTabItemFlags_SetSelected;
+					toolpaths.push_back(o);
 				}
+
+				// offsets of all the parts are computed together on the worker pool
+				Toolpath::process(toolpaths);
 			}
 		}
 		Logger::log("cad_offset process time (ms): " + std::to_string(std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(std::chrono::high_resolution_clock::now() - t).count()));
@@ -3659,6 +3611,7 @@ void ModCad::cam_pocket(PocketMode mode)
 				o->cw(_document->current_group()->cw());
 				o->tree(tree);
 				o->compute();
+				Dependencies::depend(o, dependencies());
 				_document->current_group()->add(o);
 				_document->unselect_all();
 				_document->select(o);
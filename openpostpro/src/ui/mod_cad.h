@@ -95,6 +95,11 @@ private:
 
 	TreeCurve* cad_tree();
 
+	/// <summary>
+	/// Ids of the selected shapes of chain tag, or of all the selected shapes if tag is -1. After cad_tree, the shapes a toolpath depends on
+	/// </summary>
+	std::vector<unsigned int> dependencies(int tag = -1);
+
 	void store_operation();
 
 public:
@@ -192,6 +197,11 @@ public:
 	// CAM processing
 	std::vector<Shape*> get_selection();
 	std::vector<int> get_references(std::vector<Graphic*> shapes);
+
+	/// <summary>
+	/// Rebuild the toolpaths whose shapes changed from their shapes, in document order. Other toolpaths are left as they are
+	/// </summary>
+	void rebuild();
 	bool set_shortcut(std::string code, ImVec2 size);
 	void cam_moveto();
 	void cam_drill();
@@ -5,6 +5,8 @@
 #include "lang.h"
 #include <imgui.h>
 #include <config.h>
+#include <cstring>
+#include <algorithm>
 
 ModOutput::ModOutput(Window* window) : Module(window)
 {
@@ -48,6 +50,59 @@ void ModOutput::document_loaded()
 	_last_modify = 0;
 }
 
+void ModOutput::release()
+{
+	_mapping.close();
+	_lines.clear();
+	_line_count = 0;
+	_output_file_time = std::filesystem::file_time_type();
+}
+
+void ModOutput::index()
+{
+	_lines.clear();
+	_line_count = 0;
+
+	const char* data = _mapping.data();
+	const char* end = data + _mapping.size();
+	const char* p = data;
+	while (p < end)
+	{
+		if (_line_count % STRIDE == 0)
+			_lines.push_back(p - data);
+		_line_count++;
+
+		p = (const char*)std::memchr(p, '\n', end - p);
+		if (p == nullptr)
+			break;
+		p++;
+	}
+}
+
+void ModOutput::render_mapping()
+{
+	const char* data = _mapping.data();
+	const char* end = data + _mapping.size();
+
+	ImGuiListClipper clipper;
+	clipper.Begin((int)_line_count);
+	while (clipper.Step())
+	{
+		// from the indexed line before the first visible one
+		size_t n = (size_t)clipper.DisplayStart / STRIDE * STRIDE;
+		const char* p = data + _lines[n / STRIDE];
+		for (; n < (size_t)clipper.DisplayEnd && p < end; n++)
+		{
+			const char* next = (const char*)std::memchr(p, '\n', end - p);
+			const char* stop = next != nullptr ? next : end;
+			if (n >= (size_t)clipper.DisplayStart)
+				ImGui::TextUnformatted(p, stop > p && stop[-1] == '\r' ? stop - 1 : stop);
+			p = next != nullptr ? next + 1 : end;
+		}
+	}
+	clipper.End();
+}
+
 void ModOutput::undo()
 {
 	editor.Undo();
@@ -118,9 +173,21 @@ void ModOutput::render_GUI()
 			if (time > _output_file_time)
 			{
 				_output_file_time = time;
-				auto text = file::read_all_text(_document->output());
 
-				editor.SetText(text);
+				// large outputs are not loaded into the editor
+				if (std::filesystem::file_size(_document->output()) > (uintmax_t)std::max(1, config.output_editor_size) * 1024 * 1024 && _mapping.open(_document->output()))
+				{
+					index();
+					editor.SetText("");
+				}
+				else
+				{
+					release();
+					_output_file_time = time;
+
+					auto text = file::read_all_text(_document->output());
+					editor.SetText(text);
+				}
 				editor.SetPalette(config.display_style == 2 ? TextEditor::GetLightPalette() : TextEditor::GetDarkPalette());
 
 				_title = std::filesystem::path(_document->output()).filename().string();
@@ -137,7 +204,10 @@ void ModOutput::render_GUI()
 		ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 1));
 		_window->push_default_font();
 
-		editor.Render("MOD_OUTPUT_EDITOR");
+		if (_mapping.data() != nullptr)
+			render_mapping();
+		else
+			editor.Render("MOD_OUTPUT_EDITOR");
 
 		_window->pop_font();
 		ImGui::PopStyleVar();
@@ -6,6 +6,7 @@
 #include <filesystem>
 
 #include "window.h"
+#include <file.h>
 #include <IMGUI_third/ImGuiColorTextEdit/TextEditor.h>
 
 class ModOutput : public Module
@@ -15,9 +16,31 @@ private:
 	TextEditor editor;
 
 	double _last_modify;
+
+	// outputs larger than the editor size are mapped and shown read only, the lines drawn only
+	file::Mapping _mapping;
+	std::vector<size_t> _lines;		// offset of every STRIDE line
+	size_t _line_count = 0;
+	static constexpr size_t STRIDE = 64;
+
+	/// <summary>
+	/// Index the lines of the mapped output
+	/// </summary>
+	void index();
+
+	/// <summary>
+	/// Draw the visible lines of the mapped output
+	/// </summary>
+	void render_mapping();
+
 public:
 	ModOutput(Window* window);
 
+	/// <summary>
+	/// Unmap the output before it is written again
+	/// </summary>
+	void release();
+
 	void show(bool value) override;
 
 	void document_loaded() override;
@@ -96,6 +96,7 @@ public:
 	virtual void draw(int primitive) {}
 	virtual void draw(int primitive, int first, int count) {}
 	virtual void draw(int primitive, int count, int* indice) {}
+	virtual void draw(int primitive, int first, int count, int instances) {}
 };
 
 
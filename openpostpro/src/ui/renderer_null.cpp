@@ -0,0 +1,129 @@
+#include "renderer_null.h"
+
+NullBuffer::~NullBuffer()
+{
+	// some owners delete their buffers without the renderer
+	_renderer->_deleted++;
+}
+
+void NullBuffer::upload(size_t vertices, size_t bytes)
+{
+	_vertices = vertices;
+	_bytes = bytes;
+
+	_renderer->_uploads++;
+	_renderer->_vertices += vertices;
+	_renderer->_bytes += bytes;
+}
+
+void NullBuffer::update(std::vector<glm::vec3> vertices, std::vector<glm::vec3> normales, int usage)
+{
+	upload(vertices.size(), (vertices.size() + normales.size()) * sizeof(glm::vec3));
+}
+
+void NullBuffer::update(std::vector<glm::vec3> vertices, std::vector<glm::vec4> colors, std::vector<glm::vec3> normales, int usage)
+{
+	upload(vertices.size(), (vertices.size() + normales.size()) * sizeof(glm::vec3) + colors.size() * sizeof(glm::vec4));
+}
+
+void NullBuffer::update(std::vector<glm::vec3> vertices, std::vector<glm::vec2> textures, std::vector<glm::vec3> normales, int usage)
+{
+	upload(vertices.size(), (vertices.size() + normales.size()) * sizeof(glm::vec3) + textures.size() * sizeof(glm::vec2));
+}
+
+void NullBuffer::flush(std::vector<glm::vec3> vertices, std::vector<glm::vec3> normales, int usage)
+{
+	update(vertices, normales, usage);
+}
+
+void NullBuffer::flush(std::vector<glm::vec3> vertices, std::vector<glm::vec4> colors, std::vector<glm::vec3> normales, int usage)
+{
+	update(vertices, colors, normales, usage);
+}
+
+void NullBuffer::flush(std::vector<glm::vec3> vertices, std::vector<glm::vec2> textures, std::vector<glm::vec3> normales, int usage)
+{
+	update(vertices, textures, normales, usage);
+}
+
+void NullBuffer::draw(int primitive)
+{
+	draw(primitive, 0, (int)_vertices, 1);
+}
+
+void NullBuffer::draw(int primitive, int first, int count)
+{
+	draw(primitive, first, count, 1);
+}
+
+void NullBuffer::draw(int primitive, int count, int* indice)
+{
+	draw(primitive, 0, count, 1);
+}
+
+void NullBuffer::draw(int primitive, int first, int count, int instances)
+{
+	_renderer->_draws++;
+	_renderer->_drawn += (unsigned long long)count * instances;
+}
+
+NullRenderer::NullRenderer(float scale)
+{
+	_null_camera.scale(scale);
+	camera(&_null_camera);
+}
+
+NullRenderer::Counters NullRenderer::counters()
+{
+	Counters result;
+	result.buffers = _buffers;
+	result.alive = _buffers - _deleted;
+	result.uploads = _uploads;
+	result.vertices = _vertices;
+	result.bytes = _bytes;
+	result.draws = _draws;
+	result.drawn = _drawn;
+	return result;
+}
+
+void NullRenderer::reset_counters()
+{
+	// buffers alive are kept, they are deleted later
+	_buffers -= _deleted.exchange(0);
+	_uploads = 0;
+	_vertices = 0;
+	_bytes = 0;
+	_draws = 0;
+	_drawn = 0;
+}
+
+std::string NullRenderer::str()
+{
+	auto c = counters();
+	return "buffers: " + std::to_string(c.buffers) +
+		" alive: " + std::to_string(c.alive) +
+		" uploads: " + std::to_string(c.uploads) +
+		" vertices: " + std::to_string(c.vertices) +
+		" size (KB): " + std::to_string(c.bytes / 1024) +
+		" draws: " + std::to_string(c.draws) +
+		" drawn: " + std::to_string(c.drawn);
+}
+
+void NullRenderer::set_size(float width, float height)
+{
+	Renderer::set_size(width, height);
+	_null_camera.set_size(width, height);
+}
+
+Buffer* NullRenderer::create_buffer(std::vector<glm::vec3> vertices, std::vector<glm::vec3> normales, int usage)
+{
+	_buffers++;
+	NullBuffer* result = new NullBuffer(this);
+	result->update(vertices, normales, usage);
+	return result;
+}
+
+void NullRenderer::delete_buffer(Buffer* buffer)
+{
+	delete buffer;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#ifndef ENGINE_RENDERER_NULL
+#define ENGINE_RENDERER_NULL
+
+#include "renderer.h"
+#include <atomic>
+#include <string>
+
+class NullRenderer;
+
+/************************************************************************
+* Buffer without graphic device
+* Keeps the vertex count and the size of its last upload and adds each
+* upload, draw and its deletion to the counters of its renderer
+*************************************************************************/
+class NullBuffer : public Buffer
+{
+private:
+	NullRenderer* _renderer = nullptr;
+	size_t _vertices = 0;
+	size_t _bytes = 0;
+
+	void upload(size_t vertices, size_t bytes);
+
+public:
+	NullBuffer(NullRenderer* r) { _renderer = r; }
+	~NullBuffer() override;
+
+	size_t size() override { return _vertices; }
+	size_t bytes() { return _bytes; }
+
+	void update(std::vector<glm::vec3> vertices, std::vector<glm::vec3> normales = std::vector<glm::vec3>(), int usage = NULL) override;
+	void update(std::vector<glm::vec3> vertices, std::vector<glm::vec4> colors, std::vector<glm::vec3> normales = std::vector<glm::vec3>(), int usage = NULL) override;
+	void update(std::vector<glm::vec3> vertices, std::vector<glm::vec2> textures, std::vector<glm::vec3> normales = std::vector<glm::vec3>(), int usage = NULL) override;
+
+	void flush(std::vector<glm::vec3> vertices, std::vector<glm::vec3> normales = std::vector<glm::vec3>(), int usage = NULL) override;
+	void flush(std::vector<glm::vec3> vertices, std::vector<glm::vec4> colors, std::vector<glm::vec3> normales = std::vector<glm::vec3>(), int usage = NULL) override;
+	void flush(std::vector<glm::vec3> vertices, std::vector<glm::vec2> textures, std::vector<glm::vec3> normales = std::vector<glm::vec3>(), int usage = NULL) override;
+
+	void draw(int primitive) override;
+	void draw(int primitive, int first, int count) override;
+	void draw(int primitive, int count, int* indice) override;
+	void draw(int primitive, int first, int count, int instances) override;
+};
+
+/************************************************************************
+* Renderer without graphic device, for the batch mode, tests and benchmarks
+* Shapes and toolpaths are computed the same way as in the application,
+* their buffers only count what would be sent to the GPU. The scale of the
+* virtual camera sets the tessellation of arcs and the size of decorations
+* as a zoom would. Counters can be read from any thread
+*************************************************************************/
+class NullRenderer : public Renderer
+{
+public:
+	struct Counters
+	{
+		unsigned long long buffers = 0;		// created
+		unsigned long long alive = 0;		// created and not deleted
+		unsigned long long uploads = 0;		// update and flush calls
+		unsigned long long vertices = 0;	// uploaded
+		unsigned long long bytes = 0;		// uploaded
+		unsigned long long draws = 0;
+		unsigned long long drawn = 0;		// vertices drawn, instances included
+	};
+
+private:
+	Camera _null_camera;
+
+	std::atomic<unsigned long long> _buffers = 0;
+	std::atomic<unsigned long long> _deleted = 0;
+	std::atomic<unsigned long long> _uploads = 0;
+	std::atomic<unsigned long long> _vertices = 0;
+	std::atomic<unsigned long long> _bytes = 0;
+	std::atomic<unsigned long long> _draws = 0;
+	std::atomic<unsigned long long> _drawn = 0;
+
+	friend class NullBuffer;
+
+public:
+	NullRenderer(float scale = 1);
+
+	/// <summary>
+	/// Scale of the virtual camera, pixels per unit
+	/// </summary>
+	float scale() { return camera()->scale(); }
+	void scale(float value) { camera()->scale(value); }
+
+	Counters counters();
+	void reset_counters();
+
+	/// <summary>
+	/// Counters, for the log
+	/// </summary>
+	std::string str();
+
+	void set_size(float width, float height) override;
+
+	Buffer* create_buffer(std::vector<glm::vec3> vertices, std::vector<glm::vec3> normales = std::vector<glm::vec3>(), int usage = NULL) override;
+	void delete_buffer(Buffer* buffer) override;
+};
+
+#endif // !ENGINE_RENDERER_NULL
@@ -694,6 +694,13 @@ void GlBuffer::draw(int primitive, int count, int* indice)
 	glBindVertexArray(0);
 }
 
+void GlBuffer::draw(int primitive, int first, int count, int instances)
+{
+	glBindVertexArray(_vao_id);
+	glDrawArraysInstanced(primitive, first, count, instances);
+	glBindVertexArray(0);
+}
+
 
 GlTexture::~GlTexture()
 {
@@ -116,6 +116,11 @@ public:
 	void draw(int primitive) override;
 	void draw(int primitive, int first, int count) override;
 	void draw(int primitive, int count, int* indice) override;
+
+	/// <summary>
+	/// Draw the vertices from first to first + count, instances times in one call. The vertex shader places each instance from gl_InstanceID
+	/// </summary>
+	void draw(int primitive, int first, int count, int instances) override;
 };
 
 class GlTexture : public Texture